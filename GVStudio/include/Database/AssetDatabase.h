@@ -23,8 +23,15 @@ public:
 
     void Clear();
 
+    // Asset params are relative to the project's resource folder; set this
+    // so dependency scanning (OBJ -> MTL -> textures) can open the files.
+    void SetResourceRoot(const std::string& resourceRoot);
+
     void ProcessLogicUnitInstance(const GV_Logic_Unit_Instance& instance);
 
+    // Asset paths referenced by one instance, in param order.
+    std::vector<std::string> ExtractPaths(const GV_Logic_Unit_Instance& instance) const;
+
     const AssetEntry* GetAsset(const std::string& path) const;
 
     std::vector<const AssetEntry*> GetAssetsByChunk(GV_ChunkType type) const;
@@ -44,4 +51,5 @@ private:
 private:
     std::unordered_map<std::string, AssetEntry> m_assets;
     std::unordered_map<GV_ChunkType, ExtractorFn> m_extractors;
+    std::string m_resourceRoot;
 };
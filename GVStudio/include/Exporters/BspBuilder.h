@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Exporters/WorldSectors.h"
+#include "MiniMath/MiniMath.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct BspSettings
+{
+    uint32_t vertexBudget = 1024; // per atomic sector
+    uint32_t maxDepth = 24;
+    float splitCost = 4.0f;       // one split weighs as much as this many triangles of imbalance
+    uint32_t candidatesPerAxis = 16;
+};
+
+struct BspVertex
+{
+    Vec3 position;
+    Vec3 normal;
+    float u = 0.0f;
+    float v = 0.0f;
+};
+
+struct BspTriangle
+{
+    BspVertex v[3];
+    uint32_t materialId = 0;
+};
+
+// Axis-aligned BSP over static world geometry. Interior nodes become
+// GV_CHUNK_PLANE_SECT, leaves GV_CHUNK_ATOMIC_SECT, nested the way the
+// runtime walks them: a plane sector holds its back then front child.
+// Triangles crossing a plane are clipped; where clipping cannot shrink a
+// node the children overlap instead, and the plane sector stores how far
+// each side reaches past the plane.
+class BspBuilder
+{
+public:
+    void Build(const std::vector<WorldTriangle>& triangles, const BspSettings& settings);
+
+    // GV_CHUNK_WORLD payload.
+    std::vector<char> BuildChunk() const;
+
+    // Leaf bounds in chunk order, for per-leaf PVS.
+    std::vector<WorldSector> GetLeafSectors() const;
+
+    void Report(const std::string& sceneName) const;
+
+private:
+    struct Node
+    {
+        int32_t axis = -1;  // -1 for a leaf
+        float position = 0.0f;
+        uint32_t back = 0;  // child node indices
+        uint32_t front = 0;
+        Vec3 boundsMin;
+        Vec3 boundsMax;
+        std::vector<BspTriangle> triangles; // leaves only, sorted by material
+    };
+
+    uint32_t BuildNode(std::vector<BspTriangle> triangles, uint32_t depth);
+
+    bool ChooseSplit(const std::vector<BspTriangle>& triangles, int& outAxis, float& outPosition) const;
+
+    void AppendNode(std::vector<char>& out, uint32_t node) const;
+    std::vector<char> BuildAtomicSector(const Node& node) const;
+
+private:
+    BspSettings m_settings;
+    std::vector<Node> m_nodes;
+
+    uint32_t m_leafCount = 0;
+    uint32_t m_maxDepth = 0;
+    uint32_t m_inputTriangles = 0;
+    uint32_t m_outputTriangles = 0;
+    uint32_t m_overBudget = 0;
+    uint32_t m_looseSplits = 0;
+    double m_buildMs = 0.0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Exporters/ProjectExporter.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+struct GV_Project_Info;
+class LogicUnitRegistry;
+
+// Content hash of a source file, reused while its size and write time
+// stay the same.
+struct BuildStamp
+{
+    uint64_t size = 0;
+    int64_t time = 0;
+    uint64_t hash = 0;
+};
+
+struct BuildNode
+{
+    uint64_t signature = 0;          // versions, settings and every input's hash
+    uint64_t output = 0;             // hash of the file the node wrote
+    std::vector<std::string> inputs; // absolute source paths, recorded at build
+};
+
+// Incremental project builds. The graph has three layers:
+//  - sources: scene XML, logic unit headers, the project file and every
+//    resource a scene pulls in, keyed by content hash;
+//  - cooked assets: one node per mesh over its OBJ, MTL and textures,
+//    keyed by those hashes and MeshCooker::VERSION;
+//  - scene exports over their sources, cooked meshes, the exporter
+//    settings and the project-wide ID tables, plus the packs over all scenes.
+// The graph is saved as <Project>.gvbuild in the data folder. A build
+// re-hashes only files whose stamp moved, in parallel, and exports only
+// stale scenes; with nothing stale it never loads a scene.
+class BuildGraph
+{
+public:
+    static constexpr uint32_t kExportVersion = 1; // bump when .gvs output changes
+
+    BuildGraph(LogicUnitRegistry& registry, const ExportSettings& settings = ExportSettings());
+
+    // force rebuilds everything regardless of the saved graph.
+    bool Build(const GV_Project_Info& project, bool force = false);
+
+private:
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+    // Stats every path, re-hashing the changed ones on worker threads.
+    void RefreshStamps(const std::vector<std::string>& paths);
+    uint64_t GetHash(const std::string& path) const;
+
+    uint64_t HashSettings() const;
+    uint64_t CookSignature(const std::string& meshPath, const std::vector<std::string>& inputs) const;
+    uint64_t SceneSignature(uint64_t global, const std::vector<std::string>& inputs) const;
+
+private:
+    LogicUnitRegistry& m_registry;
+    ExportSettings m_settings;
+
+    std::map<std::string, BuildStamp> m_stamps;
+    std::map<std::string, BuildNode> m_nodes; // "scene:<name>", "cook:<path>", "pack"
+    uint64_t m_tablesHash = 0;
+    uint64_t m_globalSignature = 0;
+};
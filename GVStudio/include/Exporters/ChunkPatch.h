@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct PatchSettings
+{
+    uint32_t blockSize = 32;               // rolling-hash window for changed chunks
+    uint32_t applyBufferBytes = 64 * 1024; // apply never holds more than this
+};
+
+// Binary delta between two exports of the same chunk file. Chunks whose
+// bytes are unchanged are matched by hash and become one copy from the old
+// file; containers that changed are descended into, and changed leaves get
+// a rolling-hash diff against the whole old file. Apply streams the old
+// file and the patch through a fixed buffer, so it never loads either.
+class ChunkPatch
+{
+public:
+    explicit ChunkPatch(const PatchSettings& settings = PatchSettings());
+
+    bool Create(const std::string& oldPath, const std::string& newPath, const std::string& patchPath);
+    bool Apply(const std::string& oldPath, const std::string& patchPath, const std::string& outPath) const;
+
+    // Patches every export present in both folders into <newDir>/Patches
+    // and applies each patch once to verify it.
+    static bool PatchFolder(const std::string& oldDir, const std::string& newDir,
+        const PatchSettings& settings = PatchSettings());
+
+private:
+    enum class OpKind : uint32_t
+    {
+        Copy = 0,    // bytes from the old file
+        Literal = 1  // bytes carried in the patch
+    };
+
+    struct Op
+    {
+        OpKind kind = OpKind::Copy;
+        uint32_t offset = 0; // old file for copies, new file for literals
+        uint32_t size = 0;
+    };
+
+    void IndexChunks(size_t begin, size_t end);
+    void DiffChunks(size_t begin, size_t end);
+    void DiffRange(size_t begin, size_t end);
+    void BuildBlockIndex();
+
+    bool HasChildren(const std::vector<char>& data, size_t payload, size_t end) const;
+
+    void EmitCopy(uint32_t offset, uint32_t size);
+    void EmitLiteral(uint32_t offset, uint32_t size);
+
+private:
+    PatchSettings m_settings;
+
+    std::vector<char> m_old;
+    std::vector<char> m_new;
+    std::vector<Op> m_ops;
+
+    // Whole old chunks (header included) by content hash.
+    std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> m_oldChunks;
+
+    // Old file blocks by rolling hash, first occurrence wins.
+    std::unordered_map<uint32_t, uint32_t> m_blocks;
+    bool m_blocksBuilt = false;
+
+    uint32_t m_copiedChunks = 0;
+    uint32_t m_diffedChunks = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SceneObject;
+
+constexpr uint32_t GV_EVENT_INVALID = 0xFFFFFFFF;
+
+struct EventEndpoint // an Event or Message param on one object
+{
+    uint32_t objectIndex = 0;
+    uint32_t paramIndex = 0; // runtime slot: separators are not exported
+};
+
+struct EventSceneUsage
+{
+    std::string sceneName;
+    std::unordered_map<std::string, std::vector<EventEndpoint>> senders;   // UI_EVENT params
+    std::unordered_map<std::string, std::vector<EventEndpoint>> receivers; // UI_MESSAGE params
+};
+
+// Collects every event and message name across the project and assigns
+// dense IDs, so the runtime routes events by array index instead of by name.
+class EventCompiler
+{
+public:
+    void Clear();
+
+    void CollectScene(
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects);
+
+    void AssignIds();
+
+    uint32_t GetId(const std::string& name) const;
+    size_t GetIdCount() const;
+
+    // GV_CHUNK_EVENT_TABLE payload: receivers of each event ID in CSR form.
+    std::vector<char> BuildDispatchTable(size_t sceneIndex) const;
+
+    bool WriteHeader(const std::string& path) const;
+
+    // Logs events nobody receives and messages nobody sends.
+    // Returns the number of problems found.
+    size_t Report() const;
+
+    // Compiles a synthetic scene whose logic unit has separators in front
+    // of its Event and Message params, times it and checks every dispatch
+    // entry against the slot the exported param lands in.
+    static void RunBenchmark(uint32_t objectCount);
+
+private:
+    std::vector<EventSceneUsage> m_scenes;
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint32_t> m_ids;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct CookedMesh;
+
+// Compile-time description of what differs between export targets: the
+// output folder, the vertex layout and its alignment, and whether GE display
+// lists are emitted. Chunk payloads are little-endian on every target and
+// textures go out as they are, so only the vertex writer is templated.
+enum class VertexLayout
+{
+    GeTexNormalPos, // GE_VTYPE_COOKED order: u v, nx ny nz, x y z
+    PosNormalTex    // conventional PC order: x y z, nx ny nz, u v
+};
+
+struct PspTarget
+{
+    static constexpr const char* name = "PSP";
+    static constexpr const char* dataSubfolder = ""; // the data folder itself
+    static constexpr uint32_t pointerSize = 4;
+    static constexpr uint32_t vertexAlign = 16;      // GE vertex fetch
+    static constexpr VertexLayout vertexLayout = VertexLayout::GeTexNormalPos;
+    static constexpr bool nativeDisplayLists = true; // GE lists in NATIVEDATA_PLG
+};
+
+// 64-bit debug build of the runtime on PC.
+struct Pc64Target
+{
+    static constexpr const char* name = "PC64";
+    static constexpr const char* dataSubfolder = "PC64";
+    static constexpr uint32_t pointerSize = 8;
+    static constexpr uint32_t vertexAlign = 4;
+    static constexpr VertexLayout vertexLayout = VertexLayout::PosNormalTex;
+    static constexpr bool nativeDisplayLists = false;
+};
+
+// Object record the runtime builds from each SCENE_OBJECT: name index,
+// logic unit type, pool slot (a pointer once loaded), flags; padded to
+// pointer alignment. Nothing in the file has this layout, only MemoryPlan
+// reserves it.
+template<typename Target>
+constexpr uint32_t RuntimeObjectRecordSize()
+{
+    uint32_t size = 12 + Target::pointerSize;
+    return (size + Target::pointerSize - 1) / Target::pointerSize * Target::pointerSize;
+}
+
+enum class ExportTarget
+{
+    Psp,
+    Pc64
+};
+
+// Runtime handle on a target's traits for the parts of the exporter that
+// are not templated; the vertex writer is reached through a function
+// pointer to its per-target instantiation.
+struct ExportTargetInfo
+{
+    const char* name = "";
+    const char* dataSubfolder = "";
+    uint32_t pointerSize = 4;
+    uint32_t objectRecordSize = 16;
+    uint32_t vertexStride = 32;
+    uint32_t vertexAlign = 16;
+    bool nativeDisplayLists = true;
+
+    std::vector<char>(*buildVertexData)(const CookedMesh& mesh) = nullptr;
+};
+
+const ExportTargetInfo& GetTargetInfo(ExportTarget target);
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Exporters/TextureFormat.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// GE command opcodes used by cooked display lists (top 8 bits of a word).
+enum GeCommand : uint32_t
+{
+    GE_CMD_NOP = 0x00,
+    GE_CMD_VADDR = 0x01,
+    GE_CMD_PRIM = 0x04,
+    GE_CMD_JUMP = 0x08,
+    GE_CMD_CALL = 0x0A,
+    GE_CMD_RET = 0x0B,
+    GE_CMD_END = 0x0C,
+    GE_CMD_FINISH = 0x0F,
+    GE_CMD_BASE = 0x10,
+    GE_CMD_VTYPE = 0x12,
+    GE_CMD_TME = 0x1E,
+    GE_CMD_ABE = 0x21,
+    GE_CMD_MATERIALAMBIENT = 0x55,
+    GE_CMD_MATERIALDIFFUSE = 0x56,
+    GE_CMD_MATERIALALPHA = 0x58,
+    GE_CMD_TBP0 = 0xA0,
+    GE_CMD_TBW0 = 0xA8,
+    GE_CMD_CBP = 0xB0,
+    GE_CMD_CBW = 0xB1,
+    GE_CMD_TSIZE0 = 0xB8,
+    GE_CMD_TMODE = 0xC2,
+    GE_CMD_TPSM = 0xC3,
+    GE_CMD_CLOAD = 0xC4,
+    GE_CMD_CMODE = 0xC5,
+    GE_CMD_TFUNC = 0xC9,
+    GE_CMD_TFLUSH = 0xCB
+};
+
+constexpr uint32_t GE_PRIM_TRIANGLES = 3;
+constexpr uint32_t GE_PRIM_MAX_VERTICES = 0xFFFF;
+
+// VTYPE for CookedVertex: 32-bit float texture, normal and position.
+constexpr uint32_t GE_VTYPE_COOKED = (3u << 0) | (3u << 5) | (3u << 7);
+
+// What a relocated address points into. The loader owns the buffers and
+// patches every relocation once the base addresses are known.
+enum class GeRelocTarget : uint32_t
+{
+    VertexBuffer = 0, // index unused: the mesh's own vertex buffer
+    Texture = 1,      // index is the project texture ID
+    Clut = 2          // index is the project texture ID
+};
+
+struct GeRelocation
+{
+    uint32_t word = 0;   // index into the command list
+    GeRelocTarget target = GeRelocTarget::VertexBuffer;
+    uint32_t index = 0;
+    uint32_t offset = 0; // added to the target base address
+    bool high = false;   // false: addr & 0xFFFFFF, true: (addr >> 8) & 0x0F0000
+};
+
+// A relocatable GE command list for one static mesh, ending in RET so the
+// runtime can issue it with sceGuCallList.
+class GeDisplayList
+{
+public:
+    void SetVertexType(uint32_t vtype, uint32_t stride);
+    void SetTexture(uint32_t textureId, const TextureFormat& format);
+    void DisableTexture();
+    void SetMaterial(uint32_t rgba);
+
+    // Triangle list from the vertex buffer; split at the PRIM count limit.
+    void DrawTriangles(uint32_t firstVertex, uint32_t vertexCount);
+
+    void Return();
+
+    const std::vector<uint32_t>& GetWords() const;
+    const std::vector<GeRelocation>& GetRelocations() const;
+
+    // GV_CHUNK_NATIVEDATA_PLG payload: stride, words, relocations.
+    std::vector<char> BuildChunk() const;
+
+private:
+    void Emit(uint32_t cmd, uint32_t arg);
+    void EmitAddress(uint32_t lowCmd, uint32_t highCmd, uint32_t highArg,
+        GeRelocTarget target, uint32_t index, uint32_t offset);
+
+private:
+    std::vector<uint32_t> m_words;
+    std::vector<GeRelocation> m_relocations;
+
+    uint32_t m_stride = 0;
+    // Last emitted state, so repeated parts do not reload it.
+    int m_textureEnabled = -1;
+    int m_blendEnabled = -1;
+    uint32_t m_textureId = GV_TEXTURE_NONE;
+    uint32_t m_rgba = 0;
+    bool m_hasMaterial = false;
+};
+
+// Host-side reader for cooked display lists, so they can be checked
+// without hardware.
+namespace GeDecoder
+{
+    const char* GetCommandName(uint32_t cmd);
+
+    // Walks the list the way the GE would and checks that every command is
+    // known, every relocation patches an address command of the matching
+    // kind, state is complete before each PRIM, every vertex fetch stays
+    // inside vertexBufferSize, and the list ends in RET/END/FINISH.
+    bool Validate(const std::vector<char>& payload, uint32_t vertexBufferSize, std::string& outError);
+
+    // One line per command with decoded arguments and relocation targets.
+    std::string Disassemble(const std::vector<char>& payload);
+}
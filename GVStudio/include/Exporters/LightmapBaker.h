@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Exporters/WorldSectors.h"
+#include "MiniMath/MiniMath.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class SceneObject;
+class TriangleBVH;
+
+// Point light read from a GV_CHUNK_LIGHT logic unit (posX/Y/Z,
+// colorR/G/B, intensity, radius; radius 0 means inverse-square falloff).
+struct LightmapLight
+{
+    Vec3 position;
+    Vec3 color = Vec3(1.0f, 1.0f, 1.0f);
+    float intensity = 1.0f;
+    float radius = 0.0f;
+};
+
+struct LightmapSettings
+{
+    float texelsPerUnit = 4.0f;
+    uint32_t pageSize = 256;     // square, power of two
+    uint32_t maxChartSize = 64;  // texels; charts stop growing here, larger triangles are scaled down
+    uint32_t passes = 4;         // progressive passes; 1 for a quick preview
+    uint32_t samplesPerPass = 16; // indirect rays per texel per pass
+    uint32_t tileSize = 16;      // clamped to 1..pageSize
+    uint32_t threads = 0;        // 0: one per hardware thread
+    Vec3 ambient = Vec3(0.03f, 0.03f, 0.03f);
+};
+
+// Called after every pass with the passes done so far; GetPage() already
+// holds their result, so the callback can show it. Return false to stop;
+// the result of the finished passes is kept.
+using LightmapProgress = std::function<bool(uint32_t pass, uint32_t passCount)>;
+
+// Adjacent coplanar triangles of one object part, unwrapped together into
+// one rectangle of the atlas, so their shared edges get no seam.
+struct LightmapChart
+{
+    uint32_t firstTriangle = 0; // into GetChartTriangles()
+    uint32_t triangleCount = 0;
+    uint32_t page = 0;
+    uint32_t x = 0; // rect including padding
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    Vec3 origin; // world position of local (0,0)
+    Vec3 axisU;
+    Vec3 axisV;
+    Vec3 normal;
+    float minU = 0.0f;
+    float minV = 0.0f;
+    float scale = 1.0f; // texels per world unit
+};
+
+// Where one baked triangle landed.
+struct LightmapTriangle
+{
+    uint32_t chart = 0;
+    float uv[3][2] = {}; // lightmap UVs of the corners, 0..1
+};
+
+// CPU lightmap bake: triangles are merged into charts across shared
+// coplanar edges, the charts shelf packed into pages, then direct light
+// plus one diffuse bounce is traced against a TriangleBVH. Work is split
+// into tiles shared by all worker threads.
+class LightmapBaker
+{
+public:
+    static std::vector<LightmapLight> CollectLights(const std::vector<const SceneObject*>& objects);
+
+    // albedo[i] is the diffuse colour of triangles[i]; bvh must be built
+    // from the same triangles in the same order. Returns false if nothing
+    // was baked (no lights, settings that cannot pack a chart, or
+    // cancelled before the first pass).
+    bool Bake(const std::vector<WorldTriangle>& triangles,
+        const std::vector<Vec3>& albedo,
+        const TriangleBVH& bvh,
+        const std::vector<LightmapLight>& lights,
+        const LightmapSettings& settings,
+        const LightmapProgress& progress = nullptr);
+
+    // Safe to call from any thread. Stops a running Bake mid-pass, or the
+    // next one before its first pass; the flag clears when Bake returns.
+    void Cancel();
+
+    uint32_t GetPageCount() const;
+    const std::vector<LightmapChart>& GetCharts() const;
+    const std::vector<uint32_t>& GetChartTriangles() const;
+    const std::vector<LightmapTriangle>& GetTriangles() const; // one per baked triangle
+
+    // Final lightmap colour of one page, RGB 0..1, row-major.
+    const std::vector<Vec3>& GetPage(uint32_t page) const;
+
+    // GV_CHUNK_LIGHTMAP payload: pages as 8-bit CLUT GV_CHUNK_TEXTURE_NATIVE
+    // chunks. Meshes reference them by index from GV_CHUNK_LIGHTMAP_UV.
+    std::vector<char> BuildChunk() const;
+
+    // GV_CHUNK_LIGHTMAP_UV payload for one object, nested in the
+    // GV_CHUNK_STATIC_MESH it is drawn with: the object index, then per
+    // mesh part the page and corner UVs of each triangle in vertex order.
+    // objectTriangles are the object's indices into the baked triangles.
+    std::vector<char> BuildMeshUVChunk(uint32_t objectIndex, uint32_t partCount,
+        const std::vector<WorldTriangle>& triangles,
+        const std::vector<uint32_t>& objectTriangles) const;
+
+    uint32_t GetPageSize() const;
+
+    void Report(const std::string& sceneName) const;
+
+private:
+    struct Texel
+    {
+        int32_t chart = -1;
+        Vec3 position;
+        Vec3 normal;
+        Vec3 direct;
+        Vec3 indirect; // running sum
+        uint32_t samples = 0;
+    };
+
+    struct Page
+    {
+        std::vector<Texel> texels;
+        std::vector<Vec3> color;
+    };
+
+    void PackCharts(const std::vector<WorldTriangle>& triangles);
+    void Rasterize(const std::vector<WorldTriangle>& triangles);
+
+    void TraceTile(uint32_t page, uint32_t tileX, uint32_t tileY, uint32_t pass,
+        const std::vector<Vec3>& albedo,
+        const TriangleBVH& bvh,
+        const std::vector<LightmapLight>& lights);
+
+    Vec3 DirectLight(const Vec3& position, const Vec3& normal,
+        const TriangleBVH& bvh,
+        const std::vector<LightmapLight>& lights) const;
+
+    void Resolve();
+
+    static std::vector<char> BuildTextureChunk(const std::string& name, const std::vector<Vec3>& color, uint32_t size);
+
+private:
+    LightmapSettings m_settings;
+    std::vector<LightmapChart> m_charts;
+    std::vector<uint32_t> m_chartTriangles;
+    std::vector<LightmapTriangle> m_triangles;
+    std::vector<Page> m_pages;
+
+    std::atomic<bool> m_cancel{ false };
+
+    uint32_t m_passesDone = 0;
+    uint64_t m_raysCast = 0;
+    uint32_t m_threadCount = 0;
+    uint64_t m_coveredTexels = 0;
+    double m_bakeMs = 0.0;
+    std::vector<double> m_passMs;
+};
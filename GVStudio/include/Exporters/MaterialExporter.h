@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Exporters/WorldSectors.h"
+#include "GVFramework/Material/Material.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class SceneObject;
+class MeshCache;
+struct CookedMesh;
+
+// A deduplicated material as the runtime sees it.
+struct ExportMaterial
+{
+    uint32_t id = 0;
+    uint32_t rgba = 0xFFFFFFFFu; // Kd and d packed as 8888, R in the low byte
+    uint32_t illum = 0;
+    uint32_t textureId = GV_TEXTURE_NONE;
+
+    bool IsTranslucent() const { return (rgba >> 24) != 0xFF; }
+};
+
+struct StateChangeCount
+{
+    uint32_t textures = 0;  // TBP0/TSIZE0/TFLUSH reloads
+    uint32_t materials = 0; // colour and blend state reloads
+};
+
+// Project-wide material table. IDs are stable across scenes so sectors of
+// different scenes can share cooked material data.
+class MaterialExporter
+{
+public:
+    void Clear();
+
+    void SetResourceRoot(const std::string& resourceRoot);
+
+    // Turns every model of the scene into per-part draw items and buckets
+    // them into sectors. Materials are registered as they are first seen.
+    void CollectDrawItems(
+        const std::vector<const SceneObject*>& objects,
+        MeshCache& meshes,
+        WorldSectors& outSectors);
+
+    // World-space triangles of every model, in the same object/part order
+    // as the draw items.
+    void CollectTriangles(
+        const std::vector<const SceneObject*>& objects,
+        MeshCache& meshes,
+        std::vector<WorldTriangle>& outTriangles);
+
+    // Material of one sub-mesh, registered on first use.
+    const ExportMaterial& ResolveMaterial(const CookedMesh& mesh, size_t partIndex);
+
+    // Opaque first, then translucent; within each, grouped by texture and
+    // then by material so the GE reloads as little state as possible.
+    static void SortSector(WorldSector& sector);
+
+    static StateChangeCount CountStateChanges(const std::vector<WorldDrawItem>& items);
+
+    // GV_CHUNK_WORLD_SECTOR payload: STRUCT with the draw items followed by
+    // a MATERIAL_LIST of the materials the sector uses.
+    std::vector<char> BuildSectorChunk(uint32_t sectorIndex, const WorldSector& sector) const;
+
+    const std::vector<ExportMaterial>& GetMaterials() const;
+    const std::vector<std::string>& GetTextures() const;
+
+private:
+    uint32_t RegisterMaterial(const GV_Material& material);
+    uint32_t RegisterTexture(const std::string& path);
+
+    template <typename Visit>
+    void ForEachPart(
+        const std::vector<const SceneObject*>& objects,
+        MeshCache& meshes,
+        Visit&& visit);
+
+    const GV_Material* FindMaterial(const std::string& library, const std::string& name);
+
+    std::vector<char> BuildMaterialChunk(const ExportMaterial& material) const;
+
+private:
+    std::string m_resourceRoot;
+
+    std::vector<ExportMaterial> m_materials;
+    std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> m_materialIds; // (rgba, illum, texture)
+
+    std::vector<std::string> m_textures; // relative to the resource root
+    std::map<std::string, uint32_t> m_textureIds;
+
+    std::map<std::string, std::vector<GV_Material>> m_libraries; // parsed MTL files
+};
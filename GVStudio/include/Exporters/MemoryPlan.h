@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class SceneObject;
+class MeshCache;
+class PerfectHash;
+struct ExportTargetInfo;
+
+enum class MemoryPlanKind : uint32_t
+{
+    ObjectArray = 0,
+    LogicUnitPool = 1,
+    StringPool = 2,
+    EventTable = 3,
+    MeshBuffer = 4,
+    TextureBuffer = 5,
+    ClutBuffer = 6,
+    NameHash = 7,   // seeds, slot table and name offsets of a NAME_HASH
+    NameStrings = 8 // the names a NAME_HASH verifies against
+};
+
+struct MemoryPlanEntry
+{
+    MemoryPlanKind kind = MemoryPlanKind::ObjectArray;
+    std::string label;
+    uint32_t count = 0;       // elements in the allocation
+    uint32_t elementSize = 0;
+    uint32_t size = 0;
+    uint32_t align = 4;
+    uint32_t offset = 0;      // from the arena base, assigned by Finalize()
+};
+
+// Every allocation a scene needs at load time, carved out of one arena.
+// The runtime allocates GetArenaSize() once and never calls malloc per scene.
+class MemoryPlan
+{
+public:
+    static constexpr uint32_t kArenaAlign = 64;
+
+    // Record, vertex and texture sizes follow the target's traits. Either
+    // name hash may be null when the scene does not write it.
+    static MemoryPlan ForScene(
+        const std::vector<const SceneObject*>& objects,
+        const std::string& resourceRoot,
+        uint32_t eventTableSize,
+        MeshCache& meshes,
+        const ExportTargetInfo& target,
+        const PerfectHash* objectNames,
+        const PerfectHash* assetNames);
+
+    void Add(MemoryPlanKind kind, const std::string& label,
+        uint32_t count, uint32_t elementSize, uint32_t align);
+
+    // Orders allocations by alignment and assigns arena offsets.
+    void Finalize();
+
+    uint32_t GetArenaSize() const;
+    const std::vector<MemoryPlanEntry>& GetEntries() const;
+
+    // GV_CHUNK_MEMORY_PLAN payload.
+    std::vector<char> BuildChunk() const;
+
+    void Report(const std::string& sceneName) const;
+
+    // Replays a GV_CHUNK_MEMORY_PLAN payload the way the runtime would:
+    // one arena, bump allocation in plan order, alignment and bounds
+    // checked, no overlaps. Then walks the scene's chunks and checks that
+    // every object, pool, string, event table, name hash, vertex buffer and
+    // referenced texture has a slot at least as large as the chunk data
+    // that fills it. Returns false on the first violation.
+    static bool Simulate(const std::vector<char>& payload, const char* scene, size_t sceneSize);
+
+private:
+    std::vector<MemoryPlanEntry> m_entries;
+    uint32_t m_arenaSize = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Exporters/GeDisplayList.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Vertex in GE order (texture, normal, position), 32-bit floats.
+struct CookedVertex
+{
+    float u, v;
+    float nx, ny, nz;
+    float x, y, z;
+};
+
+struct CookedSubMesh
+{
+    std::string material;
+    std::vector<CookedVertex> vertices; // triangle list
+};
+
+struct CookedMesh
+{
+    std::string path;
+    std::string materialLibrary; // mtllib, resolved against the OBJ folder
+    std::vector<CookedSubMesh> parts;
+
+    size_t GetVertexCount() const;
+};
+
+// Render state of one sub-mesh, resolved by the material stage.
+struct CookedPartState
+{
+    uint32_t rgba = 0xFFFFFFFFu;
+    uint32_t textureId = GV_TEXTURE_NONE;
+    TextureFormat texture;
+};
+
+namespace MeshCooker
+{
+    // Bumped whenever cooked output changes, so incremental builds redo it.
+    constexpr uint32_t VERSION = 1;
+
+    // Portable OBJ loader for the exporter (the renderer's loader is GL bound).
+    bool CookObj(const std::string& path, CookedMesh& outMesh);
+
+    // Vertex buffer in the target's layout, parts back to back. Instantiated for PspTarget and Pc64Target (ExportTarget.h).
+    template<typename Target>
+    std::vector<char> BuildVertexData(const CookedMesh& mesh);
+
+    // One GE call list drawing every part with its state; the vertex buffer
+    // and texture addresses are left as relocations. states[i] is parts[i].
+    GeDisplayList BuildDisplayList(const CookedMesh& mesh, const std::vector<CookedPartState>& states);
+}
+
+// Cooks each OBJ once per export; every stage shares the result.
+class MeshCache
+{
+public:
+    const CookedMesh* Get(const std::string& path);
+    void Clear();
+
+    // Cooks every path not cached yet, spread over threads (0 = hardware).
+    void CookAll(const std::vector<std::string>& paths, uint32_t threads = 0);
+
+private:
+    std::map<std::string, std::unique_ptr<CookedMesh>> m_meshes;
+};
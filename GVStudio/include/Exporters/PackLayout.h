@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// UMD timings: loading is dominated by seeks, not bandwidth.
+struct UmdCostModel
+{
+    double seekMs = 120.0;          // fixed cost of any non-sequential read
+    double seekMsPerMB = 2.0;       // extra cost per MB of head travel
+    double transferKBps = 1400.0;
+    uint32_t sectorSize = 2048;
+    uint32_t duplicateMaxBytes = 16 * 1024 * 1024; // disc space all copies may take
+};
+
+struct PackFile
+{
+    std::string name;       // name inside the pack
+    std::string sourcePath; // file on disk
+    uint32_t size = 0;
+};
+
+struct PackPlacement
+{
+    uint32_t fileIndex = 0;
+    uint32_t offset = 0; // from the start of the pack data, sector aligned
+};
+
+struct PackSceneTrace
+{
+    std::string sceneName;
+    std::vector<uint32_t> needOrder; // file indices in the order they are read
+};
+
+struct PackSimResult
+{
+    double ms = 0.0;
+    uint32_t seeks = 0;
+    uint64_t bytes = 0;
+};
+
+// Lays out every file the game loads so each scene reads front to back,
+// starting with the startup scene. Files a scene shares with an earlier
+// one are read from the earlier copy, or copied inline where the seeks
+// that saves are worth the most per byte of the duplicate budget.
+class PackLayout
+{
+public:
+    explicit PackLayout(const UmdCostModel& model);
+
+    uint32_t AddFile(const std::string& name, const std::string& sourcePath);
+
+    // Scenes must be recorded in load order, startup scene first.
+    void RecordScene(const std::string& sceneName, const std::vector<uint32_t>& needOrder);
+
+    void Build();
+
+    void Report() const;
+
+    bool WritePack(const std::string& path) const;
+
+private:
+    struct Layout
+    {
+        std::vector<PackPlacement> placements;
+        std::vector<std::vector<uint32_t>> reads; // per scene, placement indices
+        uint32_t size = 0;
+    };
+
+    uint32_t AlignToSector(uint32_t value) const;
+    double SeekMs(uint32_t from, uint32_t to) const;
+    void BuildNaive();
+    void BuildSequential();
+
+    // Places each scene's files after the previous scene's, copying the
+    // reads flagged in copy[scene][need] and reusing earlier placements
+    // for the rest. sceneStart receives where each scene's files begin.
+    void PlaceScenes(const std::vector<std::vector<char>>& copy, Layout& layout,
+        std::vector<uint32_t>& sceneStart) const;
+    PackSimResult Simulate(const Layout& layout, size_t sceneIndex) const;
+
+private:
+    UmdCostModel m_model;
+    std::vector<PackFile> m_files;
+    std::vector<PackSceneTrace> m_scenes;
+
+    Layout m_naive;
+    Layout m_optimized;
+};
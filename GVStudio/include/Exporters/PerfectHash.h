@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class NameHashKind : uint32_t
+{
+    Objects = 0,
+    Assets = 1
+};
+
+// Minimal perfect hash over a fixed name set (CHD / hash-and-displace).
+// A name is hashed once; the high half picks a bucket, the low half is
+// displaced by that bucket's seed into a unique slot in [0, n). One string
+// compare against the slot's name rejects unknown keys.
+class PerfectHash
+{
+public:
+    static uint64_t Hash(const char* key, size_t length, uint32_t seed);
+    static uint32_t Displace(uint64_t hash, uint32_t seed);
+
+    // Fails only on duplicate names.
+    bool Build(const std::vector<std::string>& names);
+
+    uint32_t Slot(const std::string& key) const;
+
+    // Index into the names passed to Build(), or -1 when not found.
+    int Lookup(const std::string& key) const;
+
+    size_t GetKeyCount() const;
+    size_t GetBucketCount() const;
+
+    // Bytes BuildChunk() spends on the lookup tables and on the names.
+    size_t GetTableBytes() const;
+    size_t GetStringBytes() const;
+
+    // GV_CHUNK_NAME_HASH payload.
+    std::vector<char> BuildChunk(NameHashKind kind) const;
+
+    // Host-side comparison against std::unordered_map, logged to stdout.
+    static void RunBenchmark(size_t keyCount, size_t lookups);
+
+private:
+    uint32_t m_globalSeed = 0;
+    std::vector<uint32_t> m_seeds;        // per bucket displacement seed
+    std::vector<uint32_t> m_slotToIndex;  // slot -> original name index
+    std::vector<std::string> m_slotNames; // slot -> name, for verification
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Exporters/BspBuilder.h"
+#include "Exporters/EventCompiler.h"
+#include "Exporters/ExportTarget.h"
+#include "Exporters/LightmapBaker.h"
+#include "Exporters/MaterialExporter.h"
+#include "Exporters/MeshCooker.h"
+#include "Exporters/PackLayout.h"
+#include "Exporters/PvsBuilder.h"
+#include "Exporters/SharedChunkPack.h"
+
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+struct GV_Project_Info;
+struct GV_Scene_Info;
+struct SceneFolder;
+struct GV_Logic_Unit_Instance;
+class SceneObject;
+class LogicUnitRegistry;
+
+enum class WorldLayout
+{
+    Grid, // GV_CHUNK_WORLD_SECTOR cells with per-cell material lists
+    Bsp   // GV_CHUNK_WORLD with plane and atomic sectors
+};
+
+// Lightmap pages as the last finished bake pass left them.
+struct LightmapPreview
+{
+    std::string sceneName;
+    uint32_t pass = 0;
+    uint32_t passCount = 0;
+    uint32_t pageSize = 0;
+    std::vector<std::vector<uint32_t>> pages; // RGBA8, row-major
+};
+
+// Shared by an export running on a worker thread and the UI that started
+// it. Every target exporter of one export uses the same control.
+class ExportControl
+{
+public:
+    // Stops running lightmap bakes mid-pass and the export before its next
+    // scene; the export then fails.
+    void Cancel();
+    bool IsCancelled() const;
+
+    // The exporter registers each bake so Cancel() reaches it.
+    void BeginBake(LightmapBaker* baker);
+    void EndBake(LightmapBaker* baker);
+
+    void SetPreview(const std::string& sceneName, const LightmapBaker& baker, uint32_t pass, uint32_t passCount);
+
+    // Copies the preview if it changed since version, and updates version.
+    bool GetPreview(uint32_t& version, LightmapPreview& out) const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::atomic<bool> m_cancel{ false };
+    std::vector<LightmapBaker*> m_bakers;
+    LightmapPreview m_preview;
+    uint32_t m_version = 0;
+};
+
+struct ExportSettings
+{
+    // Each target is written to its data subfolder; more than one target
+    // exports them in parallel, one exporter per target.
+    std::vector<ExportTarget> targets = { ExportTarget::Psp };
+    bool writePack = true; // UMD-ordered pack of every scene and asset
+    UmdCostModel umd;
+    bool writeSharedPack = true; // content-addressed chunk store + per-scene .gvref
+    SharedPackSettings shared;
+    WorldLayout worldLayout = WorldLayout::Grid;
+    float sectorSize = 64.0f; // world units per sector cell on XZ (Grid)
+    BspSettings bsp;
+    bool writeChecksums = true; // CRC-32C per top-level chunk, see ChunkChecksum
+    bool dumpDisplayLists = false; // <scene>.ge.txt disassembly next to the .gvs
+    bool computePvs = true;
+    PvsSettings pvs;
+    bool bakeLightmaps = true; // only scenes with light units are baked
+    LightmapSettings lightmap;
+    ExportControl* control = nullptr; // cancel and lightmap preview, optional
+};
+
+// Lets a build orchestrator limit what an export writes. Every scene is
+// still loaded and its materials registered, so event, material and texture
+// IDs always match a full export.
+struct ExportScope
+{
+    bool allScenes = true;
+    std::set<std::string> scenes;    // written when allScenes is false
+    uint64_t previousTablesHash = 0; // all scenes are written if the tables changed
+
+    // Filled in by the export. Paths are absolute.
+    uint64_t tablesHash = 0;         // event header plus material/texture tables
+    std::set<std::string> written;
+    std::map<std::string, std::vector<std::string>> sceneInputs; // scene files, assets and meshes read
+    std::map<std::string, std::vector<std::string>> meshInputs;  // OBJ -> OBJ, MTL, textures
+};
+
+class ProjectExporter
+{
+public:
+    explicit ProjectExporter(LogicUnitRegistry& registry,
+        const ExportSettings& settings = ExportSettings());
+
+    // Writes every scene of the project as a chunk file into the data folder.
+    // A scope describes one target's output, so it needs a single target.
+    bool ExportProject(const GV_Project_Info& project, ExportScope* scope = nullptr);
+
+    static void CollectObjects(
+        const SceneFolder& folder,
+        std::vector<const SceneObject*>& outObjects);
+
+    // Sorted, unique asset paths referenced by the objects; the index of a
+    // path in this list is its asset index in the exported scene.
+    static std::vector<std::string> CollectAssetPaths(
+        const std::vector<const SceneObject*>& objects);
+
+private:
+    bool ExportTargets(const GV_Project_Info& project);
+
+    std::set<std::string> CollectModelPaths(const std::vector<const SceneObject*>& objects) const;
+    void CollectSceneInputs(
+        const std::string& sceneName,
+        const std::string& sceneDir,
+        const std::vector<const SceneObject*>& objects,
+        ExportScope& scope);
+
+    // Registers every material a scene draws with, in export order.
+    void RegisterMaterials(const std::vector<const SceneObject*>& objects);
+    uint64_t HashTables(const std::string& eventHeaderPath) const;
+
+    bool ExportScene(
+        const std::string& sceneName,
+        size_t sceneIndex,
+        const std::vector<const SceneObject*>& objects,
+        const std::string& outPath);
+
+    bool WritePack(
+        const GV_Project_Info& project,
+        const std::vector<std::vector<const SceneObject*>>& sceneObjects,
+        const std::string& dataDir);
+
+    bool WriteSharedPack(
+        const GV_Project_Info& project,
+        const std::string& dataDir);
+
+    // Startup scene first, then the rest in project order.
+    static std::vector<size_t> GetLoadOrder(const GV_Project_Info& project);
+
+    bool IsCancelled() const;
+
+    // baker is null when the scene has no lightmaps; otherwise every mesh
+    // gets the lightmap UVs of the objects drawn with it.
+    bool WriteStaticMeshes(
+        std::ofstream& out,
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects,
+        const std::string& outPath,
+        const LightmapBaker* baker,
+        const std::vector<WorldTriangle>& lightmapTriangles);
+
+    void WriteSectors(
+        std::ofstream& out,
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects);
+
+    void WriteBspWorld(
+        std::ofstream& out,
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects);
+
+    void WritePvs(
+        std::ofstream& out,
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects,
+        const std::vector<WorldSector>& sectors);
+
+    // False if the scene has no lights or the bake was cancelled.
+    bool BakeLightmaps(
+        const std::string& sceneName,
+        const std::vector<const SceneObject*>& objects,
+        LightmapBaker& baker,
+        std::vector<WorldTriangle>& outTriangles);
+
+    std::vector<char> BuildSceneObjectChunk(const SceneObject& obj) const;
+    std::vector<char> BuildLogicUnitChunk(const GV_Logic_Unit_Instance& inst) const;
+
+private:
+    LogicUnitRegistry& m_registry;
+    ExportSettings m_settings;
+    const ExportTargetInfo* m_target;
+    EventCompiler m_events;
+    MeshCache m_meshes;
+    MaterialExporter m_materials;
+    std::map<uint32_t, TextureFormat> m_textureFormats; // by texture ID
+
+    std::string m_resourceRoot;
+};
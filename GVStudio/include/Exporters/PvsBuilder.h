@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Exporters/WorldSectors.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class TriangleBVH;
+
+struct PvsSettings
+{
+    uint32_t raysPerPair = 256; // upper bound; stops at the first clear ray
+    uint32_t threads = 0;       // 0: one per hardware thread
+};
+
+// Sector-to-sector potentially visible sets. Two sectors see each other if
+// any sampled segment between their bounds reaches across unoccluded.
+// Sampling can miss thin gaps, so the result is approximate, not
+// conservative; raise raysPerPair for levels with small openings.
+class PvsBuilder
+{
+public:
+    void Build(const std::vector<WorldSector>& sectors,
+        const TriangleBVH& occluders,
+        const PvsSettings& settings);
+
+    bool IsVisible(uint32_t from, uint32_t to) const;
+    uint32_t GetVisibleCount(uint32_t from) const;
+    uint32_t GetSectorCount() const;
+
+    // GV_CHUNK_PVS payload: sector count, row bytes, row offsets, then the
+    // zero-run compressed rows. The runtime decompresses the current
+    // sector's row once and tests one bit per sector.
+    std::vector<char> BuildChunk() const;
+
+    void Report(const std::string& sceneName) const;
+
+    // A zero byte is followed by a count of zero bytes (1-255); other bytes
+    // are literal.
+    static std::vector<uint8_t> CompressRow(const uint8_t* row, uint32_t rowBytes);
+    static std::vector<uint8_t> DecompressRow(const uint8_t* data, size_t size, uint32_t rowBytes);
+
+private:
+    void SetVisible(uint32_t a, uint32_t b);
+
+private:
+    uint32_t m_sectorCount = 0;
+    uint32_t m_rowBytes = 0;
+    std::vector<uint8_t> m_bits; // row-major, bit b of row a: a sees b
+
+    double m_buildMs = 0.0;
+    uint64_t m_raysCast = 0;
+    uint32_t m_threadCount = 0;
+    size_t m_occluderCount = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Exporters/PackLayout.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SimulatorSettings
+{
+    uint32_t memoryCap = 24 * 1024 * 1024; // PSP-1000 user partition
+    uint32_t userBase = 0x08800000;        // first user RAM address
+    uint32_t geAlign = 16;                 // vertex, list and texture buffers
+    uint32_t iterations = 5;               // timings are the best of N loads
+    bool verifyChecksums = true;
+    UmdCostModel umd;
+};
+
+struct SimAllocation
+{
+    std::string label;
+    uint32_t address = 0;
+    uint32_t size = 0;
+    uint32_t align = 4;
+    bool temporary = false; // freed once the scene is loaded
+};
+
+struct SimSceneReport
+{
+    std::string scene;
+    std::string path;
+    uint64_t fileBytes = 0;
+    bool ok = false;
+    std::string error;
+
+    uint32_t chunks = 0;
+    uint32_t checksumsVerified = 0;
+    uint32_t meshes = 0;
+    uint32_t objects = 0;
+    uint32_t relocations = 0;
+    uint32_t pvsRows = 0;
+    uint32_t lightmapPages = 0;
+
+    std::vector<SimAllocation> allocations;
+    uint32_t peakBytes = 0;
+    uint32_t residentBytes = 0;
+
+    double readMs = 0.0;
+    double verifyMs = 0.0;
+    double parseMs = 0.0;
+    double decompressMs = 0.0;
+    double fixupMs = 0.0;
+    double totalMs = 0.0;
+    double umdReadMs = 0.0; // modelled, from the file size
+};
+
+// Loads exported scene files the way the PSP runtime does, on the host:
+// the file is read into a temporary buffer at the top of a capped heap,
+// the MEMORY_PLAN arena and resident chunks are carved from the bottom,
+// PVS rows are decompressed and GE display lists are relocated against
+// the simulated addresses. Every allocation, alignment violation and
+// phase time is recorded so exports can be compared on any machine.
+class RuntimeSimulator
+{
+public:
+    explicit RuntimeSimulator(const SimulatorSettings& settings = SimulatorSettings());
+
+    bool LoadScene(const std::string& path);
+
+    // Every .gvs in the folder, in name order.
+    bool LoadFolder(const std::string& dataDir);
+
+    const std::vector<SimSceneReport>& GetReports() const;
+
+    // Machine-readable report of every scene loaded so far.
+    bool WriteReport(const std::string& path) const;
+
+    // LoadFolder, then <dataDir>/RuntimeReport.json unless reportPath is set.
+    static bool Run(const std::string& dataDir, const std::string& reportPath = std::string(),
+        const SimulatorSettings& settings = SimulatorSettings());
+
+private:
+    class Heap;
+
+    bool LoadOnce(const std::vector<char>& data, SimSceneReport& report) const;
+
+private:
+    SimulatorSettings m_settings;
+    std::vector<SimSceneReport> m_reports;
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+struct SharedPackSettings
+{
+    uint32_t maxReadsPerScene = 4;        // shared groups are copied per scene beyond this
+    uint32_t coalesceGapBytes = 32 * 1024; // read through gaps up to this size
+};
+
+// Project-wide content-addressed chunk store. Scene files are split into
+// leaf chunks (containers such as scene objects and static meshes are
+// split one level further), every distinct leaf is stored once under its
+// xxHash64, and each scene gets a reference file listing its chunk tree by
+// hash plus the few contiguous store reads that fetch all of it.
+class SharedChunkPack
+{
+public:
+    explicit SharedChunkPack(const SharedPackSettings& settings);
+
+    // Scenes must be added in load order. Fails on a malformed scene file
+    // or a hash collision.
+    bool AddScene(const std::string& sceneName, const std::vector<char>& sceneData);
+
+    // Orders the store so each scene's chunks form few runs, copying small
+    // shared groups into a scene's private run where it needs fewer reads.
+    void Build();
+
+    // <storePath> holds the chunks; one <scene>.gvref per scene in refDir.
+    bool Write(const std::string& storePath, const std::string& refDir) const;
+
+    void Report() const;
+
+private:
+    struct Entry
+    {
+        uint32_t type = 0;
+        uint32_t version = 0;
+        uint64_t hash = 0;           // leaves only
+        std::vector<Entry> children; // containers only
+    };
+
+    struct Blob
+    {
+        std::vector<char> bytes; // header and payload
+        std::vector<uint32_t> scenes;
+    };
+
+    struct Group
+    {
+        std::vector<uint32_t> readers; // scenes that fetch this group
+        std::vector<uint64_t> blobs;   // in first-use order
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    struct Read
+    {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    bool SplitChunks(const std::vector<char>& data, size_t begin, size_t end,
+        uint32_t sceneIndex, std::vector<Entry>& out);
+
+    void Layout();
+    std::vector<Read> GetReads(uint32_t sceneIndex) const;
+    bool PrivatizeSmallestShared(uint32_t sceneIndex);
+    uint32_t FindBlobOffset(uint32_t sceneIndex, uint64_t hash) const;
+    uint32_t GetStoreSize() const;
+
+    void AppendEntries(std::vector<char>& out, uint32_t sceneIndex, const std::vector<Entry>& entries) const;
+
+private:
+    SharedPackSettings m_settings;
+
+    std::vector<std::string> m_sceneNames;
+    std::vector<std::vector<Entry>> m_sceneEntries;
+    std::vector<uint64_t> m_sceneBytes;
+    std::vector<std::vector<uint64_t>> m_sceneUseOrder;
+
+    std::map<uint64_t, Blob> m_blobs;
+    std::vector<Group> m_groups;
+
+    // Store offset of every blob copy, keyed by (group, hash).
+    std::map<std::pair<size_t, uint64_t>, uint32_t> m_offsets;
+
+    uint32_t m_dataStart = 0;
+    uint64_t m_duplicatedBytes = 0;
+};
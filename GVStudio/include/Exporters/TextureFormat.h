@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+constexpr uint32_t GV_TEXTURE_NONE = 0xFFFFFFFFu; // texture ID of untextured materials
+
+// GE texture pixel formats (TPSM).
+enum class GePixelFormat : uint32_t
+{
+    PSM_5650 = 0,
+    PSM_5551 = 1,
+    PSM_4444 = 2,
+    PSM_8888 = 3,
+    PSM_T4 = 4,
+    PSM_T8 = 5
+};
+
+// How a source image is stored in VRAM/RAM on the target.
+struct TextureFormat
+{
+    uint32_t width = 0;        // source size
+    uint32_t height = 0;
+    uint32_t bufferWidth = 0;  // power-of-two storage size
+    uint32_t bufferHeight = 0;
+    uint32_t bpp = 32;
+    GePixelFormat psm = GePixelFormat::PSM_8888;
+    uint32_t clutEntries = 0;  // 32-bit entries, 0 for direct color
+
+    uint32_t GetDataSize() const;
+    uint32_t GetClutSize() const;
+};
+
+namespace TextureCooker
+{
+    // Reads the BMP header only. The GE wants power-of-two textures; true
+    // color is stored as 8888, indexed images keep their depth plus a CLUT.
+    bool ReadFormat(const std::string& path, TextureFormat& outFormat);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "MiniMath/MiniMath.h"
+
+#include <cstdint>
+#include <vector>
+
+struct BvhTriangle
+{
+    Vec3 v0, v1, v2;
+};
+
+// Static bounding volume hierarchy over world triangles for offline ray
+// queries (visibility, baking). Built once, then read-only and safe to
+// query from any number of threads.
+class TriangleBVH
+{
+public:
+    void Build(std::vector<BvhTriangle> triangles);
+
+    // True if anything blocks the segment from -> to (endpoints excluded).
+    bool Occluded(const Vec3& from, const Vec3& to) const;
+
+    // Nearest hit along the ray within maxT; outT and outTriangle (index into
+    // the array passed to Build) are only written on a hit.
+    bool Intersect(const Vec3& origin, const Vec3& dir, float maxT,
+        float& outT, uint32_t& outTriangle) const;
+
+    size_t GetTriangleCount() const;
+    size_t GetNodeCount() const;
+
+private:
+    struct Node
+    {
+        Vec3 boundsMin;
+        Vec3 boundsMax;
+        uint32_t first = 0; // leaf: first triangle; inner: right child
+        uint32_t count = 0; // leaf: triangle count; inner: 0
+    };
+
+    uint32_t BuildNode(std::vector<uint32_t>& order, uint32_t first, uint32_t count);
+
+    template <typename Visit>
+    void Traverse(const Vec3& origin, const Vec3& dir, float maxT, Visit&& visit) const;
+
+private:
+    std::vector<BvhTriangle> m_triangles;
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_sourceIndex; // leaf order -> Build() order
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Exporters/TextureFormat.h"
+#include "MiniMath/MiniMath.h"
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+// One sub-mesh of one object, in world space.
+struct WorldDrawItem
+{
+    uint32_t objectIndex = 0;
+    uint32_t partIndex = 0;  // CookedMesh::parts index
+    uint32_t materialId = 0;
+    uint32_t textureId = GV_TEXTURE_NONE;
+    uint32_t vertexCount = 0;
+    bool translucent = false;
+
+    Vec3 boundsMin;
+    Vec3 boundsMax;
+};
+
+struct WorldTriangle
+{
+    Vec3 v[3];
+    Vec3 n[3];           // world-space corner normals
+    float uv[3][2] = {}; // texture coordinates
+
+    uint32_t objectIndex = 0;
+    uint32_t partIndex = 0;
+    uint32_t firstVertex = 0; // into the part's triangle list
+    uint32_t materialId = 0;
+    bool translucent = false;
+};
+
+struct WorldSector
+{
+    int cellX = 0;
+    int cellZ = 0;
+
+    Vec3 boundsMin; // union of the item bounds
+    Vec3 boundsMax;
+
+    std::vector<WorldDrawItem> items;
+};
+
+// Buckets draw items into a regular grid on the XZ plane by bounds centre.
+class WorldSectors
+{
+public:
+    explicit WorldSectors(float sectorSize);
+
+    void Add(const WorldDrawItem& item);
+
+    // Sectors in (cellZ, cellX) order; empty cells are not emitted.
+    std::vector<WorldSector>& GetSectors();
+
+    size_t GetItemCount() const;
+
+private:
+    float m_sectorSize;
+    std::map<std::pair<int, int>, size_t> m_cells; // (cellZ, cellX) -> sector
+    std::vector<WorldSector> m_sectors;
+    bool m_sorted = true;
+};
@@ -2,8 +2,11 @@
 
 #include <cstdint>
 #include <fstream>
+#include <string>
 #include <vector>
 
+constexpr uint32_t GV_CHUNK_VERSION = 0x0001;
+
 #pragma pack(push, 1)
 struct GV_ChunkHeader {
     uint32_t type;
@@ -20,6 +23,18 @@ enum GV_ChunkType : uint32_t
     GV_CHUNK_EXTENSION = 0x0003,
     GV_CHUNK_LOGIC_UNIT = 0x0004,
     GV_CHUNK_SCENE_OBJECT = 0x0024,
+    GV_CHUNK_EVENT_TABLE = 0x0025,
+    GV_CHUNK_NAME_HASH = 0x0026,
+    GV_CHUNK_MEMORY_PLAN = 0x0027,
+    GV_CHUNK_PACK_TOC = 0x0028,
+    GV_CHUNK_PVS = 0x0029,
+    GV_CHUNK_LIGHTMAP = 0x002A,
+    GV_CHUNK_CHUNK_STORE = 0x002B,
+    GV_CHUNK_SCENE_REF = 0x002C,
+    GV_CHUNK_PATCH = 0x002D,
+    GV_CHUNK_CHECKSUMS = 0x002E,
+    GV_CHUNK_BUILD_GRAPH = 0x002F,
+    GV_CHUNK_LIGHTMAP_UV = 0x0030, // nested in GV_CHUNK_STATIC_MESH
 
 
     
@@ -82,3 +97,15 @@ enum GV_ChunkType : uint32_t
 
 void WriteChunk(std::ofstream& out, uint32_t type, uint32_t version, const std::vector<char>& data);
 void AppendChunk(std::vector<char>& dest, uint32_t type, uint32_t version, const std::vector<char>& payload);
+
+// Payload helpers. Values are written little-endian, strings are length
+// prefixed and padded to 4 bytes so the runtime can read them in place.
+void AppendU32(std::vector<char>& dest, uint32_t value);
+void AppendF32(std::vector<char>& dest, float value);
+void AppendString(std::vector<char>& dest, const std::string& value);
+
+// Readers for the helpers above. They advance offset and return 0 / empty
+// once the payload is exhausted.
+uint32_t ReadU32(const std::vector<char>& src, size_t& offset);
+float ReadF32(const std::vector<char>& src, size_t& offset);
+std::string ReadString(const std::vector<char>& src, size_t& offset);
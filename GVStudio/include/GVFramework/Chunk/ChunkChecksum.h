@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-chunk integrity data. A GV_CHUNK_CHECKSUMS table is appended after
+// the last top-level chunk of a file and holds a CRC-32C of each top-level
+// chunk (header and payload, so nested chunks are covered by their parent).
+// ChunkReader::EnableChecksums verifies them lazily.
+namespace ChunkChecksum
+{
+    const uint32_t ALGORITHM_CRC32C = 1;
+
+    // Payload for a table covering the top-level chunks in data.
+    std::vector<char> BuildTable(const char* data, size_t size);
+
+    // Appends a table to an already written chunk file.
+    bool AppendToFile(const std::string& path);
+
+    // Times reading a synthetic chunk file against verifying it.
+    void RunBenchmark(size_t megabytes);
+}
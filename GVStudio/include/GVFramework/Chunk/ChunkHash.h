@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// xxHash64 (scalar, four independent lanes). Used to address chunks by
+// content.
+uint64_t XXHash64(const void* data, size_t size, uint64_t seed = 0);
+
+// CRC-32C (Castagnoli). Uses the SSE4.2 crc32 instruction when the CPU has
+// it and slice-by-8 tables otherwise; both give the same value, which is
+// what the PSP runtime computes with the tables.
+uint32_t Crc32C(const void* data, size_t size, uint32_t crc = 0);
+uint32_t Crc32CSlice8(const void* data, size_t size, uint32_t crc = 0);
+bool HasHardwareCrc32C();
+
+// Incremental xxHash64 for data that arrives in pieces, e.g. a file
+// streamed through a fixed buffer. Digest() matches XXHash64 of the
+// concatenated input.
+class XXHash64Stream
+{
+public:
+    explicit XXHash64Stream(uint64_t seed = 0);
+
+    void Update(const void* data, size_t size);
+    uint64_t Digest() const;
+
+private:
+    uint64_t m_seed;
+    uint64_t m_v[4];
+    unsigned char m_buffer[32];
+    size_t m_buffered = 0;
+    uint64_t m_total = 0;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A chunk inside a buffer: the header fields plus where its payload sits.
+struct GV_ChunkView
+{
+    uint32_t type = 0;
+    uint32_t size = 0;    // payload bytes
+    uint32_t version = 0;
+    size_t start = 0;     // header offset in the buffer
+    size_t payload = 0;   // payload offset in the buffer
+
+    size_t GetEnd() const { return payload + size; }
+};
+
+// Walks the chunks of one nesting level without copying.
+class ChunkReader
+{
+public:
+    ChunkReader(const char* data, size_t size, size_t begin = 0, size_t end = static_cast<size_t>(-1));
+    explicit ChunkReader(const std::vector<char>& data);
+
+    // False at the end of the level or on a truncated header/payload; use
+    // IsValid() to tell the two apart.
+    bool Next(GV_ChunkView& out);
+    bool IsValid() const;
+
+    // Reader over the chunks nested in a chunk's payload.
+    ChunkReader Children(const GV_ChunkView& chunk, size_t skip = 0) const;
+
+    const char* GetData() const;
+
+    // Loads the file's GV_CHUNK_CHECKSUMS table. From then on, the first
+    // time Next() steps onto a top-level chunk or anything nested in it,
+    // that chunk is checked; a mismatch ends the walk with IsCorrupt() set.
+    // Readers from Children() share the table and what was verified.
+    // Returns false if the file has no table.
+    bool EnableChecksums();
+    bool IsCorrupt() const;
+    uint32_t GetVerifiedCount() const;
+
+    static bool ReadFile(const std::string& path, std::vector<char>& out);
+
+private:
+    struct ChecksumState
+    {
+        std::vector<uint32_t> offsets; // ascending
+        std::vector<uint32_t> sizes;
+        std::vector<uint32_t> crcs;
+        std::vector<uint8_t> status;   // 0 unchecked, 1 good, 2 corrupt
+        uint32_t verified = 0;
+        bool corrupt = false;
+    };
+
+    bool Verify(const GV_ChunkView& chunk);
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    size_t m_end;
+    bool m_valid = true;
+    std::shared_ptr<ChecksumState> m_checksums;
+};
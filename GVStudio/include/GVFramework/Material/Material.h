@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+struct GV_Material // material gotten from an MTL file
+{
+	std::string name;
+
+	float diffuse[3] = { 1.0f, 1.0f, 1.0f }; // Kd
+	float alpha = 1.0f;                      // d
+	int illum = 0;
+
+	std::string texturePath; // map_Kd, resolved against the MTL folder
+
+	bool IsTranslucent() const { return alpha < 1.0f; }
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "GVFramework/Material/Material.h"
+
+class MaterialParser
+{
+public:
+    static std::vector<GV_Material> ParseFile(const std::string& filename);
+};
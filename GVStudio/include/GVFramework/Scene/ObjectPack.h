@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Platform/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Every object of a scene in one file instead of one .gObject per object.
+// A record holds the XML the .gObject file would; the index at the end of
+// the file maps object names to records.
+//
+// Records are never rewritten in place. Write() queues a new record and
+// Commit() appends it, appends a new index and only then points the header
+// at that index, so a save that stops halfway still leaves the old index
+// and records readable. The replaced records and indices are dead space;
+// once it outgrows the live records Commit() rewrites the pack compacted.
+class ObjectPack
+{
+public:
+    static constexpr uint32_t MAGIC = 0x504F5647; // "GVOP"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint64_t COMPACT_MIN_BYTES = 1024 * 1024;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t indexOffset;
+        uint64_t indexBytes;
+        uint64_t indexHash; // xxHash64 of the index
+        uint64_t deadBytes; // bytes before the index nothing points at
+    };
+#pragma pack(pop)
+
+    ObjectPack() = default;
+    ObjectPack(const ObjectPack&) = delete;
+    ObjectPack& operator=(const ObjectPack&) = delete;
+
+    // Maps the pack and reads its index. A missing file opens as an empty
+    // pack that Commit() creates; a damaged one fails.
+    bool Open(const std::string& path);
+    void Close();
+
+    // Record of name, or empty. Valid until Commit(), Compact() or Close().
+    std::string_view Find(const std::string& name) const;
+
+    // Queues a record for name. A stored record with the same bytes is
+    // kept as it is, so only changed objects reach the file.
+    void Write(const std::string& name, std::string_view record);
+    void Remove(const std::string& name);
+    std::vector<std::string> GetNames() const;
+
+    // Appends queued records and a new index, or compacts if dead space
+    // has outgrown the live records.
+    bool Commit();
+
+    // Writes the live records and an index to a new file that replaces
+    // this one.
+    bool Compact();
+
+    size_t GetCount() const;
+    uint64_t GetLiveBytes() const;
+    uint64_t GetDeadBytes() const;
+    uint32_t GetAppendedCount() const; // records the last Commit() wrote
+
+private:
+    struct Entry
+    {
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        uint64_t hash = 0;
+        int32_t pending = -1; // index into m_pending until committed
+    };
+
+    bool ReadIndex();
+    std::string_view GetRecord(const Entry& entry) const;
+    static void BuildIndex(const std::unordered_map<std::string, Entry>& entries, std::vector<char>& out);
+
+private:
+    std::string m_path;
+    MappedFile m_file;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::vector<std::string> m_pending;
+
+    uint64_t m_end = 0;       // file size, where the next record goes
+    uint64_t m_indexBytes = 0;
+    uint64_t m_liveBytes = 0;
+    uint64_t m_deadBytes = 0;
+    uint32_t m_appended = 0;
+    bool m_dirty = false;
+};
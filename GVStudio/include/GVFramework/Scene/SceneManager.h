@@ -2,11 +2,13 @@
 
 #include <string>
 #include <memory>
+#include <unordered_set>
 
 #include "GVFramework/Scene/SceneObject.h"
 #include "Database/LogicUnitRegistry.h"
 
 struct GV_State;
+class ObjectPack;
 
 struct SceneFolder
 {
@@ -17,6 +19,16 @@ struct SceneFolder
     std::vector<std::unique_ptr<SceneObject>> objects;
 };
 
+// Where a scene keeps its objects. Files writes Objects/<name>.gObject per
+// object; Packed writes every object into <scene>.gObjectPack, rewriting
+// only the ones that changed. Loading reads the pack whenever the scene has
+// one, whatever the setting, and saving with Files removes it.
+enum class ObjectStorage
+{
+    Files,
+    Packed
+};
+
 class SceneManager
 {
 public:
@@ -27,18 +39,33 @@ public:
 
     std::string GetCurrentSceneDirectory(const GV_State& state) const;
 
+    LogicUnitRegistry& GetRegistry() const;
+
     bool LoadScene(const std::string& sceneDir);
     bool SaveScene(const std::string& sceneDir) const;
 
+    void SetObjectStorage(ObjectStorage storage);
+    ObjectStorage GetObjectStorage() const;
+
+    static std::string GetObjectPackPath(const std::string& sceneDir);
+
     SceneObject* CreateObjectFromLogicUnit(
         const std::string& typeName,
         SceneFolder* targetFolder);
 
+    // Saves and loads a synthetic scene with both storage modes.
+    static void RunStorageBenchmark(uint32_t objectCount);
+
 private:
-    void LoadAllObjects(SceneFolder& folder, const std::string& objectsDir);
+    void LoadAllObjects(SceneFolder& folder, const std::string& objectsDir, const ObjectPack* pack);
     void SaveAllObjects(const SceneFolder& folder, const std::string& objectsDir) const;
+    void PackAllObjects(const SceneFolder& folder, ObjectPack& pack,
+        std::unordered_set<std::string>& names, std::string& record) const;
+    static void RemoveObjectFiles(const std::string& objectsDir,
+        const std::unordered_set<std::string>& names);
 
 private:
     SceneFolder m_root;
     LogicUnitRegistry& m_registry;
+    ObjectStorage m_storage = ObjectStorage::Files;
 };
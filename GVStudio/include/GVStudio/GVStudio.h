@@ -7,7 +7,6 @@
 //  Clean up unused member variables
 //  StateGraph 
 //  SceneViewer
-//  Exporter templates
 //  
 //  
 //  
@@ -70,11 +69,13 @@ struct GV_Project_Info
     std::string dataFolder;
     std::string resourceFolder;
     std::string sourceFolder;
+    std::string cacheFolder; // parsed XML cache, off when empty, "*" for sidecars
 
     int projectVersion = 1;
 
     std::vector<GV_Scene_Info> scenes;
     std::string startupScene;
+    bool packObjects = false; // scene objects in one .gObjectPack each
 };
 
 
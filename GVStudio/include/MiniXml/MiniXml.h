@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct XmlAttribute
@@ -23,4 +24,4 @@ bool XmlLoadFromFile(const std::string& path, XmlNode& outRoot);
 bool XmlSaveToFile(const std::string& path, const XmlNode& root);
 
 std::string XmlToString(const XmlNode& root, int indentSpaces = 2);
-bool XmlParseString(const std::string& text, XmlNode& outRoot);
+bool XmlParseString(std::string_view text, XmlNode& outRoot);
@@ -3,6 +3,7 @@
 #include "Database/LogicUnitRegistry.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 class SceneObject;
@@ -20,4 +21,14 @@ namespace ObjectXml
         const std::string& xmlPath,
         LogicUnitRegistry& registry);
 
+    // The same .gObject XML, held in memory (e.g. a record of an ObjectPack).
+    bool LoadObjectFromText(
+        SceneObject& obj,
+        std::string_view text,
+        LogicUnitRegistry& registry);
+
+    bool SaveObjectToText(
+        const SceneObject& obj,
+        std::string& text,
+        LogicUnitRegistry& registry);
 }
@@ -5,6 +5,8 @@ struct SceneFolder;
 
 namespace SceneXml
 {
+    // Scenes of XmlDocument::PARALLEL_MIN_BYTES or more parse on every
+    // hardware thread unless XmlCache is on; the cache replay is faster.
     bool LoadGScene(const std::string& path, SceneFolder& rootFolder);
     bool SaveGScene(const std::string& path, const SceneFolder& rootFolder);
 }
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Element and attribute names as small integers, so matching a name is an
+// integer compare. 0 is never a valid atom.
+using XmlAtom = uint32_t;
+
+// Names the GVStudio schemas use. Every XmlAtomTable starts with these in
+// this order, so the values are the same in every table.
+enum : XmlAtom
+{
+    ATOM_NONE = 0,
+
+    // Elements
+    ATOM_SCENE,
+    ATOM_FOLDER,
+    ATOM_OBJECT,
+    ATOM_LOGIC_UNIT,
+    ATOM_PARAM,
+    ATOM_PROJECT,
+    ATOM_NAME,
+    ATOM_PATHS,
+    ATOM_DATA_FOLDER,
+    ATOM_RESOURCE_FOLDER,
+    ATOM_SOURCE_FOLDER,
+    ATOM_CACHE_FOLDER,
+    ATOM_SCENES,
+    ATOM_STARTUP_SCENE,
+    ATOM_OBJECT_STORAGE,
+
+    // Attributes
+    ATOM_ATTR_NAME,
+    ATOM_ATTR_ASSET,
+    ATOM_ATTR_VALUE,
+    ATOM_ATTR_PATH,
+    ATOM_ATTR_VERSION,
+
+    ATOM_SCHEMA_COUNT
+};
+
+// Atom of a schema name, or ATOM_NONE if it is not one.
+XmlAtom XmlFindSchemaAtom(std::string_view name);
+
+// Per-document intern table: every distinct name gets the next atom.
+class XmlAtomTable
+{
+public:
+    XmlAtomTable();
+    XmlAtomTable(const XmlAtomTable&) = delete;
+    XmlAtomTable& operator=(const XmlAtomTable&) = delete;
+
+    XmlAtom Intern(std::string_view name);
+    XmlAtom Find(std::string_view name) const; // ATOM_NONE if never interned
+    std::string_view GetName(XmlAtom atom) const;
+    size_t GetCount() const;
+
+    // Back to the schema atoms only.
+    void Reset();
+
+private:
+    struct Slot
+    {
+        uint32_t hash = 0;
+        XmlAtom atom = ATOM_NONE;
+    };
+
+    size_t FindSlot(std::string_view name, uint32_t hash) const;
+    void Grow();
+
+private:
+    std::vector<std::string_view> m_names; // indexed by atom, [0] unused
+    std::vector<Slot> m_slots;             // open addressing, power of two
+    std::deque<std::string> m_storage;     // names that are not schema literals
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "MiniXml/XmlPullParser.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile;
+
+// Binary cache of parsed XML. A cache file holds the events XmlPullParser
+// produced for a source file, so a later open replays them without
+// tokenizing. Each cache records the size, write time and xxHash64 of its
+// source, like BuildStamp: size and time matching is enough, and a
+// touched but unchanged file is accepted after rehashing. The records are
+// hashed too, so a damaged cache is rebuilt instead of failing the load.
+//
+// Off by default. Sidecar puts "<file>.gCache" next to the source,
+// Directory keeps every cache in one folder. A project picks Sidecar with
+// <CacheFolder>*</CacheFolder> and Directory with any other folder.
+namespace XmlCache
+{
+    enum class Mode
+    {
+        Off,
+        Sidecar,
+        Directory
+    };
+
+    constexpr const char* SIDECAR_FOLDER = "*"; // not a valid folder name
+
+    constexpr uint32_t MAGIC = 0x43585647; // "GVXC"
+    constexpr uint32_t VERSION = 1;
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t sourceHash;
+        uint64_t eventBytes; // everything after the header
+        uint64_t eventHash;  // xxHash64 of those bytes
+    };
+#pragma pack(pop)
+
+    // One replayed event. Views point into the cache.
+    struct Record
+    {
+        XmlEvent event = XmlEvent::EndDocument;
+        std::string_view name;
+        std::string_view value;
+    };
+
+    void SetMode(Mode mode, const std::string& directory = {});
+    Mode GetMode();
+    std::string GetDirectory(); // "" unless the mode is Directory
+
+    // Replaces the mode for the calling thread only while it is alive, so
+    // a benchmark can switch caching without touching an export that runs
+    // on another thread. Scopes nest.
+    class ScopedMode
+    {
+    public:
+        ScopedMode(Mode mode, const std::string& directory = {});
+        ~ScopedMode();
+
+        ScopedMode(const ScopedMode&) = delete;
+        ScopedMode& operator=(const ScopedMode&) = delete;
+
+    private:
+        friend struct ModeAccess;
+
+        const ScopedMode* m_outer = nullptr;
+        Mode m_mode = Mode::Off;
+        std::string m_directory;
+    };
+
+    // Where the cache of sourcePath lives, or "" when caching is off.
+    std::string GetCachePath(const std::string& sourcePath);
+
+    // Maps the cache of sourcePath, building or refreshing it first if it
+    // is missing or stale. On success events is the record stream inside
+    // cache. False when caching is off or the source does not parse.
+    bool Open(const std::string& sourcePath, MappedFile& cache, std::string_view& events);
+
+    // Encodes every event of the document; false if it does not parse.
+    bool Encode(std::string_view text, std::vector<char>& out);
+
+    // Decodes the record at pos and advances past it. False when the
+    // stream is truncated or malformed.
+    bool ReadRecord(std::string_view events, size_t& pos, Record& out);
+
+    // Loads a synthetic .gScene by tokenizing, by building its cache and
+    // by replaying the cache.
+    void RunBenchmark(uint32_t objectCount);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "MiniXml/XmlAtom.h"
+#include "Platform/MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for XmlDocument nodes. Nothing is freed on its own; every
+// block goes away with the arena.
+class XmlArena
+{
+public:
+    explicit XmlArena(size_t blockSize = 64 * 1024);
+
+    void* Allocate(size_t size, size_t align);
+
+    // Only for trivially destructible types, no destructor ever runs.
+    template <typename T>
+    T* New()
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T();
+    }
+
+    void Reset();
+
+    // Takes over other's blocks, leaving it empty. Used to keep nodes
+    // parsed into a worker's arena alive with the document.
+    void Absorb(XmlArena& other);
+
+    size_t GetUsedBytes() const;
+    uint32_t GetBlockCount() const;
+
+private:
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    size_t m_blockSize;
+    size_t m_blockUsed = 0;
+    size_t m_usedBytes = 0;
+};
+
+struct XmlViewAttribute
+{
+    std::string_view name;
+    std::string_view value;
+    XmlAtom atom = ATOM_NONE; // name in the document's atom table
+    const XmlViewAttribute* next = nullptr;
+};
+
+// Read-only counterpart of XmlNode: names, text and values are views into
+// the document's buffer, children and attributes are intrusive lists.
+struct XmlViewNode
+{
+    std::string_view name;
+    std::string_view text;
+    XmlAtom atom = ATOM_NONE;
+    const XmlViewAttribute* firstAttribute = nullptr;
+    const XmlViewNode* firstChild = nullptr;
+    const XmlViewNode* nextSibling = nullptr;
+
+    const XmlViewAttribute* FindAttribute(std::string_view attrName) const;
+    std::string_view GetAttribute(std::string_view attrName, std::string_view fallback = {}) const;
+
+    // First child with this name, or the sibling after it with NextNamed().
+    const XmlViewNode* FindChild(std::string_view childName) const;
+    const XmlViewNode* NextNamed(std::string_view siblingName) const;
+
+    // The same by atom: integer compares only. Schema names can use their
+    // ATOM_ value, other names XmlDocument::GetAtoms().Find().
+    const XmlViewAttribute* FindAttribute(XmlAtom attrAtom) const;
+    std::string_view GetAttribute(XmlAtom attrAtom, std::string_view fallback = {}) const;
+    const XmlViewNode* FindChild(XmlAtom childAtom) const;
+    const XmlViewNode* NextNamed(XmlAtom siblingAtom) const;
+};
+
+// Parses the same XML subset as XmlParseString without a per-token
+// allocation: the document owns the text (or the mapped file) and every
+// node lives in its arena.
+//
+// Large documents are split into byte ranges at element starts and the
+// ranges parse on worker threads; the pieces are then joined in order.
+// A split that turns out to sit inside a comment or a quoted value, or any
+// parse error, falls back to one thread, so the tree (and the atom
+// numbering) is always the one a serial parse gives.
+class XmlDocument
+{
+public:
+    // Smaller documents always parse on the calling thread.
+    static constexpr size_t PARALLEL_MIN_BYTES = 4 * 1024 * 1024;
+
+    XmlDocument() = default;
+    XmlDocument(const XmlDocument&) = delete;
+    XmlDocument& operator=(const XmlDocument&) = delete;
+
+    bool LoadFromFile(const std::string& path);
+    bool Parse(std::string text);
+
+    // Threads a parse may use; 0 (the default) is one per hardware thread.
+    void SetThreadCount(uint32_t threads);
+
+    const XmlViewNode* GetRoot() const;
+    const XmlArena& GetArena() const;
+    const XmlAtomTable& GetAtoms() const;
+
+    // Ranges the last parse was split into, 1 when it ran serially.
+    uint32_t GetRangeCount() const;
+
+    // Parses a synthetic .gScene with XmlParseString and with XmlDocument,
+    // counting the heap allocations each makes while parsing.
+    static void RunBenchmark(uint32_t objectCount);
+
+    // MB/s of XmlParseString, XmlDocument and XmlPullParser on a synthetic
+    // scene of about this size, at every XmlScan level the CPU supports.
+    static void RunThroughputBenchmark(size_t megabytes);
+
+    // Parses a synthetic scene of about this size serially and with 1, 2,
+    // 4, ... threads, and checks every tree against the serial one.
+    static void RunParallelBenchmark(size_t megabytes);
+
+private:
+    bool ParseText(std::string_view text);
+
+private:
+    std::string m_buffer;
+    MappedFile m_file;
+    XmlArena m_arena;
+    XmlAtomTable m_atoms;
+    const XmlViewNode* m_root = nullptr;
+    uint32_t m_threads = 0;
+    uint32_t m_ranges = 0;
+};
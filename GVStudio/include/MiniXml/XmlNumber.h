@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Number text for scene and project files. Formatting gives the shortest
+// digits that read back to the same bits; parsing ignores the C locale.
+// Neither allocates.
+namespace XmlNumber
+{
+    constexpr size_t MAX_CHARS = 32; // enough for any float or int
+
+    // Writes into buffer (MAX_CHARS bytes) and returns the text in it.
+    std::string_view Format(float value, char* buffer);
+    std::string_view Format(int value, char* buffer);
+
+    // Reads a leading number like strtof/strtol: leading whitespace and a
+    // '+' are skipped and trailing text is ignored. fallback when there is
+    // no number.
+    float ParseFloat(std::string_view text, float fallback = 0.0f);
+    int ParseInt(std::string_view text, int fallback = 0);
+
+    // Formats and parses count floats with std::to_string/strtof and with
+    // XmlNumber, and counts values that do not survive the round trip.
+    void RunBenchmark(uint32_t count);
+}
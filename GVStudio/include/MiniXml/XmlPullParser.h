@@ -0,0 +1,101 @@
+#pragma once
+
+#include "MiniXml/XmlAtom.h"
+#include "Platform/MappedFile.h"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class XmlEvent
+{
+    StartElement, // GetName() is the element
+    Attribute,    // GetName() = GetValue(), follows its StartElement
+    Text,         // GetValue() is trimmed, never empty
+    EndElement,   // also sent for <Empty/>
+    EndDocument,
+    Error
+};
+
+// Pull-style reader for the XML subset MiniXml handles. Nothing is built:
+// each Next() returns one event, and the views it exposes stay valid until
+// the following Next(). A file with a valid XmlCache is replayed from it;
+// otherwise the file is memory-mapped when possible, or read through a
+// fixed window that only grows if one token is larger than it, so memory
+// does not depend on the document size.
+class XmlPullParser
+{
+public:
+    explicit XmlPullParser(size_t windowSize = 16 * 1024);
+
+    bool Open(const std::string& path);
+    void SetBuffer(std::string_view text); // the text must outlive the parser
+
+    XmlEvent Next();
+
+    // Skips the rest of the element whose StartElement was just returned,
+    // including its attributes, up to and including its EndElement.
+    bool Skip();
+
+    std::string_view GetName() const;
+    std::string_view GetValue() const;
+
+    // GetName() interned in GetAtoms(); schema names are their ATOM_ value.
+    XmlAtom GetAtom() const;
+    const XmlAtomTable& GetAtoms() const;
+
+    // Open elements: a StartElement and its Attributes count their own
+    // element, an EndElement no longer does. Text in the root is at 1.
+    size_t GetDepth() const;
+
+    const std::string& GetError() const;
+
+private:
+    void Reset();
+    XmlEvent Fail(const std::string& error);
+
+    // Window helpers: offsets are from the start of the window and only
+    // stay valid until the next Compact().
+    void Compact();
+    bool Fill();
+    bool Available(size_t count);
+    size_t Find(std::string_view literal, size_t from);
+    bool SkipPast(std::string_view literal);
+    void SkipWhitespace();
+    bool StartsWith(std::string_view literal);
+    size_t ReadName();
+
+    XmlEvent ReadContent();
+    XmlEvent ReadAttribute();
+    XmlEvent ReadCached();
+
+private:
+    MappedFile m_mapping;
+    std::ifstream m_file;
+    bool m_streaming = false;
+    bool m_eof = true;
+
+    std::vector<char> m_window;
+    size_t m_windowSize;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_pos = 0;
+
+    bool m_cached = false;      // m_data is XmlCache records, not text
+    bool m_inTag = false;       // between an element name and its '>'
+    bool m_sawRoot = false;
+    XmlAtomTable m_atoms;
+    std::vector<XmlAtom> m_open; // open elements, m_depth of them are live
+    size_t m_depth = 0;
+    bool m_nameIsEnd = false;    // GetName() is m_open[m_depth]
+    XmlAtom m_atom = ATOM_NONE;  // current StartElement or Attribute
+
+    size_t m_nameBegin = 0;
+    size_t m_nameEnd = 0;
+    size_t m_valueBegin = 0;
+    size_t m_valueEnd = 0;
+
+    std::string m_error;
+};
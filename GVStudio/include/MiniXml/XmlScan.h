@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Byte scanning shared by the MiniXml parsers. Character classes come from
+// a table (ASCII rules, no locale); searches use AVX2 or SSE2 when the CPU
+// has them and a plain loop otherwise. All levels give the same results.
+namespace XmlScan
+{
+    enum CharClass : uint8_t
+    {
+        CLASS_SPACE = 1, // ' ', \t, \n, \v, \f, \r
+        CLASS_NAME = 2   // letters, digits, '_', '-', ':'
+    };
+
+    extern const uint8_t kCharClass[256];
+
+    inline bool IsSpace(char c)
+    {
+        return (kCharClass[static_cast<unsigned char>(c)] & CLASS_SPACE) != 0;
+    }
+
+    inline bool IsNameChar(char c)
+    {
+        return (kCharClass[static_cast<unsigned char>(c)] & CLASS_NAME) != 0;
+    }
+
+    enum class Level
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    // The best level the CPU supports unless SetLevel() lowered it.
+    Level GetLevel();
+    Level GetBestLevel();
+    void SetLevel(Level level); // clamped to GetBestLevel()
+    const char* GetLevelName(Level level);
+
+    // Offset of the first byte equal to c, or size if there is none.
+    size_t FindChar(const char* data, size_t size, char c);
+
+    // Offset of the first byte equal to a or b, or size.
+    size_t FindEither(const char* data, size_t size, char a, char b);
+
+    // Offset of the first non-whitespace byte, or size.
+    size_t SkipSpace(const char* data, size_t size);
+
+    // Names are short, so this stays a table loop.
+    inline size_t SkipName(const char* data, size_t size)
+    {
+        size_t i = 0;
+        while (i < size && IsNameChar(data[i]))
+            ++i;
+        return i;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct XmlNode;
+
+// Streams XML to a file through a fixed buffer, in exactly the layout
+// XmlToString produces. Elements are written as they are opened, so no
+// XmlNode tree is needed; after the first few elements nothing allocates.
+// Like the rest of MiniXml, names, values and text are written unescaped.
+class XmlWriter
+{
+public:
+    explicit XmlWriter(size_t bufferSize = 64 * 1024, int indentSpaces = 2);
+    ~XmlWriter();
+
+    XmlWriter(const XmlWriter&) = delete;
+    XmlWriter& operator=(const XmlWriter&) = delete;
+
+    bool Open(const std::string& path);
+
+    // Appends to out instead of writing a file, until Close().
+    void OpenString(std::string& out);
+
+    // Flushes and closes; false if any write failed or elements are open.
+    bool Close();
+
+    void StartElement(std::string_view name);
+    void Attribute(std::string_view name, std::string_view value);
+    void Attribute(std::string_view name, int value);
+    void Attribute(std::string_view name, float value); // shortest text that reads back exactly
+    void Text(std::string_view text);
+    void EndElement();
+
+    // Writes an existing tree, for callers that already have one.
+    void WriteNode(const XmlNode& node);
+
+    uint64_t GetBytesWritten() const;
+
+    // Writes a synthetic 100k-object style .gScene with the DOM and with
+    // the writer and compares time and heap allocations (counted only in
+    // GV_HEAP_COUNTER builds, see HeapCounter).
+    static void RunBenchmark(uint32_t objectCount);
+
+private:
+    void Put(std::string_view text);
+    void Put(char c);
+    void PutIndent(size_t depth);
+    void Restart();
+    void Flush();
+    void Write(const char* data, size_t size);
+
+    // Ends a start tag that is still open because the element might have
+    // turned out empty.
+    void OpenContent();
+
+private:
+    std::ofstream m_file;
+    std::string* m_string = nullptr;
+    std::vector<char> m_buffer;
+    size_t m_used = 0;
+    uint64_t m_written = 0;
+    bool m_failed = false;
+
+    int m_indentSpaces;
+    std::string m_indent; // spaces, grown when a deeper level is written
+
+    std::vector<std::string> m_open; // reused slots, m_depth of them are live
+    size_t m_depth = 0;
+    bool m_tagOpen = false;     // "<name attrs" written, '>' not yet
+    std::string m_pendingText;  // text of the open element, placed once its layout is known
+    bool m_hasPendingText = false;
+};
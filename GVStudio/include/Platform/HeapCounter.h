@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts the heap allocations the calling thread makes while it is alive.
+// Counting replaces the global operator new and delete, so it is only
+// compiled into benchmark builds that define GV_HEAP_COUNTER; elsewhere
+// counters stay at zero and IsEnabled() is false. Counters nest, each sees
+// everything made inside it.
+class HeapCounter
+{
+public:
+    HeapCounter();
+    ~HeapCounter();
+
+    HeapCounter(const HeapCounter&) = delete;
+    HeapCounter& operator=(const HeapCounter&) = delete;
+
+    uint64_t GetAllocations() const;
+    uint64_t GetBytes() const;
+
+    // False unless built with GV_HEAP_COUNTER.
+    static bool IsEnabled();
+
+    // Called by the replaced operator new.
+    static void OnAllocation(size_t size);
+
+private:
+    HeapCounter* m_outer = nullptr;
+    uint64_t m_allocations = 0;
+    uint64_t m_bytes = 0;
+};
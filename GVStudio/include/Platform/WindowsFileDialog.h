@@ -5,5 +5,5 @@
 namespace WindowsFileDialog
 {
     std::string OpenProjectFile();
-    std::string SelectFolder();
+    std::string SelectFolder(const wchar_t* title = nullptr);
 }
@@ -22,12 +22,12 @@ public:
         const std::string& resourceRoot,
         std::vector<RenderItem>& outItems);
 
+    static Mat4 BuildModelFromLogicUnit(GV_Logic_Unit_Instance* inst,
+        const std::string& resourceRoot,
+        std::string& outModelPath);
+
 private:
     static void CollectFolder(SceneFolder& folder,
         const std::string& resourceRoot,
         std::vector<RenderItem>& outItems);
-
-    static Mat4 BuildModelFromLogicUnit(GV_Logic_Unit_Instance* inst,
-        const std::string& resourceRoot,
-        std::string& outModelPath);
 };
\ No newline at end of file
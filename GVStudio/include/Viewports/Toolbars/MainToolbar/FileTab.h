@@ -1,10 +1,47 @@
 #pragma once
 
+#include "Exporters/ProjectExporter.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
 struct GV_State;
 class SceneManager;
 
 class FileTab
 {
 public:
+    ~FileTab();
+
     void Draw(GV_State& state, SceneManager& sceneManager);
-};
\ No newline at end of file
+
+    // Window of a running export or build: lightmap preview and Cancel.
+    void DrawExportStatus();
+
+private:
+    enum class ExportJob
+    {
+        Export,
+        Build,  // incremental, through BuildGraph
+        Rebuild
+    };
+
+    bool IsExporting() const;
+    void StartExport(const GV_State& state, SceneManager& sceneManager, ExportSettings settings,
+        ExportJob job = ExportJob::Export);
+    void FinishExport();
+    void UploadPreview();
+
+private:
+    std::thread m_exportThread;
+    std::unique_ptr<ExportControl> m_exportControl;
+    std::atomic<bool> m_exportDone{ false };
+    ExportJob m_exportJob = ExportJob::Export;
+    bool m_exportOk = false; // set by the export thread before m_exportDone
+
+    LightmapPreview m_preview;
+    uint32_t m_previewVersion = 0;
+    int m_previewPage = 0;
+    unsigned int m_previewTexture = 0;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Viewports/Toolbars/MainToolbar/FileTab.h"
+#include "Viewports/Toolbars/MainToolbar/ToolsTab.h"
 
 struct GV_State;
 class SceneManager;
@@ -12,4 +13,5 @@ public:
 
 private:
     FileTab m_fileTab;
+    ToolsTab m_toolsTab;
 };
\ No newline at end of file
@@ -0,0 +1,7 @@
+#pragma once
+
+class ToolsTab
+{
+public:
+    void Draw();
+};
@@ -13,6 +13,11 @@ void AssetDatabase::Clear()
     m_assets.clear();
 }
 
+void AssetDatabase::SetResourceRoot(const std::string& resourceRoot)
+{
+    m_resourceRoot = resourceRoot;
+}
+
 void AssetDatabase::RegisterExtractors()
 {
     // TEXTURE
@@ -103,23 +108,27 @@ int AssetDatabase::FindParamIndex(
     return -1;
 }
 
-void AssetDatabase::ProcessLogicUnitInstance(
-    const GV_Logic_Unit_Instance& instance)
+std::vector<std::string> AssetDatabase::ExtractPaths(
+    const GV_Logic_Unit_Instance& instance) const
 {
-    if (!instance.def)
-        return;
+    std::vector<std::string> paths;
 
-    GV_ChunkType type = instance.def->chunkType;
+    if (!instance.def)
+        return paths;
 
-    auto it = m_extractors.find(type);
+    auto it = m_extractors.find(instance.def->chunkType);
     if (it == m_extractors.end())
-        return;
+        return paths;
 
-    std::vector<std::string> paths;
     it->second(instance, paths);
+    return paths;
+}
 
-    for (const auto& p : paths)
-        AddAsset(type, p);
+void AssetDatabase::ProcessLogicUnitInstance(
+    const GV_Logic_Unit_Instance& instance)
+{
+    for (const auto& p : ExtractPaths(instance))
+        AddAsset(instance.def->chunkType, p);
 }
 
 void AssetDatabase::AddAsset(
@@ -156,7 +165,11 @@ void AssetDatabase::ParseDependencies(AssetEntry& entry)
     if (entry.type != GV_CHUNK_STATIC_MESH)
         return;
 
-    std::ifstream file(entry.path);
+    std::filesystem::path modelPath(entry.path);
+    if (!m_resourceRoot.empty())
+        modelPath = std::filesystem::path(m_resourceRoot) / entry.path;
+
+    std::ifstream file(modelPath);
     if (!file.is_open())
         return;
 
@@ -168,7 +181,6 @@ void AssetDatabase::ParseDependencies(AssetEntry& entry)
         {
             std::string mtlFile = line.substr(7);
 
-            std::filesystem::path modelPath(entry.path);
             std::filesystem::path mtlPath =
                 modelPath.parent_path() / mtlFile;
 
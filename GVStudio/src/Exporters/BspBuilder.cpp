@@ -0,0 +1,471 @@
+#include "Exporters/BspBuilder.h"
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    constexpr float kPlaneEpsilon = 1e-4f;
+
+    float Axis(const Vec3& v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    BspVertex Lerp(const BspVertex& a, const BspVertex& b, float t)
+    {
+        BspVertex out;
+        out.position = a.position + (b.position - a.position) * t;
+        out.normal = Normalize(a.normal + (b.normal - a.normal) * t);
+        out.u = a.u + (b.u - a.u) * t;
+        out.v = a.v + (b.v - a.v) * t;
+        return out;
+    }
+
+    void TriangleRange(const BspTriangle& tri, int axis, float& outMin, float& outMax)
+    {
+        outMin = std::min({ Axis(tri.v[0].position, axis), Axis(tri.v[1].position, axis), Axis(tri.v[2].position, axis) });
+        outMax = std::max({ Axis(tri.v[0].position, axis), Axis(tri.v[1].position, axis), Axis(tri.v[2].position, axis) });
+    }
+
+    // Sutherland-Hodgman against one side of the plane, then fan back into
+    // triangles. keepBack selects the side with coordinate <= position.
+    void ClipToSide(const BspTriangle& tri, int axis, float position, bool keepBack,
+        std::vector<BspTriangle>& out)
+    {
+        BspVertex poly[4];
+        int count = 0;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const BspVertex& a = tri.v[i];
+            const BspVertex& b = tri.v[(i + 1) % 3];
+
+            float da = Axis(a.position, axis) - position;
+            float db = Axis(b.position, axis) - position;
+            if (!keepBack)
+            {
+                da = -da;
+                db = -db;
+            }
+
+            if (da <= 0.0f)
+                poly[count++] = a;
+
+            if ((da < 0.0f && db > 0.0f) || (da > 0.0f && db < 0.0f))
+                poly[count++] = Lerp(a, b, da / (da - db));
+        }
+
+        for (int i = 1; i + 1 < count; ++i)
+        {
+            BspTriangle piece;
+            piece.v[0] = poly[0];
+            piece.v[1] = poly[i];
+            piece.v[2] = poly[i + 1];
+            piece.materialId = tri.materialId;
+
+            Vec3 area = Cross(piece.v[1].position - piece.v[0].position, piece.v[2].position - piece.v[0].position);
+            if (Dot(area, area) > 1e-12f)
+                out.push_back(piece);
+        }
+    }
+
+    void AppendVec3(std::vector<char>& out, const Vec3& v)
+    {
+        AppendF32(out, v.x);
+        AppendF32(out, v.y);
+        AppendF32(out, v.z);
+    }
+}
+
+void BspBuilder::Build(const std::vector<WorldTriangle>& triangles, const BspSettings& settings)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_settings = settings;
+    m_nodes.clear();
+    m_leafCount = 0;
+    m_maxDepth = 0;
+    m_overBudget = 0;
+    m_looseSplits = 0;
+    m_outputTriangles = 0;
+    m_inputTriangles = static_cast<uint32_t>(triangles.size());
+
+    std::vector<BspTriangle> input;
+    input.reserve(triangles.size());
+
+    for (const WorldTriangle& source : triangles)
+    {
+        BspTriangle tri;
+        tri.materialId = source.materialId;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            tri.v[k].position = source.v[k];
+            tri.v[k].normal = source.n[k];
+            tri.v[k].u = source.uv[k][0];
+            tri.v[k].v = source.uv[k][1];
+        }
+
+        input.push_back(tri);
+    }
+
+    BuildNode(std::move(input), 0);
+
+    m_buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool BspBuilder::ChooseSplit(const std::vector<BspTriangle>& triangles, int& outAxis, float& outPosition) const
+{
+    const size_t total = triangles.size();
+    float bestCost = FLT_MAX;
+
+    std::vector<float> centroids(total);
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (size_t i = 0; i < total; ++i)
+        {
+            const BspTriangle& tri = triangles[i];
+            centroids[i] = (Axis(tri.v[0].position, axis) + Axis(tri.v[1].position, axis) + Axis(tri.v[2].position, axis)) / 3.0f;
+        }
+
+        std::sort(centroids.begin(), centroids.end());
+
+        // Candidate planes at centroid quantiles.
+        for (uint32_t c = 1; c <= m_settings.candidatesPerAxis; ++c)
+        {
+            float position = centroids[total * c / (m_settings.candidatesPerAxis + 1)];
+
+            size_t back = 0, front = 0, split = 0;
+            for (const BspTriangle& tri : triangles)
+            {
+                float lo, hi;
+                TriangleRange(tri, axis, lo, hi);
+
+                if (hi <= position + kPlaneEpsilon)
+                    ++back;
+                else if (lo >= position - kPlaneEpsilon)
+                    ++front;
+                else
+                    ++split;
+            }
+
+            size_t backTotal = back + split;
+            size_t frontTotal = front + split;
+
+            // A plane that leaves everything on one side makes no progress.
+            if (backTotal == total || frontTotal == total)
+                continue;
+
+            float cost = std::fabs(static_cast<float>(backTotal) - static_cast<float>(frontTotal)) +
+                m_settings.splitCost * static_cast<float>(split);
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                outAxis = axis;
+                outPosition = position;
+            }
+        }
+    }
+
+    return bestCost < FLT_MAX;
+}
+
+uint32_t BspBuilder::BuildNode(std::vector<BspTriangle> triangles, uint32_t depth)
+{
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    m_maxDepth = std::max(m_maxDepth, depth);
+
+    Vec3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vec3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (const BspTriangle& tri : triangles)
+    {
+        for (const BspVertex& v : tri.v)
+        {
+            boundsMin = Vec3(std::min(boundsMin.x, v.position.x), std::min(boundsMin.y, v.position.y), std::min(boundsMin.z, v.position.z));
+            boundsMax = Vec3(std::max(boundsMax.x, v.position.x), std::max(boundsMax.y, v.position.y), std::max(boundsMax.z, v.position.z));
+        }
+    }
+
+    if (triangles.empty())
+        boundsMin = boundsMax = Vec3();
+
+    m_nodes[index].boundsMin = boundsMin;
+    m_nodes[index].boundsMax = boundsMax;
+
+    int axis = -1;
+    float position = 0.0f;
+
+    bool fits = triangles.size() * 3 <= m_settings.vertexBudget;
+
+    std::vector<BspTriangle> back;
+    std::vector<BspTriangle> front;
+
+    if (!fits && depth < m_settings.maxDepth && ChooseSplit(triangles, axis, position))
+    {
+        for (const BspTriangle& tri : triangles)
+        {
+            float lo, hi;
+            TriangleRange(tri, axis, lo, hi);
+
+            if (hi <= position + kPlaneEpsilon)
+                back.push_back(tri);
+            else if (lo >= position - kPlaneEpsilon)
+                front.push_back(tri);
+            else
+            {
+                ClipToSide(tri, axis, position, true, back);
+                ClipToSide(tri, axis, position, false, front);
+            }
+        }
+
+        // Clipped quads come back as two triangles; a split that does not
+        // shrink both sides would recurse without end. Fall back to a loose
+        // split by centroid: children may overlap across the plane, which
+        // the plane sector records in its back/front extents.
+        if (back.size() >= triangles.size() || front.size() >= triangles.size())
+        {
+            back.clear();
+            front.clear();
+
+            // Median centroid on the widest axis halves the node.
+            auto centroid = [](const BspTriangle& tri, int a)
+                {
+                    return (Axis(tri.v[0].position, a) + Axis(tri.v[1].position, a) + Axis(tri.v[2].position, a)) / 3.0f;
+                };
+
+            float widest = -1.0f;
+            for (int a = 0; a < 3; ++a)
+            {
+                float lo = FLT_MAX, hi = -FLT_MAX;
+                for (const BspTriangle& tri : triangles)
+                {
+                    lo = std::min(lo, centroid(tri, a));
+                    hi = std::max(hi, centroid(tri, a));
+                }
+
+                if (hi - lo > widest)
+                {
+                    widest = hi - lo;
+                    axis = a;
+                }
+            }
+
+            std::vector<float> centroids;
+            centroids.reserve(triangles.size());
+            for (const BspTriangle& tri : triangles)
+                centroids.push_back(centroid(tri, axis));
+
+            std::nth_element(centroids.begin(), centroids.begin() + centroids.size() / 2, centroids.end());
+            position = centroids[centroids.size() / 2];
+
+            for (const BspTriangle& tri : triangles)
+                (centroid(tri, axis) < position ? back : front).push_back(tri);
+
+            if (back.empty() || front.empty())
+                axis = -1;
+            else
+                ++m_looseSplits;
+        }
+    }
+    else
+    {
+        axis = -1;
+    }
+
+    if (axis < 0)
+    {
+        if (!fits)
+            ++m_overBudget;
+
+        std::stable_sort(triangles.begin(), triangles.end(),
+            [](const BspTriangle& a, const BspTriangle& b) { return a.materialId < b.materialId; });
+
+        m_outputTriangles += static_cast<uint32_t>(triangles.size());
+        ++m_leafCount;
+
+        m_nodes[index].triangles = std::move(triangles);
+        return index;
+    }
+
+    triangles.clear();
+    triangles.shrink_to_fit();
+
+    uint32_t backIndex = BuildNode(std::move(back), depth + 1);
+    uint32_t frontIndex = BuildNode(std::move(front), depth + 1);
+
+    Node& node = m_nodes[index];
+    node.axis = axis;
+    node.position = position;
+    node.back = backIndex;
+    node.front = frontIndex;
+    return index;
+}
+
+std::vector<char> BspBuilder::BuildAtomicSector(const Node& node) const
+{
+    std::vector<char> info;
+    AppendVec3(info, node.boundsMin);
+    AppendVec3(info, node.boundsMax);
+    AppendU32(info, static_cast<uint32_t>(node.triangles.size() * 3));
+    AppendU32(info, static_cast<uint32_t>(node.triangles.size()));
+
+    // Draw ranges: one PRIM per material run.
+    std::vector<uint32_t> ranges;
+    for (size_t i = 0; i < node.triangles.size(); )
+    {
+        size_t end = i;
+        while (end < node.triangles.size() && node.triangles[end].materialId == node.triangles[i].materialId)
+            ++end;
+
+        ranges.push_back(node.triangles[i].materialId);
+        ranges.push_back(static_cast<uint32_t>(i * 3));
+        ranges.push_back(static_cast<uint32_t>((end - i) * 3));
+        i = end;
+    }
+
+    AppendU32(info, static_cast<uint32_t>(ranges.size() / 3));
+    for (uint32_t value : ranges)
+        AppendU32(info, value);
+
+    // Vertices in GE order, the same layout as cooked static meshes.
+    std::vector<char> geometry;
+    geometry.reserve(node.triangles.size() * 3 * 32);
+
+    for (const BspTriangle& tri : node.triangles)
+    {
+        for (const BspVertex& v : tri.v)
+        {
+            AppendF32(geometry, v.u);
+            AppendF32(geometry, v.v);
+            AppendVec3(geometry, v.normal);
+            AppendVec3(geometry, v.position);
+        }
+    }
+
+    std::vector<char> payload;
+    AppendChunk(payload, GV_CHUNK_STRUCT, GV_CHUNK_VERSION, info);
+    AppendChunk(payload, GV_CHUNK_GEOMETRY, GV_CHUNK_VERSION, geometry);
+    return payload;
+}
+
+void BspBuilder::AppendNode(std::vector<char>& out, uint32_t index) const
+{
+    const Node& node = m_nodes[index];
+
+    if (node.axis < 0)
+    {
+        AppendChunk(out, GV_CHUNK_ATOMIC_SECT, GV_CHUNK_VERSION, BuildAtomicSector(node));
+        return;
+    }
+
+    std::vector<char> info;
+    AppendU32(info, static_cast<uint32_t>(node.axis));
+    AppendF32(info, node.position);
+    AppendU32(info, m_nodes[node.back].axis < 0 ? 1 : 0);
+    AppendU32(info, m_nodes[node.front].axis < 0 ? 1 : 0);
+    AppendF32(info, Axis(m_nodes[node.back].boundsMax, node.axis));  // back extent
+    AppendF32(info, Axis(m_nodes[node.front].boundsMin, node.axis)); // front extent
+    AppendVec3(info, node.boundsMin);
+    AppendVec3(info, node.boundsMax);
+
+    std::vector<char> payload;
+    AppendChunk(payload, GV_CHUNK_STRUCT, GV_CHUNK_VERSION, info);
+    AppendNode(payload, node.back);
+    AppendNode(payload, node.front);
+
+    AppendChunk(out, GV_CHUNK_PLANE_SECT, GV_CHUNK_VERSION, payload);
+}
+
+std::vector<char> BspBuilder::BuildChunk() const
+{
+    std::vector<char> info;
+    AppendU32(info, static_cast<uint32_t>(m_nodes.size()) - m_leafCount);
+    AppendU32(info, m_leafCount);
+    AppendU32(info, m_outputTriangles);
+    AppendU32(info, m_outputTriangles * 3);
+
+    if (m_nodes.empty())
+    {
+        AppendVec3(info, Vec3());
+        AppendVec3(info, Vec3());
+    }
+    else
+    {
+        AppendVec3(info, m_nodes[0].boundsMin);
+        AppendVec3(info, m_nodes[0].boundsMax);
+    }
+
+    std::vector<char> payload;
+    AppendChunk(payload, GV_CHUNK_STRUCT, GV_CHUNK_VERSION, info);
+
+    if (!m_nodes.empty())
+        AppendNode(payload, 0);
+
+    return payload;
+}
+
+std::vector<WorldSector> BspBuilder::GetLeafSectors() const
+{
+    std::vector<WorldSector> leaves;
+    if (m_nodes.empty())
+        return leaves;
+
+    // Same back-then-front order as the chunk.
+    std::vector<uint32_t> stack{ 0 };
+    while (!stack.empty())
+    {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (node.axis >= 0)
+        {
+            stack.push_back(node.front);
+            stack.push_back(node.back);
+            continue;
+        }
+
+        WorldSector sector;
+        sector.cellX = static_cast<int>(leaves.size());
+        sector.boundsMin = node.boundsMin;
+        sector.boundsMax = node.boundsMax;
+        leaves.push_back(sector);
+    }
+
+    return leaves;
+}
+
+void BspBuilder::Report(const std::string& sceneName) const
+{
+    size_t maxLeaf = 0;
+    for (const Node& node : m_nodes)
+        if (node.axis < 0)
+            maxLeaf = std::max(maxLeaf, node.triangles.size() * 3);
+
+    uint32_t added = m_outputTriangles - std::min(m_outputTriangles, m_inputTriangles);
+
+    std::cout << "[BSP] " << sceneName << ": " << (m_nodes.size() - m_leafCount) << " plane sectors, "
+        << m_leafCount << " atomic sectors, depth " << m_maxDepth
+        << ", built in " << static_cast<uint32_t>(m_buildMs) << " ms\n";
+
+    std::cout << "[BSP] " << sceneName << ": " << m_inputTriangles << " -> " << m_outputTriangles
+        << " triangles (" << added << " from splits), largest sector " << maxLeaf
+        << " / " << m_settings.vertexBudget << " vertices";
+
+    if (m_looseSplits > 0)
+        std::cout << ", " << m_looseSplits << " overlapping splits";
+
+    if (m_overBudget > 0)
+        std::cout << ", " << m_overBudget << " sectors over budget";
+
+    std::cout << "\n";
+}
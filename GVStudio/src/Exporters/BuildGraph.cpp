@@ -0,0 +1,455 @@
+#include "Exporters/BuildGraph.h"
+#include "Exporters/MeshCooker.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+#include "GVStudio/GVStudio.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    void AppendU64(std::vector<char>& dest, uint64_t value)
+    {
+        AppendU32(dest, static_cast<uint32_t>(value));
+        AppendU32(dest, static_cast<uint32_t>(value >> 32));
+    }
+
+    uint64_t ReadU64(const std::vector<char>& src, size_t& offset)
+    {
+        uint64_t lo = ReadU32(src, offset);
+        uint64_t hi = ReadU32(src, offset);
+        return lo | (hi << 32);
+    }
+
+    uint64_t HashFileContents(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+            return 0;
+
+        std::vector<char> buffer(64 * 1024);
+        XXHash64Stream stream;
+
+        while (in)
+        {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::streamsize got = in.gcount();
+            if (got <= 0)
+                break;
+
+            stream.Update(buffer.data(), static_cast<size_t>(got));
+        }
+
+        return stream.Digest();
+    }
+
+    std::vector<std::string> ListFiles(const fs::path& dir)
+    {
+        std::vector<std::string> files;
+
+        std::error_code ec;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(dir, ec))
+            if (entry.is_regular_file())
+                files.push_back(entry.path().lexically_normal().generic_string());
+
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+}
+
+BuildGraph::BuildGraph(LogicUnitRegistry& registry, const ExportSettings& settings)
+    : m_registry(registry),
+    m_settings(settings)
+{
+    // One graph per target folder; build targets one at a time.
+    if (m_settings.targets.size() != 1)
+        m_settings.targets = { m_settings.targets.empty() ? ExportTarget::Psp : m_settings.targets.front() };
+}
+
+bool BuildGraph::Build(const GV_Project_Info& project, bool force)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    const ExportTargetInfo& target = GetTargetInfo(m_settings.targets.front());
+    fs::path dataDir = fs::path(project.projectRoot) / project.dataFolder / target.dataSubfolder;
+    std::string packName = project.projectName.empty() ? "Game" : project.projectName;
+    fs::path graphPath = dataDir / (packName + ".gvbuild");
+
+    m_stamps.clear();
+    m_nodes.clear();
+    m_tablesHash = 0;
+
+    if (!force)
+        Load(graphPath.string());
+
+    // Everything a scene export can see besides its own inputs.
+    std::vector<std::string> globalInputs = ListFiles(fs::path(project.projectRoot) / project.sourceFolder);
+    globalInputs.push_back(fs::path(project.projectPath).lexically_normal().generic_string());
+
+    std::vector<fs::path> packPaths;
+    if (m_settings.writePack)
+        packPaths.push_back(dataDir / (packName + ".gvpack"));
+    if (m_settings.writeSharedPack)
+        packPaths.push_back(dataDir / (packName + ".gvchunks"));
+
+    // Current scene listings plus what each node read last time.
+    std::vector<std::string> paths = globalInputs;
+    std::map<std::string, std::vector<std::string>> sceneInputs;
+
+    for (const GV_Scene_Info& scene : project.scenes)
+    {
+        std::vector<std::string> inputs = ListFiles(fs::path(project.projectRoot) / scene.scenePath);
+
+        auto it = m_nodes.find("scene:" + scene.sceneName);
+        if (it != m_nodes.end())
+        {
+            inputs.insert(inputs.end(), it->second.inputs.begin(), it->second.inputs.end());
+            std::sort(inputs.begin(), inputs.end());
+            inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+        }
+
+        for (const std::string& input : inputs)
+        {
+            auto cook = m_nodes.find("cook:" + input);
+            if (cook != m_nodes.end())
+                paths.insert(paths.end(), cook->second.inputs.begin(), cook->second.inputs.end());
+        }
+
+        paths.insert(paths.end(), inputs.begin(), inputs.end());
+        paths.push_back((dataDir / (scene.sceneName + ".gvs")).lexically_normal().generic_string());
+        sceneInputs[scene.sceneName] = std::move(inputs);
+    }
+
+    RefreshStamps(paths);
+
+    std::vector<char> global;
+    AppendU32(global, kExportVersion);
+    AppendU32(global, MeshCooker::VERSION);
+    AppendU64(global, HashSettings());
+    for (const std::string& path : globalInputs)
+    {
+        AppendString(global, path);
+        AppendU64(global, GetHash(path));
+    }
+    m_globalSignature = XXHash64(global.data(), global.size());
+
+    ExportScope scope;
+    scope.allScenes = force;
+    scope.previousTablesHash = m_tablesHash;
+
+    for (const GV_Scene_Info& scene : project.scenes)
+    {
+        auto it = m_nodes.find("scene:" + scene.sceneName);
+        std::string outPath = (dataDir / (scene.sceneName + ".gvs")).lexically_normal().generic_string();
+
+        bool stale = it == m_nodes.end() ||
+            it->second.signature != SceneSignature(m_globalSignature, sceneInputs[scene.sceneName]) ||
+            it->second.output == 0 || it->second.output != GetHash(outPath);
+
+        if (stale)
+            scope.scenes.insert(scene.sceneName);
+    }
+
+    bool packsMissing = false;
+    for (const fs::path& path : packPaths)
+        packsMissing = packsMissing || !fs::exists(path);
+
+    if (!force && scope.scenes.empty() && !packsMissing)
+    {
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        std::cout << "[Build] " << project.projectName << " (" << target.name << ") is up to date, "
+            << project.scenes.size() << " scenes checked in " << ms << " ms\n";
+
+        // Stamps may have moved without content changes; keep them fresh.
+        return Save(graphPath.string());
+    }
+
+    ProjectExporter exporter(m_registry, m_settings);
+    if (!exporter.ExportProject(project, &scope))
+    {
+        std::cout << "[Build] Export " << (m_settings.control && m_settings.control->IsCancelled() ? "cancelled" : "failed")
+            << "; graph not updated\n";
+        return false;
+    }
+
+    m_tablesHash = scope.tablesHash;
+
+    // Record what this build read and wrote.
+    paths.clear();
+    for (const auto& [scene, inputs] : scope.sceneInputs)
+        paths.insert(paths.end(), inputs.begin(), inputs.end());
+    for (const auto& [mesh, inputs] : scope.meshInputs)
+        paths.insert(paths.end(), inputs.begin(), inputs.end());
+    for (const GV_Scene_Info& scene : project.scenes)
+        paths.push_back((dataDir / (scene.sceneName + ".gvs")).lexically_normal().generic_string());
+
+    RefreshStamps(paths);
+
+    uint32_t staleCooks = 0;
+    for (const auto& [mesh, inputs] : scope.meshInputs)
+    {
+        BuildNode& node = m_nodes["cook:" + mesh];
+        uint64_t signature = CookSignature(mesh, inputs);
+
+        if (node.signature != signature)
+            ++staleCooks;
+
+        node.signature = signature;
+        node.inputs = inputs;
+    }
+
+    std::vector<char> packInputs;
+
+    for (const GV_Scene_Info& scene : project.scenes)
+    {
+        BuildNode& node = m_nodes["scene:" + scene.sceneName];
+        node.inputs = scope.sceneInputs[scene.sceneName];
+        node.signature = SceneSignature(m_globalSignature, node.inputs);
+        node.output = GetHash((dataDir / (scene.sceneName + ".gvs")).lexically_normal().generic_string());
+
+        AppendU64(packInputs, node.output);
+    }
+
+    BuildNode& pack = m_nodes["pack"];
+    pack.signature = XXHash64(packInputs.data(), packInputs.size());
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    std::cout << "[Build] " << project.projectName << " (" << target.name << "): rebuilt "
+        << scope.written.size() << "/" << project.scenes.size() << " scenes, "
+        << staleCooks << " cooked meshes changed, " << ms << " ms\n";
+
+    return Save(graphPath.string());
+}
+
+void BuildGraph::RefreshStamps(const std::vector<std::string>& paths)
+{
+    std::set<std::string> unique(paths.begin(), paths.end());
+    std::vector<std::string> changed;
+
+    for (const std::string& path : unique)
+    {
+        std::error_code ec;
+        uint64_t size = fs::file_size(path, ec);
+        if (ec)
+        {
+            m_stamps.erase(path);
+            continue;
+        }
+
+        int64_t time = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+
+        auto it = m_stamps.find(path);
+        if (it != m_stamps.end() && it->second.size == size && it->second.time == time)
+            continue;
+
+        BuildStamp& stamp = m_stamps[path];
+        stamp.size = size;
+        stamp.time = time;
+        changed.push_back(path);
+    }
+
+    if (changed.empty())
+        return;
+
+    // Hashing is the only per-file work; spread it over threads.
+    std::vector<uint64_t> hashes(changed.size());
+    std::atomic<size_t> next{ 0 };
+
+    auto worker = [&]()
+        {
+            for (size_t i = next++; i < changed.size(); i = next++)
+                hashes[i] = HashFileContents(changed[i]);
+        };
+
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(changed.size()));
+
+    std::vector<std::thread> pool;
+    for (uint32_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    for (size_t i = 0; i < changed.size(); ++i)
+        m_stamps[changed[i]].hash = hashes[i];
+}
+
+uint64_t BuildGraph::GetHash(const std::string& path) const
+{
+    auto it = m_stamps.find(path);
+    return it == m_stamps.end() ? 0 : it->second.hash;
+}
+
+uint64_t BuildGraph::HashSettings() const
+{
+    const ExportSettings& s = m_settings;
+    std::vector<char> data;
+
+    AppendU32(data, static_cast<uint32_t>(s.targets.front()));
+    AppendU32(data, s.writePack ? 1 : 0);
+    AppendF32(data, static_cast<float>(s.umd.seekMs));
+    AppendF32(data, static_cast<float>(s.umd.seekMsPerMB));
+    AppendF32(data, static_cast<float>(s.umd.transferKBps));
+    AppendU32(data, s.umd.sectorSize);
+    AppendU32(data, s.umd.duplicateMaxBytes);
+    AppendU32(data, s.writeSharedPack ? 1 : 0);
+    AppendU32(data, s.shared.maxReadsPerScene);
+    AppendU32(data, s.shared.coalesceGapBytes);
+    AppendU32(data, static_cast<uint32_t>(s.worldLayout));
+    AppendF32(data, s.sectorSize);
+    AppendU32(data, s.bsp.vertexBudget);
+    AppendU32(data, s.bsp.maxDepth);
+    AppendF32(data, s.bsp.splitCost);
+    AppendU32(data, s.bsp.candidatesPerAxis);
+    AppendU32(data, s.writeChecksums ? 1 : 0);
+    AppendU32(data, s.computePvs ? 1 : 0);
+    AppendU32(data, s.pvs.raysPerPair);
+    AppendU32(data, s.bakeLightmaps ? 1 : 0);
+    AppendF32(data, s.lightmap.texelsPerUnit);
+    AppendU32(data, s.lightmap.pageSize);
+    AppendU32(data, s.lightmap.maxChartSize);
+    AppendU32(data, s.lightmap.passes);
+    AppendU32(data, s.lightmap.samplesPerPass);
+    AppendU32(data, s.lightmap.tileSize);
+    AppendF32(data, s.lightmap.ambient.x);
+    AppendF32(data, s.lightmap.ambient.y);
+    AppendF32(data, s.lightmap.ambient.z);
+
+    return XXHash64(data.data(), data.size());
+}
+
+uint64_t BuildGraph::CookSignature(const std::string& meshPath, const std::vector<std::string>& inputs) const
+{
+    std::vector<char> data;
+    AppendU32(data, MeshCooker::VERSION);
+    AppendString(data, meshPath);
+
+    for (const std::string& input : inputs)
+    {
+        AppendString(data, input);
+        AppendU64(data, GetHash(input));
+    }
+
+    return XXHash64(data.data(), data.size());
+}
+
+uint64_t BuildGraph::SceneSignature(uint64_t global, const std::vector<std::string>& inputs) const
+{
+    std::vector<char> data;
+    AppendU64(data, global);
+    AppendU64(data, m_tablesHash);
+
+    for (const std::string& input : inputs)
+    {
+        AppendString(data, input);
+
+        // Meshes count by their cook node, which covers MTL and textures.
+        auto cook = m_nodes.find("cook:" + input);
+        if (cook != m_nodes.end())
+            AppendU64(data, CookSignature(input, cook->second.inputs));
+        else
+            AppendU64(data, GetHash(input));
+    }
+
+    return XXHash64(data.data(), data.size());
+}
+
+bool BuildGraph::Load(const std::string& path)
+{
+    std::vector<char> file;
+    if (!ChunkReader::ReadFile(path, file))
+        return false;
+
+    ChunkReader reader(file);
+    GV_ChunkView chunk;
+    if (!reader.Next(chunk) || chunk.type != GV_CHUNK_BUILD_GRAPH)
+        return false;
+
+    std::vector<char> payload(file.begin() + chunk.payload, file.begin() + chunk.GetEnd());
+    size_t at = 0;
+
+    if (ReadU32(payload, at) != kExportVersion)
+        return false;
+
+    m_tablesHash = ReadU64(payload, at);
+
+    uint32_t stampCount = ReadU32(payload, at);
+    for (uint32_t i = 0; i < stampCount && at < payload.size(); ++i)
+    {
+        std::string name = ReadString(payload, at);
+        BuildStamp& stamp = m_stamps[name];
+        stamp.size = ReadU64(payload, at);
+        stamp.time = static_cast<int64_t>(ReadU64(payload, at));
+        stamp.hash = ReadU64(payload, at);
+    }
+
+    uint32_t nodeCount = ReadU32(payload, at);
+    for (uint32_t i = 0; i < nodeCount && at < payload.size(); ++i)
+    {
+        std::string name = ReadString(payload, at);
+        BuildNode& node = m_nodes[name];
+        node.signature = ReadU64(payload, at);
+        node.output = ReadU64(payload, at);
+
+        uint32_t inputCount = ReadU32(payload, at);
+        for (uint32_t k = 0; k < inputCount && at < payload.size(); ++k)
+            node.inputs.push_back(ReadString(payload, at));
+    }
+
+    return true;
+}
+
+bool BuildGraph::Save(const std::string& path) const
+{
+    std::vector<char> payload;
+    AppendU32(payload, kExportVersion);
+    AppendU64(payload, m_tablesHash);
+
+    AppendU32(payload, static_cast<uint32_t>(m_stamps.size()));
+    for (const auto& [name, stamp] : m_stamps)
+    {
+        AppendString(payload, name);
+        AppendU64(payload, stamp.size);
+        AppendU64(payload, static_cast<uint64_t>(stamp.time));
+        AppendU64(payload, stamp.hash);
+    }
+
+    AppendU32(payload, static_cast<uint32_t>(m_nodes.size()));
+    for (const auto& [name, node] : m_nodes)
+    {
+        AppendString(payload, name);
+        AppendU64(payload, node.signature);
+        AppendU64(payload, node.output);
+
+        AppendU32(payload, static_cast<uint32_t>(node.inputs.size()));
+        for (const std::string& input : node.inputs)
+            AppendString(payload, input);
+    }
+
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "[Build] Failed to write: " << path << "\n";
+        return false;
+    }
+
+    WriteChunk(out, GV_CHUNK_BUILD_GRAPH, GV_CHUNK_VERSION, payload);
+    return true;
+}
@@ -0,0 +1,501 @@
+#include "Exporters/ChunkPatch.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const uint32_t ROLL_BASE = 0x01000193;
+
+    uint32_t HashBlock(const char* p, uint32_t size)
+    {
+        uint32_t h = 0;
+        for (uint32_t i = 0; i < size; ++i)
+            h = h * ROLL_BASE + static_cast<unsigned char>(p[i]);
+        return h;
+    }
+
+    bool ReadStreamU32(std::ifstream& in, uint32_t& value)
+    {
+        unsigned char b[4];
+        if (!in.read(reinterpret_cast<char*>(b), 4))
+            return false;
+
+        value = static_cast<uint32_t>(b[0]) |
+            (static_cast<uint32_t>(b[1]) << 8) |
+            (static_cast<uint32_t>(b[2]) << 16) |
+            (static_cast<uint32_t>(b[3]) << 24);
+        return true;
+    }
+
+    // Streams size bytes from in to out through buffer, hashing as it goes.
+    bool Pump(std::ifstream& in, std::ofstream& out, uint32_t size,
+        std::vector<char>& buffer, XXHash64Stream& hash)
+    {
+        while (size > 0)
+        {
+            uint32_t piece = std::min(size, static_cast<uint32_t>(buffer.size()));
+            if (!in.read(buffer.data(), piece))
+                return false;
+
+            out.write(buffer.data(), piece);
+            hash.Update(buffer.data(), piece);
+            size -= piece;
+        }
+
+        return static_cast<bool>(out);
+    }
+
+    bool HashFile(const std::string& path, std::vector<char>& buffer, uint64_t& size, uint64_t& hash)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.is_open())
+            return false;
+
+        XXHash64Stream stream;
+        size = 0;
+
+        while (in)
+        {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::streamsize got = in.gcount();
+            if (got <= 0)
+                break;
+
+            stream.Update(buffer.data(), static_cast<size_t>(got));
+            size += static_cast<uint64_t>(got);
+        }
+
+        hash = stream.Digest();
+        return true;
+    }
+}
+
+ChunkPatch::ChunkPatch(const PatchSettings& settings)
+    : m_settings(settings)
+{
+    m_settings.blockSize = std::max<uint32_t>(m_settings.blockSize, 8);
+    m_settings.applyBufferBytes = std::max<uint32_t>(m_settings.applyBufferBytes, 4096);
+}
+
+bool ChunkPatch::Create(const std::string& oldPath, const std::string& newPath, const std::string& patchPath)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    m_old.clear();
+    m_new.clear();
+    m_ops.clear();
+    m_oldChunks.clear();
+    m_blocks.clear();
+    m_blocksBuilt = false;
+    m_copiedChunks = 0;
+    m_diffedChunks = 0;
+
+    if (!ChunkReader::ReadFile(oldPath, m_old) || !ChunkReader::ReadFile(newPath, m_new))
+    {
+        std::cout << "[Patch] Failed to read " << oldPath << " or " << newPath << "\n";
+        return false;
+    }
+
+    if (m_old.size() > UINT32_MAX || m_new.size() > UINT32_MAX)
+    {
+        std::cout << "[Patch] Files over 4 GB are not supported\n";
+        return false;
+    }
+
+    IndexChunks(0, m_old.size());
+    DiffChunks(0, m_new.size());
+
+    std::ofstream out(patchPath, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "[Patch] Failed to open: " << patchPath << "\n";
+        return false;
+    }
+
+    uint64_t oldHash = XXHash64(m_old.data(), m_old.size());
+    uint64_t newHash = XXHash64(m_new.data(), m_new.size());
+
+    std::vector<char> payload;
+    AppendU32(payload, static_cast<uint32_t>(m_old.size()));
+    AppendU32(payload, static_cast<uint32_t>(oldHash));
+    AppendU32(payload, static_cast<uint32_t>(oldHash >> 32));
+    AppendU32(payload, static_cast<uint32_t>(m_new.size()));
+    AppendU32(payload, static_cast<uint32_t>(newHash));
+    AppendU32(payload, static_cast<uint32_t>(newHash >> 32));
+    AppendU32(payload, static_cast<uint32_t>(m_ops.size()));
+
+    uint64_t copyBytes = 0;
+    uint64_t literalBytes = 0;
+
+    for (const Op& op : m_ops)
+    {
+        AppendU32(payload, static_cast<uint32_t>(op.kind));
+
+        if (op.kind == OpKind::Copy)
+        {
+            AppendU32(payload, op.offset);
+            AppendU32(payload, op.size);
+            copyBytes += op.size;
+        }
+        else
+        {
+            AppendU32(payload, op.size);
+            payload.insert(payload.end(), m_new.begin() + op.offset, m_new.begin() + op.offset + op.size);
+            payload.resize((payload.size() + 3) & ~static_cast<size_t>(3), 0);
+            literalBytes += op.size;
+        }
+    }
+
+    WriteChunk(out, GV_CHUNK_PATCH, GV_CHUNK_VERSION, payload);
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    uint64_t patchSize = payload.size() + 12;
+
+    std::cout << "[Patch] " << fs::path(newPath).filename().string() << ": "
+        << m_new.size() << " bytes -> " << patchSize << " byte patch ("
+        << (m_new.empty() ? 0.0 : 100.0 * static_cast<double>(patchSize) / static_cast<double>(m_new.size()))
+        << "%), " << m_copiedChunks << " chunks unchanged, " << m_diffedChunks << " diffed, "
+        << copyBytes << " bytes copied, " << literalBytes << " literal, " << ms << " ms\n";
+
+    return true;
+}
+
+void ChunkPatch::IndexChunks(size_t begin, size_t end)
+{
+    ChunkReader reader(m_old.data(), m_old.size(), begin, end);
+    GV_ChunkView chunk;
+
+    while (reader.Next(chunk))
+    {
+        size_t size = chunk.GetEnd() - chunk.start;
+        uint64_t hash = XXHash64(m_old.data() + chunk.start, size);
+        m_oldChunks.emplace(hash, std::make_pair(static_cast<uint32_t>(chunk.start), static_cast<uint32_t>(size)));
+
+        if (HasChildren(m_old, chunk.payload, chunk.GetEnd()))
+            IndexChunks(chunk.payload, chunk.GetEnd());
+    }
+}
+
+bool ChunkPatch::HasChildren(const std::vector<char>& data, size_t payload, size_t end) const
+{
+    // A payload counts as nested chunks only if it parses cleanly to the end.
+    if (payload == end)
+        return false;
+
+    ChunkReader reader(data.data(), data.size(), payload, end);
+    GV_ChunkView child;
+    while (reader.Next(child)) {}
+
+    return reader.IsValid();
+}
+
+void ChunkPatch::DiffChunks(size_t begin, size_t end)
+{
+    ChunkReader reader(m_new.data(), m_new.size(), begin, end);
+    GV_ChunkView chunk;
+    size_t done = begin;
+
+    while (reader.Next(chunk))
+    {
+        done = chunk.GetEnd();
+
+        size_t size = chunk.GetEnd() - chunk.start;
+        uint64_t hash = XXHash64(m_new.data() + chunk.start, size);
+
+        auto it = m_oldChunks.find(hash);
+        if (it != m_oldChunks.end() && it->second.second == size &&
+            std::memcmp(m_old.data() + it->second.first, m_new.data() + chunk.start, size) == 0)
+        {
+            EmitCopy(it->second.first, it->second.second);
+            ++m_copiedChunks;
+            continue;
+        }
+
+        if (HasChildren(m_new, chunk.payload, chunk.GetEnd()))
+        {
+            DiffRange(chunk.start, chunk.payload); // header only; its size changed
+            DiffChunks(chunk.payload, chunk.GetEnd());
+            continue;
+        }
+
+        DiffRange(chunk.start, chunk.GetEnd());
+        ++m_diffedChunks;
+    }
+
+    // Anything that isn't a chunk (or a whole non-chunk file) is diffed raw.
+    if (done < end)
+        DiffRange(done, end);
+}
+
+void ChunkPatch::BuildBlockIndex()
+{
+    m_blocksBuilt = true;
+
+    const uint32_t block = m_settings.blockSize;
+    m_blocks.reserve(m_old.size() / block + 1);
+
+    for (size_t offset = 0; offset + block <= m_old.size(); offset += block)
+        m_blocks.emplace(HashBlock(m_old.data() + offset, block), static_cast<uint32_t>(offset));
+}
+
+void ChunkPatch::DiffRange(size_t begin, size_t end)
+{
+    const uint32_t block = m_settings.blockSize;
+
+    if (end - begin < block)
+    {
+        EmitLiteral(static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin));
+        return;
+    }
+
+    if (!m_blocksBuilt)
+        BuildBlockIndex();
+
+    // ROLL_BASE^(block - 1), to drop the outgoing byte.
+    uint32_t outFactor = 1;
+    for (uint32_t i = 1; i < block; ++i)
+        outFactor *= ROLL_BASE;
+
+    const char* data = m_new.data();
+    size_t pos = begin;
+    size_t literalStart = begin;
+    uint32_t h = HashBlock(data + pos, block);
+
+    while (pos + block <= end)
+    {
+        auto it = m_blocks.find(h);
+        if (it != m_blocks.end() && std::memcmp(m_old.data() + it->second, data + pos, block) == 0)
+        {
+            size_t o = it->second;
+            size_t n = pos;
+
+            while (n > literalStart && o > 0 && m_old[o - 1] == data[n - 1])
+            {
+                --n;
+                --o;
+            }
+
+            size_t length = pos + block - n;
+            while (n + length < end && o + length < m_old.size() && m_old[o + length] == data[n + length])
+                ++length;
+
+            EmitLiteral(static_cast<uint32_t>(literalStart), static_cast<uint32_t>(n - literalStart));
+            EmitCopy(static_cast<uint32_t>(o), static_cast<uint32_t>(length));
+
+            pos = n + length;
+            literalStart = pos;
+
+            if (pos + block <= end)
+                h = HashBlock(data + pos, block);
+            continue;
+        }
+
+        if (pos + block < end)
+        {
+            h -= static_cast<unsigned char>(data[pos]) * outFactor;
+            h = h * ROLL_BASE + static_cast<unsigned char>(data[pos + block]);
+        }
+        ++pos;
+    }
+
+    EmitLiteral(static_cast<uint32_t>(literalStart), static_cast<uint32_t>(end - literalStart));
+}
+
+void ChunkPatch::EmitCopy(uint32_t offset, uint32_t size)
+{
+    if (size == 0)
+        return;
+
+    if (!m_ops.empty() && m_ops.back().kind == OpKind::Copy &&
+        m_ops.back().offset + m_ops.back().size == offset)
+    {
+        m_ops.back().size += size;
+        return;
+    }
+
+    m_ops.push_back({ OpKind::Copy, offset, size });
+}
+
+void ChunkPatch::EmitLiteral(uint32_t offset, uint32_t size)
+{
+    if (size == 0)
+        return;
+
+    if (!m_ops.empty() && m_ops.back().kind == OpKind::Literal &&
+        m_ops.back().offset + m_ops.back().size == offset)
+    {
+        m_ops.back().size += size;
+        return;
+    }
+
+    m_ops.push_back({ OpKind::Literal, offset, size });
+}
+
+bool ChunkPatch::Apply(const std::string& oldPath, const std::string& patchPath, const std::string& outPath) const
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    std::vector<char> buffer(m_settings.applyBufferBytes);
+
+    std::ifstream patch(patchPath, std::ios::binary);
+    if (!patch.is_open())
+    {
+        std::cout << "[Patch] Failed to open: " << patchPath << "\n";
+        return false;
+    }
+
+    uint32_t type = 0, size = 0, version = 0;
+    uint32_t oldSize = 0, oldLo = 0, oldHi = 0, newSize = 0, newLo = 0, newHi = 0, opCount = 0;
+
+    if (!ReadStreamU32(patch, type) || !ReadStreamU32(patch, size) || !ReadStreamU32(patch, version) ||
+        type != GV_CHUNK_PATCH ||
+        !ReadStreamU32(patch, oldSize) || !ReadStreamU32(patch, oldLo) || !ReadStreamU32(patch, oldHi) ||
+        !ReadStreamU32(patch, newSize) || !ReadStreamU32(patch, newLo) || !ReadStreamU32(patch, newHi) ||
+        !ReadStreamU32(patch, opCount))
+    {
+        std::cout << "[Patch] Not a patch file: " << patchPath << "\n";
+        return false;
+    }
+
+    // Refuse to patch the wrong base instead of producing garbage.
+    uint64_t baseSize = 0, baseHash = 0;
+    if (!HashFile(oldPath, buffer, baseSize, baseHash) || baseSize != oldSize ||
+        baseHash != ((static_cast<uint64_t>(oldHi) << 32) | oldLo))
+    {
+        std::cout << "[Patch] " << oldPath << " is not the file this patch was made from\n";
+        return false;
+    }
+
+    std::ifstream old(oldPath, std::ios::binary);
+    std::ofstream out(outPath, std::ios::binary);
+    if (!old.is_open() || !out.is_open())
+    {
+        std::cout << "[Patch] Failed to open: " << outPath << "\n";
+        return false;
+    }
+
+    XXHash64Stream hash;
+
+    for (uint32_t i = 0; i < opCount; ++i)
+    {
+        uint32_t kind = 0, a = 0, b = 0;
+        bool ok = ReadStreamU32(patch, kind) && ReadStreamU32(patch, a);
+
+        if (ok && kind == static_cast<uint32_t>(OpKind::Copy))
+        {
+            ok = ReadStreamU32(patch, b) && static_cast<uint64_t>(a) + b <= oldSize;
+            if (ok)
+            {
+                old.clear();
+                old.seekg(a);
+                ok = Pump(old, out, b, buffer, hash);
+            }
+        }
+        else if (ok && kind == static_cast<uint32_t>(OpKind::Literal))
+        {
+            ok = Pump(patch, out, a, buffer, hash);
+            patch.ignore((4 - (a & 3)) & 3);
+        }
+        else
+        {
+            ok = false;
+        }
+
+        if (!ok)
+        {
+            std::cout << "[Patch] Corrupt patch at op " << i << ": " << patchPath << "\n";
+            return false;
+        }
+    }
+
+    out.close();
+
+    if (hash.Digest() != ((static_cast<uint64_t>(newHi) << 32) | newLo))
+    {
+        std::cout << "[Patch] Output hash mismatch: " << outPath << "\n";
+        return false;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    double mbPerSec = ms > 0.0 ? (static_cast<double>(newSize) / (1024.0 * 1024.0)) / (ms / 1000.0) : 0.0;
+
+    std::cout << "[Patch] Applied " << fs::path(patchPath).filename().string() << ": "
+        << newSize << " bytes in " << ms << " ms (" << mbPerSec << " MB/s, "
+        << buffer.size() / 1024 << " KB buffer)\n";
+
+    return true;
+}
+
+bool ChunkPatch::PatchFolder(const std::string& oldDir, const std::string& newDir, const PatchSettings& settings)
+{
+    fs::path patchDir = fs::path(newDir) / "Patches";
+
+    std::error_code ec;
+    fs::create_directories(patchDir, ec);
+
+    ChunkPatch patcher(settings);
+    std::vector<char> buffer(patcher.m_settings.applyBufferBytes);
+
+    uint64_t totalNew = 0;
+    uint64_t totalPatch = 0;
+    bool ok = true;
+
+    for (const fs::directory_entry& entry : fs::directory_iterator(newDir, ec))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        std::string ext = entry.path().extension().string();
+        if (ext != ".gvs" && ext != ".gvpack" && ext != ".gvchunks" && ext != ".gvref")
+            continue;
+
+        fs::path oldPath = fs::path(oldDir) / entry.path().filename();
+        if (!fs::exists(oldPath))
+            continue;
+
+        uint64_t oldSize = 0, oldHash = 0, newSize = 0, newHash = 0;
+        if (HashFile(oldPath.string(), buffer, oldSize, oldHash) &&
+            HashFile(entry.path().string(), buffer, newSize, newHash) &&
+            oldSize == newSize && oldHash == newHash)
+        {
+            std::cout << "[Patch] " << entry.path().filename().string() << ": unchanged\n";
+            continue;
+        }
+
+        fs::path patchPath = patchDir / (entry.path().filename().string() + ".gvpatch");
+        fs::path verifyPath = patchDir / (entry.path().filename().string() + ".verify");
+
+        if (!patcher.Create(oldPath.string(), entry.path().string(), patchPath.string()) ||
+            !patcher.Apply(oldPath.string(), patchPath.string(), verifyPath.string()))
+        {
+            // A patch that did not verify must not be shipped.
+            std::cout << "[Patch] " << entry.path().filename().string() << ": failed, no patch written\n";
+            fs::remove(patchPath, ec);
+            fs::remove(verifyPath, ec);
+            ok = false;
+            continue;
+        }
+
+        fs::remove(verifyPath, ec);
+
+        totalNew += newSize;
+        totalPatch += fs::file_size(patchPath, ec);
+    }
+
+    std::cout << "[Patch] Total: " << totalPatch << " patch bytes for " << totalNew
+        << " bytes of changed files\n";
+
+    return ok;
+}
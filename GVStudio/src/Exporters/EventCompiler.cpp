@@ -0,0 +1,315 @@
+#include "Exporters/EventCompiler.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Scene/SceneObject.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+
+namespace
+{
+    std::string MakeIdentifier(const std::string& name)
+    {
+        std::string id = "GV_EVENT_";
+
+        for (char c : name)
+        {
+            unsigned char uc = static_cast<unsigned char>(c);
+            id.push_back(std::isalnum(uc) ? static_cast<char>(std::toupper(uc)) : '_');
+        }
+
+        return id;
+    }
+}
+
+void EventCompiler::Clear()
+{
+    m_scenes.clear();
+    m_names.clear();
+    m_ids.clear();
+}
+
+void EventCompiler::CollectScene(
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects)
+{
+    EventSceneUsage usage;
+    usage.sceneName = sceneName;
+
+    for (size_t objIndex = 0; objIndex < objects.size(); ++objIndex)
+    {
+        const SceneObject* obj = objects[objIndex];
+        if (!obj || !obj->def || !obj->def->def)
+            continue;
+
+        const GV_Logic_Unit& def = *obj->def->def;
+        size_t count = std::min(def.params.size(), obj->def->values.size());
+
+        // BuildLogicUnitChunk leaves separators out, so the runtime slot
+        // only counts the params it writes.
+        uint32_t slot = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (def.params[i].type == ParamType::Separator)
+                continue;
+
+            const uint32_t paramIndex = slot++;
+            const std::string& name = obj->def->values[i].sval;
+            if (name.empty())
+                continue;
+
+            EventEndpoint endpoint;
+            endpoint.objectIndex = static_cast<uint32_t>(objIndex);
+            endpoint.paramIndex = paramIndex;
+
+            if (def.params[i].type == ParamType::Event)
+                usage.senders[name].push_back(endpoint);
+            else if (def.params[i].type == ParamType::Message)
+                usage.receivers[name].push_back(endpoint);
+        }
+    }
+
+    m_scenes.push_back(std::move(usage));
+}
+
+void EventCompiler::AssignIds()
+{
+    std::set<std::string> names;
+
+    for (const EventSceneUsage& scene : m_scenes)
+    {
+        for (const auto& [name, endpoints] : scene.senders)
+            names.insert(name);
+        for (const auto& [name, endpoints] : scene.receivers)
+            names.insert(name);
+    }
+
+    m_names.assign(names.begin(), names.end());
+    m_ids.clear();
+
+    for (size_t i = 0; i < m_names.size(); ++i)
+        m_ids[m_names[i]] = static_cast<uint32_t>(i);
+
+    std::cout << "[EventCompiler] Assigned " << m_names.size()
+        << " event IDs\n";
+}
+
+uint32_t EventCompiler::GetId(const std::string& name) const
+{
+    auto it = m_ids.find(name);
+    if (it == m_ids.end())
+        return GV_EVENT_INVALID;
+
+    return it->second;
+}
+
+size_t EventCompiler::GetIdCount() const
+{
+    return m_names.size();
+}
+
+std::vector<char> EventCompiler::BuildDispatchTable(size_t sceneIndex) const
+{
+    std::vector<char> payload;
+
+    if (sceneIndex >= m_scenes.size())
+        return payload;
+
+    const EventSceneUsage& scene = m_scenes[sceneIndex];
+
+    AppendU32(payload, static_cast<uint32_t>(m_names.size()));
+
+    uint32_t offset = 0;
+    for (const std::string& name : m_names)
+    {
+        AppendU32(payload, offset);
+
+        auto it = scene.receivers.find(name);
+        if (it != scene.receivers.end())
+            offset += static_cast<uint32_t>(it->second.size());
+    }
+    AppendU32(payload, offset);
+
+    for (const std::string& name : m_names)
+    {
+        auto it = scene.receivers.find(name);
+        if (it == scene.receivers.end())
+            continue;
+
+        for (const EventEndpoint& r : it->second)
+        {
+            AppendU32(payload, r.objectIndex);
+            AppendU32(payload, r.paramIndex);
+        }
+    }
+
+    return payload;
+}
+
+bool EventCompiler::WriteHeader(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+    {
+        std::cout << "[EventCompiler] Cannot write header: " << path << "\n";
+        return false;
+    }
+
+    out << "// Generated by Gravitas Studio on export. Do not edit.\n";
+    out << "#pragma once\n\n";
+    out << "enum GV_EventId : unsigned int\n{\n";
+
+    std::set<std::string> used;
+    for (size_t i = 0; i < m_names.size(); ++i)
+    {
+        std::string id = MakeIdentifier(m_names[i]);
+        if (!used.insert(id).second)
+        {
+            id += "_" + std::to_string(i);
+            used.insert(id);
+        }
+
+        out << "    " << id << " = " << i << ", // \"" << m_names[i] << "\"\n";
+    }
+
+    out << "\n    GV_EVENT_COUNT = " << m_names.size() << "\n";
+    out << "};\n";
+
+    return true;
+}
+
+size_t EventCompiler::Report() const
+{
+    size_t problems = 0;
+
+    for (const EventSceneUsage& scene : m_scenes)
+    {
+        for (const auto& [name, endpoints] : scene.senders)
+        {
+            if (scene.receivers.count(name))
+                continue;
+
+            std::cout << "[EventCompiler] " << scene.sceneName
+                << ": event '" << name << "' is sent by "
+                << endpoints.size() << " object(s) but never received\n";
+            ++problems;
+        }
+
+        for (const auto& [name, endpoints] : scene.receivers)
+        {
+            if (scene.senders.count(name))
+                continue;
+
+            std::cout << "[EventCompiler] " << scene.sceneName
+                << ": message '" << name << "' is received by "
+                << endpoints.size() << " object(s) but never sent\n";
+            ++problems;
+        }
+    }
+
+    return problems;
+}
+
+void EventCompiler::RunBenchmark(uint32_t objectCount)
+{
+    using Clock = std::chrono::steady_clock;
+    const uint32_t eventNames = 64;
+
+    // Separators in front of both kinds, as the editor's logic units
+    // group their params.
+    GV_Logic_Unit door;
+    door.typeName = "Door";
+    door.chunkType = GV_CHUNK_LOGIC_UNIT;
+    auto param = [](const char* name, ParamType type, const char* text = "")
+        {
+            LU_Param_Def def;
+            def.name = name;
+            def.type = type;
+            def.defaultValue = text; // a separator's caption
+            return def;
+        };
+
+    door.params = {
+        param("Speed", ParamType::Float),
+        param("", ParamType::Separator, "Events"),
+        param("OnOpened", ParamType::Event),
+        param("", ParamType::Separator, "Messages"),
+        param("Open", ParamType::Message),
+        param("Close", ParamType::Message)
+    };
+
+    std::vector<std::unique_ptr<SceneObject>> owned;
+    std::vector<const SceneObject*> objects;
+    owned.reserve(objectCount);
+    objects.reserve(objectCount);
+
+    for (uint32_t i = 0; i < objectCount; ++i)
+    {
+        auto inst = std::make_unique<GV_Logic_Unit_Instance>();
+        inst->def = &door;
+        inst->instanceName = "Door_" + std::to_string(i);
+        inst->values.resize(door.params.size());
+        inst->values[2].sval = "Opened" + std::to_string(i % eventNames);
+        inst->values[4].sval = "Opened" + std::to_string((i + 1) % eventNames);
+        inst->values[5].sval = "Opened" + std::to_string((i + 2) % eventNames);
+
+        auto obj = std::make_unique<SceneObject>();
+        obj->name = inst->instanceName;
+        obj->def = std::move(inst);
+        objects.push_back(obj.get());
+        owned.push_back(std::move(obj));
+    }
+
+    // Runtime slot of each param, as BuildLogicUnitChunk writes them.
+    std::vector<size_t> slotToParam;
+    for (size_t i = 0; i < door.params.size(); ++i)
+        if (door.params[i].type != ParamType::Separator)
+            slotToParam.push_back(i);
+
+    EventCompiler compiler;
+    Clock::time_point t0 = Clock::now();
+    compiler.CollectScene("Benchmark", objects);
+    compiler.AssignIds();
+    std::vector<char> table = compiler.BuildDispatchTable(0);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    // count, count + 1 offsets, then (object, param) pairs.
+    auto read = [&](size_t index)
+        {
+            uint32_t value = 0;
+            std::memcpy(&value, table.data() + index * 4, 4);
+            return value;
+        };
+
+    const uint32_t idCount = read(0);
+    const uint32_t entryCount = read(1 + idCount);
+    size_t wrong = 0;
+
+    for (uint32_t id = 0; id < idCount; ++id)
+    {
+        for (uint32_t e = read(1 + id); e < read(2 + id); ++e)
+        {
+            const uint32_t objectIndex = read(2 + idCount + e * 2);
+            const uint32_t slot = read(3 + idCount + e * 2);
+
+            bool ok = objectIndex < objects.size() && slot < slotToParam.size();
+            if (ok)
+            {
+                const size_t param = slotToParam[slot];
+                ok = door.params[param].type == ParamType::Message &&
+                    objects[objectIndex]->def->values[param].sval == compiler.m_names[id];
+            }
+            wrong += ok ? 0 : 1;
+        }
+    }
+
+    std::cout << "[EventCompiler] Benchmark: " << objectCount << " objects, " << idCount
+        << " event IDs, " << entryCount << " receivers in " << ms << " ms, "
+        << (wrong ? std::to_string(wrong) + " entries point at the wrong param (FAILED)" : "every entry on its Message param")
+        << "\n";
+}
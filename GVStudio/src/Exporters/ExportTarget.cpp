@@ -0,0 +1,28 @@
+#include "Exporters/ExportTarget.h"
+#include "Exporters/MeshCooker.h"
+
+namespace
+{
+    template<typename Target>
+    ExportTargetInfo MakeTargetInfo()
+    {
+        ExportTargetInfo info;
+        info.name = Target::name;
+        info.dataSubfolder = Target::dataSubfolder;
+        info.pointerSize = Target::pointerSize;
+        info.objectRecordSize = RuntimeObjectRecordSize<Target>();
+        info.vertexStride = sizeof(CookedVertex);
+        info.vertexAlign = Target::vertexAlign;
+        info.nativeDisplayLists = Target::nativeDisplayLists;
+        info.buildVertexData = &MeshCooker::BuildVertexData<Target>;
+        return info;
+    }
+}
+
+const ExportTargetInfo& GetTargetInfo(ExportTarget target)
+{
+    static const ExportTargetInfo psp = MakeTargetInfo<PspTarget>();
+    static const ExportTargetInfo pc64 = MakeTargetInfo<Pc64Target>();
+
+    return target == ExportTarget::Pc64 ? pc64 : psp;
+}
@@ -0,0 +1,484 @@
+#include "Exporters/GeDisplayList.h"
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+namespace
+{
+    uint32_t Log2(uint32_t value)
+    {
+        uint32_t log = 0;
+        while ((1u << log) < value)
+            ++log;
+        return log;
+    }
+
+    struct ParsedList
+    {
+        uint32_t stride = 0;
+        std::vector<uint32_t> words;
+        std::vector<GeRelocation> relocations;
+    };
+
+    bool ParsePayload(const std::vector<char>& payload, ParsedList& out)
+    {
+        size_t at = 0;
+        out.stride = ReadU32(payload, at);
+
+        uint32_t wordCount = ReadU32(payload, at);
+        if (at + static_cast<size_t>(wordCount) * 4 > payload.size())
+            return false;
+
+        out.words.resize(wordCount);
+        for (uint32_t i = 0; i < wordCount; ++i)
+            out.words[i] = ReadU32(payload, at);
+
+        uint32_t relocCount = ReadU32(payload, at);
+        if (at + static_cast<size_t>(relocCount) * 20 > payload.size())
+            return false;
+
+        out.relocations.resize(relocCount);
+        for (GeRelocation& reloc : out.relocations)
+        {
+            reloc.word = ReadU32(payload, at);
+            reloc.target = static_cast<GeRelocTarget>(ReadU32(payload, at));
+            reloc.index = ReadU32(payload, at);
+            reloc.offset = ReadU32(payload, at);
+            reloc.high = ReadU32(payload, at) != 0;
+        }
+
+        return at == payload.size();
+    }
+
+    // The command a relocation of this kind must patch.
+    uint32_t ExpectedCommand(const GeRelocation& reloc)
+    {
+        switch (reloc.target)
+        {
+        case GeRelocTarget::VertexBuffer: return reloc.high ? GE_CMD_BASE : GE_CMD_VADDR;
+        case GeRelocTarget::Texture: return reloc.high ? GE_CMD_TBW0 : GE_CMD_TBP0;
+        case GeRelocTarget::Clut: return reloc.high ? GE_CMD_CBW : GE_CMD_CBP;
+        }
+        return 0xFFFFFFFFu;
+    }
+
+    const char* TargetName(GeRelocTarget target)
+    {
+        switch (target)
+        {
+        case GeRelocTarget::VertexBuffer: return "vbuf";
+        case GeRelocTarget::Texture: return "tex";
+        case GeRelocTarget::Clut: return "clut";
+        }
+        return "?";
+    }
+}
+
+void GeDisplayList::Emit(uint32_t cmd, uint32_t arg)
+{
+    m_words.push_back((cmd << 24) | (arg & 0xFFFFFF));
+}
+
+void GeDisplayList::EmitAddress(uint32_t lowCmd, uint32_t highCmd, uint32_t highArg,
+    GeRelocTarget target, uint32_t index, uint32_t offset)
+{
+    // BASE/TBW/CBW carry address bits 24-27, VADDR/TBP/CBP the low 24 bits.
+    // Order follows libgu: BASE before VADDR, TBP/CBP before TBW/CBW.
+    GeRelocation reloc;
+    reloc.target = target;
+    reloc.index = index;
+    reloc.offset = offset;
+
+    auto emitHalf = [&](bool high)
+        {
+            reloc.word = static_cast<uint32_t>(m_words.size());
+            reloc.high = high;
+            m_relocations.push_back(reloc);
+
+            if (high)
+                Emit(highCmd, highArg);
+            else
+                Emit(lowCmd, 0);
+        };
+
+    bool highFirst = (lowCmd == GE_CMD_VADDR);
+    emitHalf(highFirst);
+    emitHalf(!highFirst);
+}
+
+void GeDisplayList::SetVertexType(uint32_t vtype, uint32_t stride)
+{
+    Emit(GE_CMD_VTYPE, vtype);
+    m_stride = stride;
+}
+
+void GeDisplayList::SetTexture(uint32_t textureId, const TextureFormat& format)
+{
+    if (m_textureEnabled != 1)
+    {
+        Emit(GE_CMD_TME, 1);
+        m_textureEnabled = 1;
+    }
+
+    if (textureId == m_textureId)
+        return;
+
+    m_textureId = textureId;
+
+    Emit(GE_CMD_TMODE, 0); // no swizzle, single level
+    Emit(GE_CMD_TPSM, static_cast<uint32_t>(format.psm));
+
+    if (format.clutEntries > 0)
+    {
+        // 8888 palette, full index mask; loaded in blocks of 8 entries.
+        Emit(GE_CMD_CMODE, 3u | (0xFFu << 8));
+        EmitAddress(GE_CMD_CBP, GE_CMD_CBW, 0, GeRelocTarget::Clut, textureId, 0);
+        Emit(GE_CMD_CLOAD, format.clutEntries / 8);
+    }
+
+    EmitAddress(GE_CMD_TBP0, GE_CMD_TBW0, format.bufferWidth, GeRelocTarget::Texture, textureId, 0);
+    Emit(GE_CMD_TSIZE0, (Log2(format.bufferHeight) << 8) | Log2(format.bufferWidth));
+    Emit(GE_CMD_TFUNC, 0x100); // modulate, RGBA
+    Emit(GE_CMD_TFLUSH, 0);
+}
+
+void GeDisplayList::DisableTexture()
+{
+    if (m_textureEnabled != 0)
+    {
+        Emit(GE_CMD_TME, 0);
+        m_textureEnabled = 0;
+    }
+}
+
+void GeDisplayList::SetMaterial(uint32_t rgba)
+{
+    if (m_hasMaterial && rgba == m_rgba)
+        return;
+
+    m_hasMaterial = true;
+    m_rgba = rgba;
+
+    Emit(GE_CMD_MATERIALAMBIENT, rgba & 0xFFFFFF);
+    Emit(GE_CMD_MATERIALDIFFUSE, rgba & 0xFFFFFF);
+    Emit(GE_CMD_MATERIALALPHA, rgba >> 24);
+
+    int blend = (rgba >> 24) != 0xFF ? 1 : 0;
+    if (blend != m_blendEnabled)
+    {
+        Emit(GE_CMD_ABE, static_cast<uint32_t>(blend));
+        m_blendEnabled = blend;
+    }
+}
+
+void GeDisplayList::DrawTriangles(uint32_t firstVertex, uint32_t vertexCount)
+{
+    // Keep batches whole triangles.
+    const uint32_t maxBatch = GE_PRIM_MAX_VERTICES - GE_PRIM_MAX_VERTICES % 3;
+
+    EmitAddress(GE_CMD_VADDR, GE_CMD_BASE, 0, GeRelocTarget::VertexBuffer, 0, firstVertex * m_stride);
+
+    // VADDR advances past the fetched vertices, so later batches need no
+    // new address.
+    while (vertexCount > 0)
+    {
+        uint32_t count = std::min(vertexCount, maxBatch);
+        Emit(GE_CMD_PRIM, (GE_PRIM_TRIANGLES << 16) | count);
+        vertexCount -= count;
+    }
+}
+
+void GeDisplayList::Return()
+{
+    Emit(GE_CMD_RET, 0);
+}
+
+const std::vector<uint32_t>& GeDisplayList::GetWords() const
+{
+    return m_words;
+}
+
+const std::vector<GeRelocation>& GeDisplayList::GetRelocations() const
+{
+    return m_relocations;
+}
+
+std::vector<char> GeDisplayList::BuildChunk() const
+{
+    std::vector<char> payload;
+    AppendU32(payload, m_stride);
+
+    AppendU32(payload, static_cast<uint32_t>(m_words.size()));
+    for (uint32_t word : m_words)
+        AppendU32(payload, word);
+
+    AppendU32(payload, static_cast<uint32_t>(m_relocations.size()));
+    for (const GeRelocation& reloc : m_relocations)
+    {
+        AppendU32(payload, reloc.word);
+        AppendU32(payload, static_cast<uint32_t>(reloc.target));
+        AppendU32(payload, reloc.index);
+        AppendU32(payload, reloc.offset);
+        AppendU32(payload, reloc.high ? 1 : 0);
+    }
+
+    return payload;
+}
+
+const char* GeDecoder::GetCommandName(uint32_t cmd)
+{
+    switch (cmd)
+    {
+    case GE_CMD_NOP: return "NOP";
+    case GE_CMD_VADDR: return "VADDR";
+    case GE_CMD_PRIM: return "PRIM";
+    case GE_CMD_JUMP: return "JUMP";
+    case GE_CMD_CALL: return "CALL";
+    case GE_CMD_RET: return "RET";
+    case GE_CMD_END: return "END";
+    case GE_CMD_FINISH: return "FINISH";
+    case GE_CMD_BASE: return "BASE";
+    case GE_CMD_VTYPE: return "VTYPE";
+    case GE_CMD_TME: return "TME";
+    case GE_CMD_ABE: return "ABE";
+    case GE_CMD_MATERIALAMBIENT: return "MATERIALAMBIENT";
+    case GE_CMD_MATERIALDIFFUSE: return "MATERIALDIFFUSE";
+    case GE_CMD_MATERIALALPHA: return "MATERIALALPHA";
+    case GE_CMD_TBP0: return "TBP0";
+    case GE_CMD_TBW0: return "TBW0";
+    case GE_CMD_CBP: return "CBP";
+    case GE_CMD_CBW: return "CBW";
+    case GE_CMD_TSIZE0: return "TSIZE0";
+    case GE_CMD_TMODE: return "TMODE";
+    case GE_CMD_TPSM: return "TPSM";
+    case GE_CMD_CLOAD: return "CLOAD";
+    case GE_CMD_CMODE: return "CMODE";
+    case GE_CMD_TFUNC: return "TFUNC";
+    case GE_CMD_TFLUSH: return "TFLUSH";
+    }
+    return nullptr;
+}
+
+bool GeDecoder::Validate(const std::vector<char>& payload, uint32_t vertexBufferSize, std::string& outError)
+{
+    ParsedList list;
+    if (!ParsePayload(payload, list))
+    {
+        outError = "malformed payload";
+        return false;
+    }
+
+    char buf[160];
+
+    // Every address word must be covered by exactly one relocation.
+    std::map<uint32_t, const GeRelocation*> relocByWord;
+    for (const GeRelocation& reloc : list.relocations)
+    {
+        if (reloc.word >= list.words.size())
+        {
+            std::snprintf(buf, sizeof(buf), "relocation outside list (word %u)", reloc.word);
+            outError = buf;
+            return false;
+        }
+
+        if ((list.words[reloc.word] >> 24) != ExpectedCommand(reloc))
+        {
+            std::snprintf(buf, sizeof(buf), "word %u: relocation does not patch %s", reloc.word,
+                GetCommandName(ExpectedCommand(reloc)));
+            outError = buf;
+            return false;
+        }
+
+        if (!relocByWord.emplace(reloc.word, &reloc).second)
+        {
+            std::snprintf(buf, sizeof(buf), "word %u: relocated twice", reloc.word);
+            outError = buf;
+            return false;
+        }
+    }
+
+    bool haveVtype = false;
+    bool haveVertexAddr = false;
+    bool textureOn = false;
+    bool haveTexAddr = false;
+    bool haveTexSize = false;
+    bool textureDirty = false;
+    uint32_t vertexOffset = 0;
+
+    for (uint32_t i = 0; i < list.words.size(); ++i)
+    {
+        uint32_t cmd = list.words[i] >> 24;
+        uint32_t arg = list.words[i] & 0xFFFFFF;
+
+        auto fail = [&](const char* what)
+            {
+                std::snprintf(buf, sizeof(buf), "word %u (%s): %s", i,
+                    GetCommandName(cmd) ? GetCommandName(cmd) : "?", what);
+                outError = buf;
+                return false;
+            };
+
+        if (!GetCommandName(cmd))
+            return fail("unknown command");
+
+        bool isAddress = cmd == GE_CMD_VADDR || cmd == GE_CMD_BASE ||
+            cmd == GE_CMD_TBP0 || cmd == GE_CMD_TBW0 || cmd == GE_CMD_CBP || cmd == GE_CMD_CBW;
+
+        if (isAddress && !relocByWord.count(i))
+            return fail("address is not relocatable");
+
+        switch (cmd)
+        {
+        case GE_CMD_VTYPE:
+            if (arg != GE_VTYPE_COOKED)
+                return fail("unexpected vertex type");
+            haveVtype = true;
+            break;
+
+        case GE_CMD_VADDR:
+        {
+            const GeRelocation* reloc = relocByWord[i];
+            if (reloc->offset % 4 != 0)
+                return fail("vertex address not word aligned");
+            vertexOffset = reloc->offset;
+            haveVertexAddr = true;
+            break;
+        }
+
+        case GE_CMD_TME:
+            textureOn = arg != 0;
+            break;
+
+        case GE_CMD_TBP0:
+            haveTexAddr = true;
+            textureDirty = true;
+            break;
+
+        case GE_CMD_TBW0:
+            if ((arg & 0xFFFF) == 0 || (arg & 0xFFFF) > 1024)
+                return fail("bad buffer width");
+            break;
+
+        case GE_CMD_TSIZE0:
+            if ((arg & 0xF) > 9 || ((arg >> 8) & 0xF) > 9)
+                return fail("texture larger than 512x512");
+            haveTexSize = true;
+            textureDirty = true;
+            break;
+
+        case GE_CMD_TPSM:
+            if (arg > static_cast<uint32_t>(GePixelFormat::PSM_T8))
+                return fail("unsupported pixel format");
+            textureDirty = true;
+            break;
+
+        case GE_CMD_TFLUSH:
+            textureDirty = false;
+            break;
+
+        case GE_CMD_PRIM:
+        {
+            uint32_t prim = (arg >> 16) & 0x7;
+            uint32_t count = arg & 0xFFFF;
+
+            if (!haveVtype)
+                return fail("PRIM before VTYPE");
+            if (!haveVertexAddr)
+                return fail("PRIM before VADDR");
+            if (prim == GE_PRIM_TRIANGLES && count % 3 != 0)
+                return fail("triangle list count not a multiple of 3");
+            if (textureOn && (!haveTexAddr || !haveTexSize))
+                return fail("texturing enabled without a texture");
+            if (textureOn && textureDirty)
+                return fail("texture state changed without TFLUSH");
+
+            uint64_t end = static_cast<uint64_t>(vertexOffset) + static_cast<uint64_t>(count) * list.stride;
+            if (end > vertexBufferSize)
+                return fail("vertex fetch past the end of the buffer");
+
+            vertexOffset = static_cast<uint32_t>(end);
+            break;
+        }
+
+        case GE_CMD_RET:
+        case GE_CMD_END:
+        case GE_CMD_FINISH:
+            if (i + 1 != list.words.size())
+                return fail("commands after the end of the list");
+            return true;
+
+        case GE_CMD_JUMP:
+        case GE_CMD_CALL:
+            return fail("cooked lists must not branch");
+
+        default:
+            break;
+        }
+    }
+
+    outError = "list does not end with RET/END/FINISH";
+    return false;
+}
+
+std::string GeDecoder::Disassemble(const std::vector<char>& payload)
+{
+    ParsedList list;
+    if (!ParsePayload(payload, list))
+        return "<malformed display list>\n";
+
+    std::map<uint32_t, const GeRelocation*> relocByWord;
+    for (const GeRelocation& reloc : list.relocations)
+        relocByWord[reloc.word] = &reloc;
+
+    std::string text;
+    char line[160];
+
+    for (uint32_t i = 0; i < list.words.size(); ++i)
+    {
+        uint32_t cmd = list.words[i] >> 24;
+        uint32_t arg = list.words[i] & 0xFFFFFF;
+        const char* name = GetCommandName(cmd);
+
+        int n = std::snprintf(line, sizeof(line), "%04u  %08X  %-16s", i, list.words[i], name ? name : "???");
+
+        switch (cmd)
+        {
+        case GE_CMD_PRIM:
+            n += std::snprintf(line + n, sizeof(line) - n, "type=%u count=%u", (arg >> 16) & 0x7, arg & 0xFFFF);
+            break;
+
+        case GE_CMD_VTYPE:
+            n += std::snprintf(line + n, sizeof(line) - n, "tex=%u col=%u nrm=%u pos=%u",
+                arg & 0x3, (arg >> 2) & 0x7, (arg >> 5) & 0x3, (arg >> 7) & 0x3);
+            break;
+
+        case GE_CMD_TSIZE0:
+            n += std::snprintf(line + n, sizeof(line) - n, "%ux%u", 1u << (arg & 0xF), 1u << ((arg >> 8) & 0xF));
+            break;
+
+        case GE_CMD_TBW0:
+        case GE_CMD_CBW:
+            n += std::snprintf(line + n, sizeof(line) - n, "width=%u", arg & 0xFFFF);
+            break;
+
+        default:
+            n += std::snprintf(line + n, sizeof(line) - n, "0x%06X", arg);
+            break;
+        }
+
+        auto it = relocByWord.find(i);
+        if (it != relocByWord.end())
+        {
+            const GeRelocation& reloc = *it->second;
+            std::snprintf(line + n, sizeof(line) - n, "  ; reloc %s[%u]+0x%X %s",
+                TargetName(reloc.target), reloc.index, reloc.offset, reloc.high ? "hi" : "lo");
+        }
+
+        text += line;
+        text += "\n";
+    }
+
+    return text;
+}
@@ -0,0 +1,987 @@
+#include "Exporters/LightmapBaker.h"
+#include "Exporters/TextureFormat.h"
+#include "Exporters/TriangleBVH.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Scene/SceneObject.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <thread>
+
+namespace
+{
+    constexpr uint32_t kChartPadding = 2;     // texels around each chart, filled by dilation
+    constexpr float kSurfaceOffset = 0.01f;   // ray origin lift off the surface
+    constexpr float kCoverageSlack = 0.75f;   // texels outside an edge still sampled
+    constexpr float kWeldGrid = 1e-4f;        // vertices this close share an edge
+    constexpr float kCoplanarCos = 0.9995f;   // normals within ~1.8 degrees
+    constexpr float kCoplanarDistance = 1e-3f; // world units off the chart plane
+
+    struct BakeRng
+    {
+        uint32_t state;
+
+        explicit BakeRng(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+        float Next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    uint32_t HashSeed(uint32_t a, uint32_t b, uint32_t c)
+    {
+        uint32_t h = a * 0x9E3779B1u;
+        h ^= b + 0x85EBCA77u + (h << 6) + (h >> 2);
+        h ^= c + 0xC2B2AE3Du + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    Vec3 Mul(const Vec3& a, const Vec3& b)
+    {
+        return Vec3(a.x * b.x, a.y * b.y, a.z * b.z);
+    }
+
+    Vec3 TriangleNormal(const WorldTriangle& tri)
+    {
+        return Normalize(Cross(tri.v[1] - tri.v[0], tri.v[2] - tri.v[0]));
+    }
+
+    // Both corners snapped to a grid, lower corner first, so the two
+    // triangles of a shared edge build the same key from float positions
+    // that went through different transforms.
+    using EdgeKey = std::array<int64_t, 6>;
+
+    EdgeKey MakeEdgeKey(const Vec3& a, const Vec3& b)
+    {
+        auto snap = [](const Vec3& v)
+            {
+                return std::array<int64_t, 3>{
+                    std::llround(v.x / kWeldGrid), std::llround(v.y / kWeldGrid), std::llround(v.z / kWeldGrid) };
+            };
+
+        std::array<int64_t, 3> sa = snap(a);
+        std::array<int64_t, 3> sb = snap(b);
+        if (sb < sa)
+            std::swap(sa, sb);
+
+        return { sa[0], sa[1], sa[2], sb[0], sb[1], sb[2] };
+    }
+
+    // Cosine-weighted direction around n.
+    Vec3 SampleHemisphere(const Vec3& n, BakeRng& rng)
+    {
+        float r1 = rng.Next();
+        float r2 = rng.Next();
+
+        float phi = 2.0f * PI * r1;
+        float r = std::sqrt(r2);
+
+        Vec3 helper = std::fabs(n.x) > 0.9f ? Vec3(0.0f, 1.0f, 0.0f) : Vec3(1.0f, 0.0f, 0.0f);
+        Vec3 t = Normalize(Cross(helper, n));
+        Vec3 b = Cross(n, t);
+
+        return Normalize(t * (r * std::cos(phi)) + b * (r * std::sin(phi)) + n * std::sqrt(1.0f - r2));
+    }
+
+    void ClosestOnSegment(float px, float py, float ax, float ay, float bx, float by,
+        float& outX, float& outY)
+    {
+        float dx = bx - ax;
+        float dy = by - ay;
+        float len2 = dx * dx + dy * dy;
+
+        float t = len2 > 0.0f ? ((px - ax) * dx + (py - ay) * dy) / len2 : 0.0f;
+        t = std::min(std::max(t, 0.0f), 1.0f);
+
+        outX = ax + dx * t;
+        outY = ay + dy * t;
+    }
+
+    // Closest point of the 2D triangle to p (p itself when inside).
+    void ClosestOnTriangle(float px, float py, const float (&tri)[3][2], float& outX, float& outY)
+    {
+        auto edge = [&](int a, int b)
+            {
+                return (tri[b][0] - tri[a][0]) * (py - tri[a][1]) - (tri[b][1] - tri[a][1]) * (px - tri[a][0]);
+            };
+
+        float e0 = edge(0, 1);
+        float e1 = edge(1, 2);
+        float e2 = edge(2, 0);
+
+        if ((e0 >= 0 && e1 >= 0 && e2 >= 0) || (e0 <= 0 && e1 <= 0 && e2 <= 0))
+        {
+            outX = px;
+            outY = py;
+            return;
+        }
+
+        float best = -1.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            float cx, cy;
+            ClosestOnSegment(px, py, tri[k][0], tri[k][1], tri[(k + 1) % 3][0], tri[(k + 1) % 3][1], cx, cy);
+
+            float d = (cx - px) * (cx - px) + (cy - py) * (cy - py);
+            if (best < 0.0f || d < best)
+            {
+                best = d;
+                outX = cx;
+                outY = cy;
+            }
+        }
+    }
+
+    uint8_t ToByte(float value)
+    {
+        value = std::min(std::max(value, 0.0f), 1.0f);
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    struct ColorBox
+    {
+        std::vector<uint32_t> colors; // packed RGB
+    };
+
+    int Channel(uint32_t rgb, int c)
+    {
+        return (rgb >> (c * 8)) & 0xFF;
+    }
+
+    // Median cut down to at most 256 entries.
+    std::vector<uint32_t> BuildPalette(std::vector<uint32_t> colors)
+    {
+        std::vector<ColorBox> boxes(1);
+        boxes[0].colors = std::move(colors);
+
+        while (boxes.size() < 256)
+        {
+            int bestBox = -1;
+            int bestAxis = 0;
+            int bestRange = 0;
+
+            for (size_t b = 0; b < boxes.size(); ++b)
+            {
+                if (boxes[b].colors.size() < 2)
+                    continue;
+
+                for (int c = 0; c < 3; ++c)
+                {
+                    int lo = 255, hi = 0;
+                    for (uint32_t rgb : boxes[b].colors)
+                    {
+                        lo = std::min(lo, Channel(rgb, c));
+                        hi = std::max(hi, Channel(rgb, c));
+                    }
+
+                    if (hi - lo > bestRange)
+                    {
+                        bestRange = hi - lo;
+                        bestBox = static_cast<int>(b);
+                        bestAxis = c;
+                    }
+                }
+            }
+
+            if (bestBox < 0)
+                break;
+
+            std::vector<uint32_t>& source = boxes[bestBox].colors;
+            size_t half = source.size() / 2;
+            std::nth_element(source.begin(), source.begin() + half, source.end(),
+                [&](uint32_t a, uint32_t b) { return Channel(a, bestAxis) < Channel(b, bestAxis); });
+
+            ColorBox upper;
+            upper.colors.assign(source.begin() + half, source.end());
+            source.resize(half);
+            boxes.push_back(std::move(upper));
+        }
+
+        std::vector<uint32_t> palette;
+        for (const ColorBox& box : boxes)
+        {
+            if (box.colors.empty())
+                continue;
+
+            uint64_t sum[3] = {};
+            for (uint32_t rgb : box.colors)
+                for (int c = 0; c < 3; ++c)
+                    sum[c] += Channel(rgb, c);
+
+            uint32_t n = static_cast<uint32_t>(box.colors.size());
+            palette.push_back(static_cast<uint32_t>(sum[0] / n) |
+                (static_cast<uint32_t>(sum[1] / n) << 8) |
+                (static_cast<uint32_t>(sum[2] / n) << 16));
+        }
+
+        if (palette.empty())
+            palette.push_back(0);
+
+        return palette;
+    }
+}
+
+std::vector<LightmapLight> LightmapBaker::CollectLights(const std::vector<const SceneObject*>& objects)
+{
+    std::vector<LightmapLight> lights;
+
+    for (const SceneObject* obj : objects)
+    {
+        if (!obj->def || !obj->def->def || obj->def->def->chunkType != GV_CHUNK_LIGHT)
+            continue;
+
+        const GV_Logic_Unit_Instance& inst = *obj->def;
+        LightmapLight light;
+
+        for (size_t i = 0; i < inst.values.size() && i < inst.def->params.size(); ++i)
+        {
+            const std::string& name = inst.def->params[i].name;
+            float value = inst.values[i].fval;
+
+            if (name == "posX") light.position.x = value;
+            else if (name == "posY") light.position.y = value;
+            else if (name == "posZ") light.position.z = value;
+            else if (name == "colorR") light.color.x = value;
+            else if (name == "colorG") light.color.y = value;
+            else if (name == "colorB") light.color.z = value;
+            else if (name == "intensity") light.intensity = value;
+            else if (name == "radius") light.radius = value;
+        }
+
+        lights.push_back(light);
+    }
+
+    return lights;
+}
+
+void LightmapBaker::PackCharts(const std::vector<WorldTriangle>& triangles)
+{
+    const uint32_t maxInner = std::min(m_settings.maxChartSize, m_settings.pageSize - 2 * kChartPadding);
+
+    // Widest a chart may grow at full texel density; a single triangle
+    // past this is scaled down instead.
+    const float maxExtent = static_cast<float>(maxInner - 1) / m_settings.texelsPerUnit;
+
+    std::map<EdgeKey, std::vector<uint32_t>> edges;
+    for (uint32_t t = 0; t < triangles.size(); ++t)
+        for (int k = 0; k < 3; ++k)
+            edges[MakeEdgeKey(triangles[t].v[k], triangles[t].v[(k + 1) % 3])].push_back(t);
+
+    m_charts.clear();
+    m_chartTriangles.clear();
+    m_chartTriangles.reserve(triangles.size());
+    m_triangles.assign(triangles.size(), LightmapTriangle{});
+
+    std::vector<bool> assigned(triangles.size(), false);
+
+    for (uint32_t seed = 0; seed < triangles.size(); ++seed)
+    {
+        if (assigned[seed])
+            continue;
+
+        const WorldTriangle& first = triangles[seed];
+        const uint32_t chartIndex = static_cast<uint32_t>(m_charts.size());
+
+        LightmapChart chart;
+        Vec3 e1 = first.v[1] - first.v[0];
+        chart.origin = first.v[0];
+        chart.normal = TriangleNormal(first);
+        chart.axisU = Length(e1) > 0.0f ? Normalize(e1) : Vec3(1.0f, 0.0f, 0.0f);
+        chart.axisV = Normalize(Cross(chart.normal, chart.axisU));
+        chart.firstTriangle = static_cast<uint32_t>(m_chartTriangles.size());
+
+        float maxU = 0.0f, maxV = 0.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            Vec3 d = first.v[k] - chart.origin;
+            chart.minU = std::min(chart.minU, Dot(d, chart.axisU));
+            chart.minV = std::min(chart.minV, Dot(d, chart.axisV));
+            maxU = std::max(maxU, Dot(d, chart.axisU));
+            maxV = std::max(maxV, Dot(d, chart.axisV));
+        }
+
+        assigned[seed] = true;
+        m_triangles[seed].chart = chartIndex;
+        m_chartTriangles.push_back(seed);
+
+        // Grow across shared edges while the neighbour lies in the seed's
+        // plane and the chart still fits at full density.
+        for (size_t q = chart.firstTriangle; q < m_chartTriangles.size(); ++q)
+        {
+            const WorldTriangle& tri = triangles[m_chartTriangles[q]];
+
+            for (int k = 0; k < 3; ++k)
+            {
+                auto it = edges.find(MakeEdgeKey(tri.v[k], tri.v[(k + 1) % 3]));
+
+                for (uint32_t other : it->second)
+                {
+                    const WorldTriangle& next = triangles[other];
+                    if (assigned[other] || next.objectIndex != first.objectIndex || next.partIndex != first.partIndex)
+                        continue;
+
+                    if (!(Dot(TriangleNormal(next), chart.normal) >= kCoplanarCos))
+                        continue;
+
+                    float lo[2] = { chart.minU, chart.minV };
+                    float hi[2] = { maxU, maxV };
+                    bool flat = true;
+
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        Vec3 d = next.v[c] - chart.origin;
+                        flat = flat && std::fabs(Dot(d, chart.normal)) <= kCoplanarDistance;
+
+                        float u = Dot(d, chart.axisU);
+                        float v = Dot(d, chart.axisV);
+                        lo[0] = std::min(lo[0], u);
+                        lo[1] = std::min(lo[1], v);
+                        hi[0] = std::max(hi[0], u);
+                        hi[1] = std::max(hi[1], v);
+                    }
+
+                    if (!flat || std::max(hi[0] - lo[0], hi[1] - lo[1]) > maxExtent)
+                        continue;
+
+                    chart.minU = lo[0];
+                    chart.minV = lo[1];
+                    maxU = hi[0];
+                    maxV = hi[1];
+
+                    assigned[other] = true;
+                    m_triangles[other].chart = chartIndex;
+                    m_chartTriangles.push_back(other);
+                }
+            }
+        }
+
+        chart.triangleCount = static_cast<uint32_t>(m_chartTriangles.size()) - chart.firstTriangle;
+
+        float extent = std::max(maxU - chart.minU, maxV - chart.minV);
+
+        chart.scale = m_settings.texelsPerUnit;
+        if (extent * chart.scale > static_cast<float>(maxInner - 1))
+            chart.scale = static_cast<float>(maxInner - 1) / extent;
+
+        uint32_t innerW = static_cast<uint32_t>(std::ceil((maxU - chart.minU) * chart.scale)) + 1;
+        uint32_t innerH = static_cast<uint32_t>(std::ceil((maxV - chart.minV) * chart.scale)) + 1;
+
+        chart.width = std::min(innerW, maxInner) + 2 * kChartPadding;
+        chart.height = std::min(innerH, maxInner) + 2 * kChartPadding;
+
+        m_charts.push_back(chart);
+    }
+
+    // Shelf packing. Charts of one object part stay together so a part
+    // usually ends up on a single page and draws with one texture.
+    std::vector<uint32_t> order(m_charts.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            const WorldTriangle& ta = triangles[m_chartTriangles[m_charts[a].firstTriangle]];
+            const WorldTriangle& tb = triangles[m_chartTriangles[m_charts[b].firstTriangle]];
+
+            if (ta.objectIndex != tb.objectIndex) return ta.objectIndex < tb.objectIndex;
+            if (ta.partIndex != tb.partIndex) return ta.partIndex < tb.partIndex;
+            if (m_charts[a].height != m_charts[b].height) return m_charts[a].height > m_charts[b].height;
+            return a < b;
+        });
+
+    uint32_t page = 0, x = 0, y = 0, shelf = 0;
+
+    for (uint32_t index : order)
+    {
+        LightmapChart& chart = m_charts[index];
+
+        if (x + chart.width > m_settings.pageSize)
+        {
+            y += shelf;
+            x = 0;
+            shelf = 0;
+        }
+
+        if (y + chart.height > m_settings.pageSize)
+        {
+            ++page;
+            x = y = shelf = 0;
+        }
+
+        chart.page = page;
+        chart.x = x;
+        chart.y = y;
+
+        x += chart.width;
+        shelf = std::max(shelf, chart.height);
+
+        for (uint32_t i = 0; i < chart.triangleCount; ++i)
+        {
+            const uint32_t t = m_chartTriangles[chart.firstTriangle + i];
+            const WorldTriangle& tri = triangles[t];
+
+            for (int k = 0; k < 3; ++k)
+            {
+                Vec3 d = tri.v[k] - chart.origin;
+                float tx = chart.x + kChartPadding + (Dot(d, chart.axisU) - chart.minU) * chart.scale;
+                float ty = chart.y + kChartPadding + (Dot(d, chart.axisV) - chart.minV) * chart.scale;
+
+                m_triangles[t].uv[k][0] = (tx + 0.5f) / m_settings.pageSize;
+                m_triangles[t].uv[k][1] = (ty + 0.5f) / m_settings.pageSize;
+            }
+        }
+    }
+
+    m_pages.assign(m_charts.empty() ? 0 : page + 1, Page{});
+}
+
+void LightmapBaker::Rasterize(const std::vector<WorldTriangle>& triangles)
+{
+    const uint32_t size = m_settings.pageSize;
+
+    for (Page& page : m_pages)
+        page.texels.assign(static_cast<size_t>(size) * size, Texel{});
+
+    m_coveredTexels = 0;
+
+    // Distance of each texel of the current chart to the triangle that
+    // claimed it; where triangles meet, the nearer one wins.
+    std::vector<float> claimed;
+
+    for (size_t c = 0; c < m_charts.size(); ++c)
+    {
+        const LightmapChart& chart = m_charts[c];
+        Page& page = m_pages[chart.page];
+
+        claimed.assign(static_cast<size_t>(chart.width) * chart.height, kCoverageSlack + 1.0f);
+
+        for (uint32_t i = 0; i < chart.triangleCount; ++i)
+        {
+            const WorldTriangle& tri = triangles[m_chartTriangles[chart.firstTriangle + i]];
+
+            float local[3][2];
+            float lo[2] = { 1e30f, 1e30f };
+            float hi[2] = { -1e30f, -1e30f };
+
+            for (int k = 0; k < 3; ++k)
+            {
+                Vec3 d = tri.v[k] - chart.origin;
+                local[k][0] = Dot(d, chart.axisU);
+                local[k][1] = Dot(d, chart.axisV);
+
+                for (int a = 0; a < 2; ++a)
+                {
+                    float texel = kChartPadding + (local[k][a] - (a ? chart.minV : chart.minU)) * chart.scale;
+                    lo[a] = std::min(lo[a], texel);
+                    hi[a] = std::max(hi[a], texel);
+                }
+            }
+
+            // Only the texels around this triangle, inside the chart.
+            const uint32_t x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(lo[0] - kCoverageSlack)));
+            const uint32_t y0 = static_cast<uint32_t>(std::max(0.0f, std::floor(lo[1] - kCoverageSlack)));
+            const uint32_t x1 = std::min(chart.width, static_cast<uint32_t>(std::max(0.0f, std::ceil(hi[0] + kCoverageSlack))) + 1);
+            const uint32_t y1 = std::min(chart.height, static_cast<uint32_t>(std::max(0.0f, std::ceil(hi[1] + kCoverageSlack))) + 1);
+
+            for (uint32_t ly = y0; ly < y1; ++ly)
+            {
+                for (uint32_t lx = x0; lx < x1; ++lx)
+                {
+                    float u = (static_cast<float>(lx) - kChartPadding) / chart.scale + chart.minU;
+                    float v = (static_cast<float>(ly) - kChartPadding) / chart.scale + chart.minV;
+
+                    float cu, cv;
+                    ClosestOnTriangle(u, v, local, cu, cv);
+
+                    float distance = std::sqrt((cu - u) * (cu - u) + (cv - v) * (cv - v)) * chart.scale;
+                    float& best = claimed[ly * chart.width + lx];
+                    if (distance > kCoverageSlack || distance >= best)
+                        continue;
+
+                    if (best > kCoverageSlack)
+                        ++m_coveredTexels;
+                    best = distance;
+
+                    Texel& texel = page.texels[(chart.y + ly) * size + chart.x + lx];
+                    texel.chart = static_cast<int32_t>(c);
+                    texel.position = chart.origin + chart.axisU * cu + chart.axisV * cv;
+                    texel.normal = chart.normal;
+                }
+            }
+        }
+    }
+}
+
+Vec3 LightmapBaker::DirectLight(const Vec3& position, const Vec3& normal,
+    const TriangleBVH& bvh,
+    const std::vector<LightmapLight>& lights) const
+{
+    Vec3 result;
+
+    for (const LightmapLight& light : lights)
+    {
+        Vec3 toLight = light.position - position;
+        float distance = Length(toLight);
+        if (distance <= 0.0f)
+            continue;
+
+        float ndl = Dot(normal, toLight * (1.0f / distance));
+        if (ndl <= 0.0f)
+            continue;
+
+        float attenuation;
+        if (light.radius > 0.0f)
+        {
+            float falloff = std::max(0.0f, 1.0f - distance / light.radius);
+            attenuation = falloff * falloff;
+        }
+        else
+        {
+            attenuation = 1.0f / std::max(distance * distance, 1.0f);
+        }
+
+        if (attenuation <= 0.0f)
+            continue;
+
+        if (bvh.Occluded(position + normal * kSurfaceOffset, light.position))
+            continue;
+
+        result = result + light.color * (light.intensity * ndl * attenuation);
+    }
+
+    return result;
+}
+
+void LightmapBaker::TraceTile(uint32_t pageIndex, uint32_t tileX, uint32_t tileY, uint32_t pass,
+    const std::vector<Vec3>& albedo,
+    const TriangleBVH& bvh,
+    const std::vector<LightmapLight>& lights)
+{
+    // Per-texel state is only touched by the thread that owns the tile.
+    const uint32_t size = m_settings.pageSize;
+    Page& page = m_pages[pageIndex];
+
+    uint32_t x1 = std::min(tileX + m_settings.tileSize, size);
+    uint32_t y1 = std::min(tileY + m_settings.tileSize, size);
+
+    for (uint32_t y = tileY; y < y1; ++y)
+    {
+        for (uint32_t x = tileX; x < x1; ++x)
+        {
+            Texel& texel = page.texels[y * size + x];
+            if (texel.chart < 0)
+                continue;
+
+            if (pass == 0)
+                texel.direct = DirectLight(texel.position, texel.normal, bvh, lights);
+
+            BakeRng rng(HashSeed(pageIndex, y * size + x, pass));
+            Vec3 origin = texel.position + texel.normal * kSurfaceOffset;
+
+            for (uint32_t s = 0; s < m_settings.samplesPerPass; ++s)
+            {
+                Vec3 dir = SampleHemisphere(texel.normal, rng);
+
+                float t = 0.0f;
+                uint32_t hitTriangle = 0;
+
+                if (bvh.Intersect(origin, dir, 1e30f, t, hitTriangle))
+                {
+                    Vec3 hitPos = origin + dir * t;
+                    Vec3 hitNormal = m_charts[m_triangles[hitTriangle].chart].normal;
+                    if (Dot(hitNormal, dir) > 0.0f)
+                        hitNormal = hitNormal * -1.0f;
+
+                    Vec3 bounce = DirectLight(hitPos, hitNormal, bvh, lights);
+                    texel.indirect = texel.indirect + Mul(albedo[hitTriangle], bounce);
+                }
+
+                ++texel.samples;
+            }
+        }
+    }
+}
+
+bool LightmapBaker::Bake(const std::vector<WorldTriangle>& triangles,
+    const std::vector<Vec3>& albedo,
+    const TriangleBVH& bvh,
+    const std::vector<LightmapLight>& lights,
+    const LightmapSettings& settings,
+    const LightmapProgress& progress)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_settings = settings;
+    m_passesDone = 0;
+    m_raysCast = 0;
+    m_passMs.clear();
+    m_charts.clear();
+    m_chartTriangles.clear();
+    m_triangles.clear();
+    m_pages.clear();
+
+    // A page has to hold one chart of at least 2x2 texels plus padding.
+    m_settings.tileSize = std::min(std::max(m_settings.tileSize, 1u), std::max(m_settings.pageSize, 1u));
+    m_settings.maxChartSize = std::max(m_settings.maxChartSize, 2u);
+    m_settings.passes = std::max(m_settings.passes, 1u);
+
+    if (m_settings.pageSize < 2 + 2 * kChartPadding || !(m_settings.texelsPerUnit > 0.0f))
+    {
+        std::cout << "[Lightmap] Page size " << m_settings.pageSize << " and "
+            << m_settings.texelsPerUnit << " texels per unit cannot hold a chart\n";
+        m_cancel = false;
+        return false;
+    }
+
+    if (lights.empty() || triangles.empty())
+    {
+        m_cancel = false;
+        return false;
+    }
+
+    PackCharts(triangles);
+    Rasterize(triangles);
+
+    struct Tile
+    {
+        uint32_t page, x, y;
+    };
+
+    std::vector<Tile> tiles;
+    for (uint32_t p = 0; p < m_pages.size(); ++p)
+        for (uint32_t y = 0; y < m_settings.pageSize; y += m_settings.tileSize)
+            for (uint32_t x = 0; x < m_settings.pageSize; x += m_settings.tileSize)
+                tiles.push_back({ p, x, y });
+
+    uint32_t threadCount = m_settings.threads ? m_settings.threads : std::thread::hardware_concurrency();
+    m_threadCount = std::max(1u, threadCount);
+
+    // Rays per texel per pass: indirect samples plus one shadow ray per
+    // light at the texel (first pass) and at every bounce hit.
+    const uint64_t raysPerTexelPass = m_settings.samplesPerPass * (1 + lights.size());
+
+    for (uint32_t pass = 0; pass < m_settings.passes; ++pass)
+    {
+        auto passStart = std::chrono::steady_clock::now();
+        std::atomic<size_t> next{ 0 };
+
+        auto worker = [&]()
+            {
+                for (;;)
+                {
+                    if (m_cancel)
+                        break;
+
+                    size_t index = next.fetch_add(1);
+                    if (index >= tiles.size())
+                        break;
+
+                    TraceTile(tiles[index].page, tiles[index].x, tiles[index].y, pass, albedo, bvh, lights);
+                }
+            };
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 1; t < m_threadCount; ++t)
+            threads.emplace_back(worker);
+
+        worker();
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        // A cancelled first pass leaves texels without direct light.
+        if (m_cancel && pass == 0)
+        {
+            m_pages.clear();
+            m_charts.clear();
+            m_chartTriangles.clear();
+            m_triangles.clear();
+            m_cancel = false;
+            return false;
+        }
+
+        m_raysCast += m_coveredTexels * raysPerTexelPass + (pass == 0 ? m_coveredTexels * lights.size() : 0);
+        m_passMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - passStart).count());
+        m_passesDone = pass + 1;
+
+        // Every pass ends with a complete lightmap, for the progress
+        // callback to show and for a cancel to keep.
+        Resolve();
+
+        if (m_cancel)
+            break;
+
+        if (progress && !progress(m_passesDone, m_settings.passes))
+            break;
+    }
+
+    m_cancel = false;
+    m_bakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+void LightmapBaker::Cancel()
+{
+    m_cancel = true;
+}
+
+void LightmapBaker::Resolve()
+{
+    const int size = static_cast<int>(m_settings.pageSize);
+
+    for (Page& page : m_pages)
+    {
+        std::vector<Vec3> indirect(page.texels.size());
+        for (size_t i = 0; i < page.texels.size(); ++i)
+            if (page.texels[i].samples > 0)
+                indirect[i] = page.texels[i].indirect * (1.0f / page.texels[i].samples);
+
+        // Denoise the indirect term only; direct light keeps its hard
+        // shadow edges. Neighbours are weighted by normal agreement so
+        // creases do not bleed.
+        page.color.assign(page.texels.size(), Vec3());
+        std::vector<bool> filled(page.texels.size(), false);
+
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                const Texel& texel = page.texels[y * size + x];
+                if (texel.chart < 0)
+                    continue;
+
+                Vec3 sum;
+                float weightSum = 0.0f;
+
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= size || ny >= size)
+                            continue;
+
+                        const Texel& other = page.texels[ny * size + nx];
+                        if (other.chart < 0)
+                            continue;
+
+                        float agree = std::max(0.0f, Dot(texel.normal, other.normal));
+                        float w = std::pow(agree, 8.0f) * ((dx == 0 && dy == 0) ? 2.0f : 1.0f);
+
+                        sum = sum + indirect[ny * size + nx] * w;
+                        weightSum += w;
+                    }
+                }
+
+                Vec3 smooth = weightSum > 0.0f ? sum * (1.0f / weightSum) : indirect[y * size + x];
+
+                page.color[y * size + x] = texel.direct + smooth + m_settings.ambient;
+                filled[y * size + x] = true;
+            }
+        }
+
+        // Dilate into the padding so bilinear filtering never reads
+        // unbaked texels.
+        for (uint32_t iteration = 0; iteration < kChartPadding + 1; ++iteration)
+        {
+            std::vector<bool> next = filled;
+
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    if (filled[y * size + x])
+                        continue;
+
+                    Vec3 sum;
+                    int count = 0;
+
+                    for (int dy = -1; dy <= 1; ++dy)
+                    {
+                        for (int dx = -1; dx <= 1; ++dx)
+                        {
+                            int nx = x + dx, ny = y + dy;
+                            if (nx < 0 || ny < 0 || nx >= size || ny >= size || !filled[ny * size + nx])
+                                continue;
+
+                            sum = sum + page.color[ny * size + nx];
+                            ++count;
+                        }
+                    }
+
+                    if (count > 0)
+                    {
+                        page.color[y * size + x] = sum * (1.0f / count);
+                        next[y * size + x] = true;
+                    }
+                }
+            }
+
+            filled.swap(next);
+        }
+    }
+}
+
+uint32_t LightmapBaker::GetPageCount() const
+{
+    return static_cast<uint32_t>(m_pages.size());
+}
+
+const std::vector<LightmapChart>& LightmapBaker::GetCharts() const
+{
+    return m_charts;
+}
+
+const std::vector<uint32_t>& LightmapBaker::GetChartTriangles() const
+{
+    return m_chartTriangles;
+}
+
+const std::vector<LightmapTriangle>& LightmapBaker::GetTriangles() const
+{
+    return m_triangles;
+}
+
+const std::vector<Vec3>& LightmapBaker::GetPage(uint32_t page) const
+{
+    return m_pages[page].color;
+}
+
+uint32_t LightmapBaker::GetPageSize() const
+{
+    return m_settings.pageSize;
+}
+
+std::vector<char> LightmapBaker::BuildTextureChunk(const std::string& name, const std::vector<Vec3>& color, uint32_t size)
+{
+    std::vector<uint32_t> packed(color.size());
+    for (size_t i = 0; i < color.size(); ++i)
+        packed[i] = ToByte(color[i].x) | (ToByte(color[i].y) << 8) | (ToByte(color[i].z) << 16);
+
+    std::vector<uint32_t> palette = BuildPalette(packed);
+
+    // Lightmaps are smooth; many texels share a colour, so cache lookups.
+    std::map<uint32_t, uint8_t> nearest;
+    std::vector<char> indices(packed.size());
+
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        auto it = nearest.find(packed[i]);
+        if (it == nearest.end())
+        {
+            int best = 0;
+            int bestDistance = -1;
+
+            for (size_t p = 0; p < palette.size(); ++p)
+            {
+                int d = 0;
+                for (int c = 0; c < 3; ++c)
+                {
+                    int delta = Channel(packed[i], c) - Channel(palette[p], c);
+                    d += delta * delta;
+                }
+
+                if (bestDistance < 0 || d < bestDistance)
+                {
+                    bestDistance = d;
+                    best = static_cast<int>(p);
+                }
+            }
+
+            it = nearest.emplace(packed[i], static_cast<uint8_t>(best)).first;
+        }
+
+        indices[i] = static_cast<char>(it->second);
+    }
+
+    std::vector<char> payload;
+    AppendString(payload, name);
+    AppendU32(payload, size);
+    AppendU32(payload, size);
+    AppendU32(payload, static_cast<uint32_t>(GePixelFormat::PSM_T8));
+
+    AppendU32(payload, 256);
+    for (uint32_t p = 0; p < 256; ++p)
+        AppendU32(payload, (p < palette.size() ? palette[p] : 0) | 0xFF000000u);
+
+    payload.insert(payload.end(), indices.begin(), indices.end());
+    return payload;
+}
+
+std::vector<char> LightmapBaker::BuildChunk() const
+{
+    std::vector<char> payload;
+    AppendU32(payload, static_cast<uint32_t>(m_pages.size()));
+    AppendU32(payload, m_settings.pageSize);
+
+    for (uint32_t p = 0; p < m_pages.size(); ++p)
+        AppendChunk(payload, GV_CHUNK_TEXTURE_NATIVE, GV_CHUNK_VERSION,
+            BuildTextureChunk("lightmap" + std::to_string(p), m_pages[p].color, m_settings.pageSize));
+
+    return payload;
+}
+
+std::vector<char> LightmapBaker::BuildMeshUVChunk(uint32_t objectIndex, uint32_t partCount,
+    const std::vector<WorldTriangle>& triangles,
+    const std::vector<uint32_t>& objectTriangles) const
+{
+    // Triangles were collected in part vertex order.
+    std::vector<std::vector<uint32_t>> parts(partCount);
+    for (uint32_t t : objectTriangles)
+        if (triangles[t].partIndex < partCount)
+            parts[triangles[t].partIndex].push_back(t);
+
+    std::vector<char> payload;
+    AppendU32(payload, objectIndex);
+    AppendU32(payload, partCount);
+
+    for (const std::vector<uint32_t>& list : parts)
+    {
+        AppendU32(payload, static_cast<uint32_t>(list.size()));
+
+        for (uint32_t t : list)
+        {
+            const LightmapTriangle& tri = m_triangles[t];
+            AppendU32(payload, m_charts[tri.chart].page);
+
+            for (int k = 0; k < 3; ++k)
+            {
+                AppendF32(payload, tri.uv[k][0]);
+                AppendF32(payload, tri.uv[k][1]);
+            }
+        }
+    }
+
+    return payload;
+}
+
+void LightmapBaker::Report(const std::string& sceneName) const
+{
+    uint64_t pageTexels = static_cast<uint64_t>(m_pages.size()) * m_settings.pageSize * m_settings.pageSize;
+    uint32_t coverage = pageTexels ? static_cast<uint32_t>(100 * m_coveredTexels / pageTexels) : 0;
+
+    std::cout << "[Lightmap] " << sceneName << ": " << m_triangles.size() << " triangles in "
+        << m_charts.size() << " charts on "
+        << m_pages.size() << " pages of " << m_settings.pageSize << "x" << m_settings.pageSize
+        << ", " << coverage << "% texel coverage\n";
+
+    std::cout << "[Lightmap] " << sceneName << ": " << m_passesDone << "/" << m_settings.passes
+        << " passes x " << m_settings.samplesPerPass << " samples, ~" << m_raysCast << " rays on "
+        << m_threadCount << " threads in " << static_cast<uint32_t>(m_bakeMs) << " ms";
+
+    if (m_passesDone < m_settings.passes)
+        std::cout << " (stopped early)";
+
+    std::cout << "\n";
+
+    for (size_t p = 0; p < m_passMs.size(); ++p)
+        std::cout << "  pass " << (p + 1) << ": " << static_cast<uint32_t>(m_passMs[p]) << " ms\n";
+}
@@ -0,0 +1,323 @@
+#include "Exporters/MaterialExporter.h"
+#include "Exporters/MeshCooker.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Material/MaterialParser.h"
+#include "GVFramework/Scene/SceneObject.h"
+#include "Renderer/GatherScene.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <filesystem>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    uint32_t ToByte(float value)
+    {
+        value = std::min(std::max(value, 0.0f), 1.0f);
+        return static_cast<uint32_t>(value * 255.0f + 0.5f);
+    }
+
+    uint32_t PackRGBA(const GV_Material& material)
+    {
+        return ToByte(material.diffuse[0]) |
+            (ToByte(material.diffuse[1]) << 8) |
+            (ToByte(material.diffuse[2]) << 16) |
+            (ToByte(material.alpha) << 24);
+    }
+
+    Vec3 TransformPoint(const Mat4& m, float x, float y, float z)
+    {
+        Vec4 p = m * Vec4(x, y, z, 1.0f);
+        return Vec3(p.x, p.y, p.z);
+    }
+
+    // Upper 3x3 only: exact for the rotation and uniform scale GatherScene builds.
+    Vec3 TransformNormal(const Mat4& m, float x, float y, float z)
+    {
+        Vec4 n = m * Vec4(x, y, z, 0.0f);
+        return Normalize(Vec3(n.x, n.y, n.z));
+    }
+}
+
+void MaterialExporter::Clear()
+{
+    m_materials.clear();
+    m_materialIds.clear();
+    m_textures.clear();
+    m_textureIds.clear();
+    m_libraries.clear();
+}
+
+void MaterialExporter::SetResourceRoot(const std::string& resourceRoot)
+{
+    m_resourceRoot = resourceRoot;
+}
+
+uint32_t MaterialExporter::RegisterTexture(const std::string& path)
+{
+    if (path.empty())
+        return GV_TEXTURE_NONE;
+
+    std::string name = fs::path(path).lexically_relative(m_resourceRoot).generic_string();
+    if (name.empty())
+        name = fs::path(path).generic_string();
+
+    auto it = m_textureIds.find(name);
+    if (it != m_textureIds.end())
+        return it->second;
+
+    uint32_t id = static_cast<uint32_t>(m_textures.size());
+    m_textures.push_back(name);
+    m_textureIds[name] = id;
+    return id;
+}
+
+uint32_t MaterialExporter::RegisterMaterial(const GV_Material& material)
+{
+    ExportMaterial out;
+    out.rgba = PackRGBA(material);
+    out.illum = static_cast<uint32_t>(material.illum);
+    out.textureId = RegisterTexture(material.texturePath);
+
+    // Names are deliberately not part of the key: two MTL entries that
+    // produce the same GE state are the same material.
+    auto key = std::make_tuple(out.rgba, out.illum, out.textureId);
+
+    auto it = m_materialIds.find(key);
+    if (it != m_materialIds.end())
+        return it->second;
+
+    out.id = static_cast<uint32_t>(m_materials.size());
+    m_materials.push_back(out);
+    m_materialIds[key] = out.id;
+    return out.id;
+}
+
+const GV_Material* MaterialExporter::FindMaterial(const std::string& library, const std::string& name)
+{
+    if (library.empty())
+        return nullptr;
+
+    auto it = m_libraries.find(library);
+    if (it == m_libraries.end())
+        it = m_libraries.emplace(library, MaterialParser::ParseFile(library)).first;
+
+    for (const GV_Material& material : it->second)
+        if (material.name == name)
+            return &material;
+
+    return nullptr;
+}
+
+const ExportMaterial& MaterialExporter::ResolveMaterial(const CookedMesh& mesh, size_t partIndex)
+{
+    static const GV_Material defaultMaterial;
+
+    const GV_Material* material = FindMaterial(mesh.materialLibrary, mesh.parts[partIndex].material);
+    if (!material)
+        material = &defaultMaterial;
+
+    return m_materials[RegisterMaterial(*material)];
+}
+
+template <typename Visit>
+void MaterialExporter::ForEachPart(
+    const std::vector<const SceneObject*>& objects,
+    MeshCache& meshes,
+    Visit&& visit)
+{
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        const SceneObject* obj = objects[i];
+        if (!obj->def)
+            continue;
+
+        std::string modelPath;
+        Mat4 model = GatherScene::BuildModelFromLogicUnit(obj->def.get(), m_resourceRoot, modelPath);
+
+        if (modelPath.empty())
+            continue;
+
+        const CookedMesh* mesh = meshes.Get(modelPath);
+        if (!mesh)
+            continue;
+
+        for (size_t p = 0; p < mesh->parts.size(); ++p)
+        {
+            if (mesh->parts[p].vertices.empty())
+                continue;
+
+            visit(static_cast<uint32_t>(i), static_cast<uint32_t>(p),
+                model, mesh->parts[p], ResolveMaterial(*mesh, p));
+        }
+    }
+}
+
+void MaterialExporter::CollectDrawItems(
+    const std::vector<const SceneObject*>& objects,
+    MeshCache& meshes,
+    WorldSectors& outSectors)
+{
+    ForEachPart(objects, meshes,
+        [&](uint32_t objectIndex, uint32_t partIndex, const Mat4& model,
+            const CookedSubMesh& part, const ExportMaterial& material)
+        {
+            WorldDrawItem item;
+            item.objectIndex = objectIndex;
+            item.partIndex = partIndex;
+            item.materialId = material.id;
+            item.textureId = material.textureId;
+            item.translucent = material.IsTranslucent();
+            item.vertexCount = static_cast<uint32_t>(part.vertices.size());
+
+            item.boundsMin = Vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+            item.boundsMax = Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+            for (const CookedVertex& v : part.vertices)
+            {
+                Vec3 w = TransformPoint(model, v.x, v.y, v.z);
+
+                item.boundsMin.x = std::min(item.boundsMin.x, w.x);
+                item.boundsMin.y = std::min(item.boundsMin.y, w.y);
+                item.boundsMin.z = std::min(item.boundsMin.z, w.z);
+                item.boundsMax.x = std::max(item.boundsMax.x, w.x);
+                item.boundsMax.y = std::max(item.boundsMax.y, w.y);
+                item.boundsMax.z = std::max(item.boundsMax.z, w.z);
+            }
+
+            outSectors.Add(item);
+        });
+}
+
+void MaterialExporter::CollectTriangles(
+    const std::vector<const SceneObject*>& objects,
+    MeshCache& meshes,
+    std::vector<WorldTriangle>& outTriangles)
+{
+    ForEachPart(objects, meshes,
+        [&](uint32_t objectIndex, uint32_t partIndex, const Mat4& model,
+            const CookedSubMesh& part, const ExportMaterial& material)
+        {
+            for (size_t v = 0; v + 2 < part.vertices.size(); v += 3)
+            {
+                WorldTriangle tri;
+                tri.objectIndex = objectIndex;
+                tri.partIndex = partIndex;
+                tri.firstVertex = static_cast<uint32_t>(v);
+                tri.materialId = material.id;
+                tri.translucent = material.IsTranslucent();
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const CookedVertex& cv = part.vertices[v + k];
+                    tri.v[k] = TransformPoint(model, cv.x, cv.y, cv.z);
+                    tri.n[k] = TransformNormal(model, cv.nx, cv.ny, cv.nz);
+                    tri.uv[k][0] = cv.u;
+                    tri.uv[k][1] = cv.v;
+                }
+
+                outTriangles.push_back(tri);
+            }
+        });
+}
+
+void MaterialExporter::SortSector(WorldSector& sector)
+{
+    // Translucent items still need a back-to-front pass at runtime; sorting
+    // them by state here only makes that pass cheaper when depths tie.
+    std::stable_sort(sector.items.begin(), sector.items.end(),
+        [](const WorldDrawItem& a, const WorldDrawItem& b)
+        {
+            return std::make_tuple(a.translucent, a.textureId, a.materialId, a.objectIndex, a.partIndex) <
+                std::make_tuple(b.translucent, b.textureId, b.materialId, b.objectIndex, b.partIndex);
+        });
+}
+
+StateChangeCount MaterialExporter::CountStateChanges(const std::vector<WorldDrawItem>& items)
+{
+    StateChangeCount count;
+
+    uint32_t texture = GV_TEXTURE_NONE;
+    uint32_t material = 0xFFFFFFFFu;
+    bool first = true;
+
+    for (const WorldDrawItem& item : items)
+    {
+        if (first || item.textureId != texture)
+            ++count.textures;
+
+        if (first || item.materialId != material)
+            ++count.materials;
+
+        texture = item.textureId;
+        material = item.materialId;
+        first = false;
+    }
+
+    return count;
+}
+
+std::vector<char> MaterialExporter::BuildMaterialChunk(const ExportMaterial& material) const
+{
+    std::vector<char> payload;
+    AppendU32(payload, material.id);
+    AppendU32(payload, material.rgba);
+    AppendU32(payload, material.illum);
+    AppendU32(payload, material.textureId);
+    AppendString(payload, material.textureId == GV_TEXTURE_NONE ? std::string() : m_textures[material.textureId]);
+    AppendU32(payload, material.IsTranslucent() ? 1 : 0); // flags
+    return payload;
+}
+
+std::vector<char> MaterialExporter::BuildSectorChunk(uint32_t sectorIndex, const WorldSector& sector) const
+{
+    std::vector<char> info;
+    AppendU32(info, sectorIndex);
+    AppendU32(info, static_cast<uint32_t>(sector.cellX));
+    AppendU32(info, static_cast<uint32_t>(sector.cellZ));
+    AppendF32(info, sector.boundsMin.x);
+    AppendF32(info, sector.boundsMin.y);
+    AppendF32(info, sector.boundsMin.z);
+    AppendF32(info, sector.boundsMax.x);
+    AppendF32(info, sector.boundsMax.y);
+    AppendF32(info, sector.boundsMax.z);
+
+    AppendU32(info, static_cast<uint32_t>(sector.items.size()));
+    for (const WorldDrawItem& item : sector.items)
+    {
+        AppendU32(info, item.objectIndex);
+        AppendU32(info, item.partIndex);
+        AppendU32(info, item.materialId);
+        AppendU32(info, item.vertexCount);
+    }
+
+    // Materials in first-use order, which after sorting is draw order.
+    std::vector<uint32_t> used;
+    std::set<uint32_t> seen;
+    for (const WorldDrawItem& item : sector.items)
+        if (seen.insert(item.materialId).second)
+            used.push_back(item.materialId);
+
+    std::vector<char> list;
+    AppendU32(list, static_cast<uint32_t>(used.size()));
+    for (uint32_t id : used)
+        AppendChunk(list, GV_CHUNK_MATERIAL, GV_CHUNK_VERSION, BuildMaterialChunk(m_materials[id]));
+
+    std::vector<char> payload;
+    AppendChunk(payload, GV_CHUNK_STRUCT, GV_CHUNK_VERSION, info);
+    AppendChunk(payload, GV_CHUNK_MATERIAL_LIST, GV_CHUNK_VERSION, list);
+    return payload;
+}
+
+const std::vector<ExportMaterial>& MaterialExporter::GetMaterials() const
+{
+    return m_materials;
+}
+
+const std::vector<std::string>& MaterialExporter::GetTextures() const
+{
+    return m_textures;
+}
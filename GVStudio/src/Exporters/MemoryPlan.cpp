@@ -0,0 +1,550 @@
+#include "Exporters/MemoryPlan.h"
+#include "Exporters/ExportTarget.h"
+#include "Exporters/MeshCooker.h"
+#include "Exporters/PerfectHash.h"
+#include "Exporters/TextureFormat.h"
+#include "Exporters/GeDisplayList.h"
+#include "Database/AssetDatabase.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+#include "GVFramework/Scene/SceneObject.h"
+
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    uint32_t AlignUp(uint32_t value, uint32_t align)
+    {
+        return (value + align - 1) & ~(align - 1);
+    }
+
+    uint64_t AlignUp64(uint64_t value, uint32_t align)
+    {
+        return (value + align - 1) & ~static_cast<uint64_t>(align - 1);
+    }
+
+    const char* NameHashLabel(uint32_t kind)
+    {
+        return kind == static_cast<uint32_t>(NameHashKind::Objects) ? "Object Names" : "Asset Names";
+    }
+
+    // Bounded little-endian reads over [at, end); a short read clears ok
+    // and every read after it returns zero.
+    struct Cursor
+    {
+        const char* data;
+        size_t at;
+        size_t end;
+        bool ok = true;
+
+        Cursor(const char* data, size_t begin, size_t end)
+            : data(data), at(begin), end(end)
+        {
+        }
+
+        bool Skip(uint64_t bytes)
+        {
+            if (!ok || end - at < bytes)
+                return ok = false;
+            at += static_cast<size_t>(bytes);
+            return true;
+        }
+
+        uint32_t U32()
+        {
+            if (!Skip(4))
+                return 0;
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(data + at - 4);
+            return static_cast<uint32_t>(p[0]) |
+                (static_cast<uint32_t>(p[1]) << 8) |
+                (static_cast<uint32_t>(p[2]) << 16) |
+                (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        std::string String()
+        {
+            const uint32_t length = U32();
+            const size_t start = at;
+            if (!Skip(AlignUp64(length, 4)))
+                return {};
+            return std::string(data + start, length);
+        }
+    };
+
+    const MemoryPlanEntry* FindSlot(const std::vector<MemoryPlanEntry>& entries,
+        MemoryPlanKind kind, const std::string& label)
+    {
+        for (const MemoryPlanEntry& entry : entries)
+            if (entry.kind == kind && entry.label == label)
+                return &entry;
+        return nullptr;
+    }
+
+    bool Fail(const std::string& error)
+    {
+        std::cout << "[MemoryPlan] Simulate: " << error << "\n";
+        return false;
+    }
+
+    // What the scene's chunks need from the arena, read from the chunks
+    // themselves rather than from the objects the plan was made from.
+    bool CheckScene(const std::vector<MemoryPlanEntry>& entries, const char* scene, size_t size)
+    {
+        uint32_t objects = 0;
+        std::map<std::string, std::pair<uint32_t, uint64_t>> pools; // instances, bytes each
+        uint64_t stringBytes = 0;
+        uint64_t eventBytes = 0;
+        std::map<std::string, std::pair<uint64_t, uint64_t>> names; // table, strings
+        std::map<std::string, uint64_t> meshes;
+        std::set<uint32_t> textures;
+        std::set<uint32_t> cluts;
+
+        ChunkReader reader(scene, size);
+        GV_ChunkView chunk;
+
+        while (reader.Next(chunk))
+        {
+            ChunkReader children = reader.Children(chunk);
+            GV_ChunkView child;
+
+            switch (chunk.type)
+            {
+            case GV_CHUNK_SCENE_OBJECT:
+                ++objects;
+
+                while (children.Next(child))
+                {
+                    if (child.type != GV_CHUNK_LOGIC_UNIT)
+                        continue;
+
+                    Cursor unit(scene, child.payload, child.GetEnd());
+                    const std::string typeName = unit.String();
+                    unit.U32(); // chunk type
+                    const uint32_t params = unit.U32();
+
+                    for (uint32_t p = 0; p < params && unit.ok; ++p)
+                    {
+                        if (unit.U32() == static_cast<uint32_t>(ParamType::String))
+                            stringBytes += unit.String().size() + 1;
+                        else
+                            unit.U32();
+                    }
+
+                    if (!unit.ok)
+                        return Fail(typeName + ": truncated logic unit");
+
+                    auto& pool = pools[typeName];
+                    pool.first += 1;
+                    pool.second = std::max<uint64_t>(pool.second, std::max<uint32_t>(params, 1) * 4ull);
+                }
+                break;
+
+            case GV_CHUNK_EVENT_TABLE:
+                eventBytes += chunk.size;
+                break;
+
+            case GV_CHUNK_NAME_HASH:
+            {
+                Cursor hash(scene, chunk.payload, chunk.GetEnd());
+                const uint32_t kind = hash.U32();
+                const uint32_t keys = hash.U32();
+                const uint32_t buckets = hash.U32();
+                hash.U32(); // global seed
+                hash.Skip(4 * (static_cast<uint64_t>(buckets) + 2 * static_cast<uint64_t>(keys)));
+                const uint32_t blob = hash.U32();
+                const size_t tableBytes = hash.at - chunk.payload;
+
+                if (!hash.Skip(blob) || hash.at != hash.end)
+                    return Fail(std::string(NameHashLabel(kind)) + ": truncated name hash");
+
+                names[NameHashLabel(kind)] = { tableBytes, blob };
+                break;
+            }
+
+            case GV_CHUNK_STATIC_MESH:
+            {
+                std::string name;
+                while (children.Next(child))
+                {
+                    Cursor part(scene, child.payload, child.GetEnd());
+
+                    if (child.type == GV_CHUNK_STRUCT)
+                    {
+                        name = part.String();
+                    }
+                    else if (child.type == GV_CHUNK_GEOMETRY)
+                    {
+                        meshes[name] += child.size;
+                    }
+                    else if (child.type == GV_CHUNK_NATIVEDATA_PLG)
+                    {
+                        part.U32(); // stride
+                        part.Skip(4 * static_cast<uint64_t>(part.U32()));
+                        const uint32_t count = part.U32();
+
+                        for (uint32_t r = 0; r < count && part.ok; ++r)
+                        {
+                            part.U32(); // word
+                            const uint32_t target = part.U32();
+                            const uint32_t index = part.U32();
+                            part.U32(); // offset
+                            part.U32(); // high
+                            if (target == static_cast<uint32_t>(GeRelocTarget::Texture))
+                                textures.insert(index);
+                            else if (target == static_cast<uint32_t>(GeRelocTarget::Clut))
+                                cluts.insert(index);
+                        }
+                    }
+
+                    if (!part.ok)
+                        return Fail(name + ": truncated mesh");
+                }
+                break;
+            }
+
+            default:
+                break;
+            }
+
+            if (!children.IsValid())
+                return Fail("truncated chunk 0x" + std::to_string(chunk.type));
+        }
+
+        if (!reader.IsValid())
+            return Fail("truncated scene");
+
+        // Every requirement against its slot.
+        uint32_t objectSlots = 0;
+        uint64_t stringSlot = 0;
+        uint64_t eventSlot = 0;
+        uint32_t textureSlots = 0;
+        uint32_t clutSlots = 0;
+
+        for (const MemoryPlanEntry& entry : entries)
+        {
+            if (entry.kind == MemoryPlanKind::ObjectArray)
+                objectSlots += entry.count;
+            else if (entry.kind == MemoryPlanKind::StringPool)
+                stringSlot += entry.size;
+            else if (entry.kind == MemoryPlanKind::EventTable)
+                eventSlot += entry.size;
+            else if (entry.kind == MemoryPlanKind::TextureBuffer)
+                ++textureSlots;
+            else if (entry.kind == MemoryPlanKind::ClutBuffer)
+                ++clutSlots;
+        }
+
+        if (objects > objectSlots)
+            return Fail(std::to_string(objects) + " objects, object array holds " + std::to_string(objectSlots));
+
+        for (const auto& [typeName, pool] : pools)
+        {
+            const MemoryPlanEntry* slot = FindSlot(entries, MemoryPlanKind::LogicUnitPool, typeName);
+            if (!slot || slot->count < pool.first || slot->elementSize < pool.second)
+                return Fail(typeName + ": " + std::to_string(pool.first) + " instances of "
+                    + std::to_string(pool.second) + " bytes do not fit the pool");
+        }
+
+        if (stringBytes > stringSlot)
+            return Fail(std::to_string(stringBytes) + " string bytes, pool holds " + std::to_string(stringSlot));
+
+        if (eventBytes > eventSlot)
+            return Fail(std::to_string(eventBytes) + " event table bytes, slot holds " + std::to_string(eventSlot));
+
+        for (const auto& [label, bytes] : names)
+        {
+            const MemoryPlanEntry* table = FindSlot(entries, MemoryPlanKind::NameHash, label);
+            const MemoryPlanEntry* strings = FindSlot(entries, MemoryPlanKind::NameStrings, label);
+            if (!table || !strings || table->size < bytes.first || strings->size < bytes.second)
+                return Fail(label + ": name hash does not fit its slots");
+        }
+
+        for (const auto& [name, bytes] : meshes)
+        {
+            const MemoryPlanEntry* slot = FindSlot(entries, MemoryPlanKind::MeshBuffer, name);
+            if (!slot || slot->size < bytes)
+                return Fail(name + ": " + std::to_string(bytes) + " vertex bytes do not fit the mesh buffer");
+        }
+
+        // Display lists name textures by project ID and the plan by file,
+        // so only the counts compare.
+        if (textures.size() > textureSlots || cluts.size() > clutSlots)
+            return Fail(std::to_string(textures.size()) + " textures and " + std::to_string(cluts.size())
+                + " CLUTs referenced, plan has " + std::to_string(textureSlots) + " and " + std::to_string(clutSlots));
+
+        return true;
+    }
+}
+
+MemoryPlan MemoryPlan::ForScene(
+    const std::vector<const SceneObject*>& objects,
+    const std::string& resourceRoot,
+    uint32_t eventTableSize,
+    MeshCache& meshes,
+    const ExportTargetInfo& target,
+    const PerfectHash* objectNames,
+    const PerfectHash* assetNames)
+{
+    MemoryPlan plan;
+
+    plan.Add(MemoryPlanKind::ObjectArray, "Objects",
+        static_cast<uint32_t>(objects.size()), target.objectRecordSize, 16);
+
+    // One pool per logic unit type; every non-separator param is one word
+    // (strings become offsets into the string pool, events become IDs).
+    std::map<std::string, std::pair<uint32_t, uint32_t>> pools;
+    uint32_t stringBytes = 0;
+
+    AssetDatabase assets;
+    assets.SetResourceRoot(resourceRoot);
+
+    for (const SceneObject* obj : objects)
+    {
+        if (!obj->def || !obj->def->def)
+            continue;
+
+        const GV_Logic_Unit& def = *obj->def->def;
+
+        uint32_t words = 0;
+        for (size_t i = 0; i < def.params.size(); ++i)
+        {
+            if (def.params[i].type == ParamType::Separator)
+                continue;
+
+            ++words;
+
+            if (def.params[i].type == ParamType::String && i < obj->def->values.size())
+                stringBytes += static_cast<uint32_t>(obj->def->values[i].sval.size()) + 1;
+        }
+
+        auto& pool = pools[def.typeName];
+        pool.first += 1;
+        pool.second = std::max<uint32_t>(words, 1) * 4;
+
+        assets.ProcessLogicUnitInstance(*obj->def);
+    }
+
+    for (const auto& [typeName, pool] : pools)
+        plan.Add(MemoryPlanKind::LogicUnitPool, typeName, pool.first, pool.second, 16);
+
+    if (stringBytes > 0)
+        plan.Add(MemoryPlanKind::StringPool, "Strings", 1, AlignUp(stringBytes, 4), 4);
+
+    if (eventTableSize > 0)
+        plan.Add(MemoryPlanKind::EventTable, "Events", 1, eventTableSize, 4);
+
+    // Name hashes are looked up in place, names included.
+    for (NameHashKind kind : { NameHashKind::Objects, NameHashKind::Assets })
+    {
+        const PerfectHash* hash = kind == NameHashKind::Objects ? objectNames : assetNames;
+        if (!hash)
+            continue;
+
+        const char* label = NameHashLabel(static_cast<uint32_t>(kind));
+        plan.Add(MemoryPlanKind::NameHash, label, 1, static_cast<uint32_t>(hash->GetTableBytes()), 4);
+        plan.Add(MemoryPlanKind::NameStrings, label, 1, static_cast<uint32_t>(hash->GetStringBytes()), 4);
+    }
+
+    std::set<std::string> textures;
+
+    for (const AssetEntry* entry : assets.GetAssetsByChunk(GV_CHUNK_STATIC_MESH))
+    {
+        std::string path = (fs::path(resourceRoot) / entry->path).string();
+
+        const CookedMesh* mesh = meshes.Get(path);
+        if (!mesh)
+            continue;
+
+        // Labelled as the mesh chunk names it.
+        plan.Add(MemoryPlanKind::MeshBuffer, fs::path(path).lexically_relative(resourceRoot).generic_string(),
+            static_cast<uint32_t>(mesh->GetVertexCount()), target.vertexStride, target.vertexAlign);
+
+        for (const std::string& tex : entry->dependencies)
+            textures.insert(tex);
+    }
+
+    for (GV_ChunkType type : { GV_CHUNK_TEXTURE, GV_CHUNK_HEIGHTMAP })
+        for (const AssetEntry* entry : assets.GetAssetsByChunk(type))
+            textures.insert((fs::path(resourceRoot) / entry->path).string());
+
+    for (const std::string& tex : textures)
+    {
+        TextureFormat format;
+        if (!TextureCooker::ReadFormat(tex, format))
+        {
+            std::cout << "[MemoryPlan] Cannot size texture: " << tex << "\n";
+            continue;
+        }
+
+        std::string label = fs::path(tex).filename().string();
+
+        plan.Add(MemoryPlanKind::TextureBuffer, label, 1, format.GetDataSize(), 16);
+
+        if (format.clutEntries > 0)
+            plan.Add(MemoryPlanKind::ClutBuffer, label, format.clutEntries, 4, 16);
+    }
+
+    plan.Finalize();
+    return plan;
+}
+
+void MemoryPlan::Add(MemoryPlanKind kind, const std::string& label,
+    uint32_t count, uint32_t elementSize, uint32_t align)
+{
+    MemoryPlanEntry entry;
+    entry.kind = kind;
+    entry.label = label;
+    entry.count = count;
+    entry.elementSize = elementSize;
+    entry.align = align;
+
+    // A size past 32 bits is clamped; Simulate() then rejects the plan.
+    const uint64_t size = AlignUp64(static_cast<uint64_t>(count) * elementSize, 4);
+    if (size > UINT32_MAX)
+        std::cout << "[MemoryPlan] " << label << ": " << size << " bytes overflow the arena\n";
+    entry.size = static_cast<uint32_t>(std::min<uint64_t>(size, UINT32_MAX));
+
+    m_entries.push_back(entry);
+}
+
+void MemoryPlan::Finalize()
+{
+    // Largest alignment first keeps padding to a minimum.
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+        [](const MemoryPlanEntry& a, const MemoryPlanEntry& b)
+        {
+            return a.align > b.align;
+        });
+
+    uint64_t offset = 0;
+    for (MemoryPlanEntry& entry : m_entries)
+    {
+        offset = AlignUp64(offset, entry.align);
+        entry.offset = static_cast<uint32_t>(std::min<uint64_t>(offset, UINT32_MAX));
+        offset += entry.size;
+    }
+
+    const uint64_t arena = AlignUp64(offset, kArenaAlign);
+    if (arena > UINT32_MAX)
+        std::cout << "[MemoryPlan] Arena of " << arena << " bytes overflows 32 bits\n";
+    m_arenaSize = static_cast<uint32_t>(std::min<uint64_t>(arena, UINT32_MAX));
+}
+
+uint32_t MemoryPlan::GetArenaSize() const
+{
+    return m_arenaSize;
+}
+
+const std::vector<MemoryPlanEntry>& MemoryPlan::GetEntries() const
+{
+    return m_entries;
+}
+
+std::vector<char> MemoryPlan::BuildChunk() const
+{
+    std::vector<char> payload;
+
+    AppendU32(payload, m_arenaSize);
+    AppendU32(payload, kArenaAlign);
+    AppendU32(payload, static_cast<uint32_t>(m_entries.size()));
+
+    for (const MemoryPlanEntry& entry : m_entries)
+    {
+        AppendU32(payload, static_cast<uint32_t>(entry.kind));
+        AppendU32(payload, entry.offset);
+        AppendU32(payload, entry.size);
+        AppendU32(payload, entry.align);
+        AppendU32(payload, entry.count);
+        AppendU32(payload, entry.elementSize);
+        AppendString(payload, entry.label);
+    }
+
+    return payload;
+}
+
+void MemoryPlan::Report(const std::string& sceneName) const
+{
+    static const char* kKindNames[] =
+    {
+        "Objects", "Pool", "Strings", "Events", "Mesh", "Texture", "CLUT", "Name Hash", "Names"
+    };
+
+    std::cout << "[MemoryPlan] " << sceneName << ": arena "
+        << m_arenaSize << " bytes, " << m_entries.size() << " allocations\n";
+
+    for (const MemoryPlanEntry& entry : m_entries)
+    {
+        std::cout << "  " << kKindNames[static_cast<uint32_t>(entry.kind)]
+            << " " << entry.label
+            << " @" << entry.offset
+            << " size " << entry.size
+            << " align " << entry.align << "\n";
+    }
+}
+
+bool MemoryPlan::Simulate(const std::vector<char>& payload, const char* scene, size_t sceneSize)
+{
+    Cursor plan(payload.data(), 0, payload.size());
+    const uint32_t arenaSize = plan.U32();
+    const uint32_t arenaAlign = plan.U32();
+    const uint32_t count = plan.U32();
+
+    if (!plan.ok)
+        return Fail("truncated plan");
+
+    if (arenaAlign == 0 || (arenaAlign & (arenaAlign - 1)) != 0)
+        return Fail("bad arena alignment " + std::to_string(arenaAlign));
+
+    std::vector<MemoryPlanEntry> entries;
+    uint64_t cursor = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        MemoryPlanEntry entry;
+        const uint32_t kind = plan.U32();
+        entry.kind = static_cast<MemoryPlanKind>(kind);
+        entry.offset = plan.U32();
+        entry.size = plan.U32();
+        entry.align = plan.U32();
+        entry.count = plan.U32();
+        entry.elementSize = plan.U32();
+        entry.label = plan.String();
+
+        if (!plan.ok)
+            return Fail("truncated plan at allocation " + std::to_string(i));
+
+        if (kind > static_cast<uint32_t>(MemoryPlanKind::NameStrings))
+            return Fail(entry.label + " has unknown kind " + std::to_string(kind));
+
+        // The runtime aligns the arena base to arenaAlign, so an offset
+        // aligned to anything no larger is aligned in memory too.
+        if (entry.align == 0 || (entry.align & (entry.align - 1)) != 0 || entry.align > arenaAlign)
+            return Fail(entry.label + " has bad alignment " + std::to_string(entry.align));
+
+        cursor = AlignUp64(cursor, entry.align);
+
+        if (cursor != entry.offset)
+            return Fail(entry.label + " planned at " + std::to_string(entry.offset)
+                + " but carved at " + std::to_string(cursor));
+
+        if (entry.size < static_cast<uint64_t>(entry.count) * entry.elementSize ||
+            static_cast<uint64_t>(entry.offset) + entry.size > arenaSize)
+            return Fail(entry.label + " does not fit");
+
+        cursor += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    if (plan.at != plan.end)
+        return Fail(std::to_string(plan.end - plan.at) + " bytes after the last allocation");
+
+    return CheckScene(entries, scene, sceneSize);
+}
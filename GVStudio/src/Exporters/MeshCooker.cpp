@@ -0,0 +1,377 @@
+#include "Exporters/MeshCooker.h"
+#include "Exporters/ExportTarget.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "MiniMath/MiniMath.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct FaceCorner
+    {
+        int v = 0;
+        int t = 0;
+        int n = 0;
+    };
+
+    // OBJ indices are 1-based; negative indices count back from the end.
+    int ResolveIndex(int index, size_t count)
+    {
+        if (index > 0)
+            return index - 1;
+        if (index < 0)
+            return static_cast<int>(count) + index;
+        return -1;
+    }
+
+    bool ParseCorner(const char*& p, FaceCorner& out)
+    {
+        char* end = nullptr;
+
+        out = FaceCorner{};
+        out.v = static_cast<int>(std::strtol(p, &end, 10));
+        if (end == p)
+            return false;
+        p = end;
+
+        if (*p == '/')
+        {
+            ++p;
+            if (*p != '/')
+            {
+                out.t = static_cast<int>(std::strtol(p, &end, 10));
+                p = end;
+            }
+            if (*p == '/')
+            {
+                ++p;
+                out.n = static_cast<int>(std::strtol(p, &end, 10));
+                p = end;
+            }
+        }
+
+        return true;
+    }
+
+    // Chunk payloads are little-endian on every target.
+    void StoreF32(char* dest, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        dest[0] = static_cast<char>(bits);
+        dest[1] = static_cast<char>(bits >> 8);
+        dest[2] = static_cast<char>(bits >> 16);
+        dest[3] = static_cast<char>(bits >> 24);
+    }
+
+    std::string ReadRestOfLine(const std::string& line, size_t start)
+    {
+        size_t first = line.find_first_not_of(" \t", start);
+        size_t last = line.find_last_not_of(" \t\r\n");
+        if (first == std::string::npos || last < first)
+            return {};
+        return line.substr(first, last - first + 1);
+    }
+}
+
+size_t CookedMesh::GetVertexCount() const
+{
+    size_t count = 0;
+    for (const CookedSubMesh& part : parts)
+        count += part.vertices.size();
+    return count;
+}
+
+namespace MeshCooker
+{
+    bool CookObj(const std::string& path, CookedMesh& outMesh)
+    {
+        outMesh = CookedMesh{};
+        outMesh.path = path;
+
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            std::cout << "[MeshCooker] Cannot open: " << path << "\n";
+            return false;
+        }
+
+        std::vector<Vec3> positions;
+        std::vector<Vec3> normals;
+        std::vector<float> uvs;
+
+        std::map<std::string, size_t> partIndex;
+        CookedSubMesh* current = nullptr;
+
+        auto selectPart = [&](const std::string& material)
+            {
+                auto it = partIndex.find(material);
+                if (it == partIndex.end())
+                {
+                    it = partIndex.emplace(material, outMesh.parts.size()).first;
+                    outMesh.parts.emplace_back();
+                    outMesh.parts.back().material = material;
+                }
+                current = &outMesh.parts[it->second];
+            };
+
+        std::string line;
+        std::vector<FaceCorner> corners;
+
+        while (std::getline(file, line))
+        {
+            const char* p = line.c_str();
+            char* end = nullptr;
+
+            if (line.rfind("v ", 0) == 0)
+            {
+                p += 2;
+                Vec3 v;
+                v.x = std::strtof(p, &end); p = end;
+                v.y = std::strtof(p, &end); p = end;
+                v.z = std::strtof(p, &end);
+                positions.push_back(v);
+            }
+            else if (line.rfind("vt ", 0) == 0)
+            {
+                p += 3;
+                float u = std::strtof(p, &end); p = end;
+                float v = std::strtof(p, &end);
+                uvs.push_back(u);
+                uvs.push_back(v);
+            }
+            else if (line.rfind("vn ", 0) == 0)
+            {
+                p += 3;
+                Vec3 n;
+                n.x = std::strtof(p, &end); p = end;
+                n.y = std::strtof(p, &end); p = end;
+                n.z = std::strtof(p, &end);
+                normals.push_back(n);
+            }
+            else if (line.rfind("mtllib ", 0) == 0)
+            {
+                fs::path mtl = fs::path(path).parent_path() / ReadRestOfLine(line, 7);
+                outMesh.materialLibrary = mtl.string();
+            }
+            else if (line.rfind("usemtl ", 0) == 0)
+            {
+                selectPart(ReadRestOfLine(line, 7));
+            }
+            else if (line.rfind("f ", 0) == 0)
+            {
+                p += 2;
+                corners.clear();
+
+                FaceCorner corner;
+                while (*p)
+                {
+                    while (*p == ' ' || *p == '\t')
+                        ++p;
+                    if (!*p || *p == '\r' || *p == '\n')
+                        break;
+                    if (!ParseCorner(p, corner))
+                        break;
+                    corners.push_back(corner);
+                }
+
+                if (corners.size() < 3)
+                    continue;
+
+                if (!current)
+                    selectPart("default");
+
+                for (size_t i = 1; i + 1 < corners.size(); ++i)
+                {
+                    const FaceCorner tri[3] = { corners[0], corners[i], corners[i + 1] };
+
+                    Vec3 pos[3];
+                    bool valid = true;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        int pi = ResolveIndex(tri[k].v, positions.size());
+                        if (pi < 0 || pi >= static_cast<int>(positions.size()))
+                        {
+                            valid = false;
+                            break;
+                        }
+                        pos[k] = positions[pi];
+                    }
+
+                    if (!valid)
+                        continue;
+
+                    Vec3 faceNormal = Normalize(Cross(pos[1] - pos[0], pos[2] - pos[0]));
+
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        CookedVertex vert{};
+                        vert.x = pos[k].x;
+                        vert.y = pos[k].y;
+                        vert.z = pos[k].z;
+
+                        int ti = ResolveIndex(tri[k].t, uvs.size() / 2);
+                        if (ti >= 0 && ti < static_cast<int>(uvs.size() / 2))
+                        {
+                            vert.u = uvs[ti * 2 + 0];
+                            vert.v = uvs[ti * 2 + 1];
+                        }
+
+                        Vec3 n = faceNormal;
+                        int ni = ResolveIndex(tri[k].n, normals.size());
+                        if (ni >= 0 && ni < static_cast<int>(normals.size()))
+                            n = normals[ni];
+
+                        vert.nx = n.x;
+                        vert.ny = n.y;
+                        vert.nz = n.z;
+
+                        current->vertices.push_back(vert);
+                    }
+                }
+            }
+        }
+
+        std::cout << "[MeshCooker] Cooked " << path << ": "
+            << outMesh.parts.size() << " parts, "
+            << outMesh.GetVertexCount() << " vertices\n";
+
+        return true;
+    }
+}
+
+const CookedMesh* MeshCache::Get(const std::string& path)
+{
+    auto it = m_meshes.find(path);
+    if (it == m_meshes.end())
+    {
+        auto mesh = std::make_unique<CookedMesh>();
+        if (!MeshCooker::CookObj(path, *mesh))
+            mesh.reset();
+
+        it = m_meshes.emplace(path, std::move(mesh)).first;
+    }
+
+    return it->second.get();
+}
+
+void MeshCache::Clear()
+{
+    m_meshes.clear();
+}
+
+void MeshCache::CookAll(const std::vector<std::string>& paths, uint32_t threads)
+{
+    std::vector<std::string> pending;
+    for (const std::string& path : paths)
+        if (m_meshes.find(path) == m_meshes.end())
+            pending.push_back(path);
+
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    if (pending.empty())
+        return;
+
+    std::vector<std::unique_ptr<CookedMesh>> cooked(pending.size());
+    std::atomic<size_t> next{ 0 };
+
+    auto worker = [&]()
+        {
+            for (size_t i = next++; i < pending.size(); i = next++)
+            {
+                auto mesh = std::make_unique<CookedMesh>();
+                if (MeshCooker::CookObj(pending[i], *mesh))
+                    cooked[i] = std::move(mesh);
+            }
+        };
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<uint32_t>(threads, static_cast<uint32_t>(pending.size()));
+
+    std::vector<std::thread> pool;
+    for (uint32_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    for (size_t i = 0; i < pending.size(); ++i)
+        m_meshes.emplace(pending[i], std::move(cooked[i]));
+}
+
+template<typename Target>
+std::vector<char> MeshCooker::BuildVertexData(const CookedMesh& mesh)
+{
+    std::vector<char> data(mesh.GetVertexCount() * sizeof(CookedVertex));
+    char* out = data.data();
+
+    auto store = [&](const float (&fields)[8])
+        {
+            for (float f : fields)
+            {
+                StoreF32(out, f);
+                out += 4;
+            }
+        };
+
+    for (const CookedSubMesh& part : mesh.parts)
+    {
+        for (const CookedVertex& v : part.vertices)
+        {
+            if constexpr (Target::vertexLayout == VertexLayout::GeTexNormalPos)
+                store({ v.u, v.v, v.nx, v.ny, v.nz, v.x, v.y, v.z });
+            else
+                store({ v.x, v.y, v.z, v.nx, v.ny, v.nz, v.u, v.v });
+        }
+    }
+
+    return data;
+}
+
+template std::vector<char> MeshCooker::BuildVertexData<PspTarget>(const CookedMesh& mesh);
+template std::vector<char> MeshCooker::BuildVertexData<Pc64Target>(const CookedMesh& mesh);
+
+GeDisplayList MeshCooker::BuildDisplayList(const CookedMesh& mesh, const std::vector<CookedPartState>& states)
+{
+    GeDisplayList list;
+    list.SetVertexType(GE_VTYPE_COOKED, sizeof(CookedVertex));
+
+    uint32_t firstVertex = 0;
+
+    for (size_t p = 0; p < mesh.parts.size(); ++p)
+    {
+        const CookedSubMesh& part = mesh.parts[p];
+        uint32_t count = static_cast<uint32_t>(part.vertices.size());
+
+        if (count == 0)
+            continue;
+
+        const CookedPartState& state = states[p];
+
+        if (state.textureId != GV_TEXTURE_NONE)
+            list.SetTexture(state.textureId, state.texture);
+        else
+            list.DisableTexture();
+
+        list.SetMaterial(state.rgba);
+        list.DrawTriangles(firstVertex, count);
+
+        firstVertex += count;
+    }
+
+    list.Return();
+    return list;
+}
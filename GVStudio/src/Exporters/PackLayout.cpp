@@ -0,0 +1,375 @@
+#include "Exporters/PackLayout.h"
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+PackLayout::PackLayout(const UmdCostModel& model)
+    : m_model(model)
+{
+}
+
+uint32_t PackLayout::AddFile(const std::string& name, const std::string& sourcePath)
+{
+    for (size_t i = 0; i < m_files.size(); ++i)
+        if (m_files[i].name == name)
+            return static_cast<uint32_t>(i);
+
+    PackFile file;
+    file.name = name;
+    file.sourcePath = sourcePath;
+
+    std::error_code ec;
+    uintmax_t size = fs::file_size(sourcePath, ec);
+    file.size = ec ? 0 : static_cast<uint32_t>(size);
+
+    if (ec)
+        std::cout << "[PackLayout] Missing file: " << sourcePath << "\n";
+
+    m_files.push_back(file);
+    return static_cast<uint32_t>(m_files.size() - 1);
+}
+
+void PackLayout::RecordScene(const std::string& sceneName, const std::vector<uint32_t>& needOrder)
+{
+    PackSceneTrace trace;
+    trace.sceneName = sceneName;
+
+    // A scene reads each file once, at its first use.
+    std::set<uint32_t> seen;
+    for (uint32_t f : needOrder)
+        if (seen.insert(f).second)
+            trace.needOrder.push_back(f);
+
+    m_scenes.push_back(std::move(trace));
+}
+
+uint32_t PackLayout::AlignToSector(uint32_t value) const
+{
+    const uint32_t sector = m_model.sectorSize;
+    return (value + sector - 1) / sector * sector;
+}
+
+double PackLayout::SeekMs(uint32_t from, uint32_t to) const
+{
+    const double travel = std::abs(static_cast<double>(to) - static_cast<double>(from));
+    return m_model.seekMs + m_model.seekMsPerMB * travel / (1024.0 * 1024.0);
+}
+
+void PackLayout::Build()
+{
+    BuildNaive();
+    BuildSequential();
+}
+
+void PackLayout::BuildNaive()
+{
+    // Baseline: one copy of every file in name order, as a plain
+    // filesystem image would store them.
+    m_naive = Layout{};
+
+    std::vector<uint32_t> order(m_files.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = static_cast<uint32_t>(i);
+
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            return m_files[a].name < m_files[b].name;
+        });
+
+    std::vector<uint32_t> placementOf(m_files.size(), 0);
+    uint32_t offset = 0;
+
+    for (uint32_t f : order)
+    {
+        placementOf[f] = static_cast<uint32_t>(m_naive.placements.size());
+        m_naive.placements.push_back({ f, offset });
+        offset = AlignToSector(offset + m_files[f].size);
+    }
+
+    m_naive.size = offset;
+
+    for (const PackSceneTrace& scene : m_scenes)
+    {
+        std::vector<uint32_t> reads;
+        for (uint32_t f : scene.needOrder)
+            reads.push_back(placementOf[f]);
+        m_naive.reads.push_back(std::move(reads));
+    }
+}
+
+void PackLayout::PlaceScenes(const std::vector<std::vector<char>>& copy, Layout& layout,
+    std::vector<uint32_t>& sceneStart) const
+{
+    layout = Layout{};
+    sceneStart.assign(m_scenes.size(), 0);
+
+    std::vector<int> firstPlacement(m_files.size(), -1);
+    uint32_t offset = 0;
+
+    for (size_t s = 0; s < m_scenes.size(); ++s)
+    {
+        const PackSceneTrace& scene = m_scenes[s];
+        std::vector<uint32_t> reads;
+        sceneStart[s] = offset;
+
+        for (size_t n = 0; n < scene.needOrder.size(); ++n)
+        {
+            const uint32_t f = scene.needOrder[n];
+
+            if (firstPlacement[f] >= 0 && !copy[s][n])
+            {
+                reads.push_back(static_cast<uint32_t>(firstPlacement[f]));
+                continue;
+            }
+
+            uint32_t index = static_cast<uint32_t>(layout.placements.size());
+            layout.placements.push_back({ f, offset });
+            offset = AlignToSector(offset + m_files[f].size);
+
+            if (firstPlacement[f] < 0)
+                firstPlacement[f] = static_cast<int>(index);
+
+            reads.push_back(index);
+        }
+
+        layout.reads.push_back(std::move(reads));
+    }
+
+    // Files no scene asked for go at the end.
+    for (size_t f = 0; f < m_files.size(); ++f)
+    {
+        if (firstPlacement[f] >= 0)
+            continue;
+
+        layout.placements.push_back({ static_cast<uint32_t>(f), offset });
+        offset = AlignToSector(offset + m_files[f].size);
+    }
+
+    layout.size = offset;
+}
+
+void PackLayout::BuildSequential()
+{
+    std::vector<std::vector<char>> copy(m_scenes.size());
+    for (size_t s = 0; s < m_scenes.size(); ++s)
+        copy[s].assign(m_scenes[s].needOrder.size(), 0);
+
+    std::vector<uint32_t> sceneStart;
+    Layout shared;
+    PlaceScenes(copy, shared, sceneStart);
+
+    // A run of files a scene finds in an earlier scene's area costs a seek
+    // there and a seek back; both cost the same transfer. Copying the run
+    // inline saves the two seeks for the run's size in disc space.
+    struct Run
+    {
+        size_t scene = 0;
+        size_t first = 0;
+        size_t last = 0;
+        uint32_t bytes = 0;
+        double savedMs = 0.0;
+    };
+
+    std::vector<Run> runs;
+
+    for (size_t s = 0; s < m_scenes.size(); ++s)
+    {
+        const std::vector<uint32_t>& reads = shared.reads[s];
+        uint32_t head = sceneStart[s];
+
+        for (size_t n = 0; n < reads.size();)
+        {
+            const PackPlacement& placement = shared.placements[reads[n]];
+            if (placement.offset >= sceneStart[s])
+            {
+                head = AlignToSector(placement.offset + m_files[placement.fileIndex].size);
+                ++n;
+                continue;
+            }
+
+            Run run;
+            run.scene = s;
+            run.first = n;
+            uint32_t end = placement.offset;
+
+            // Files the earlier scene stored back to back are one read.
+            while (n < reads.size())
+            {
+                const PackPlacement& next = shared.placements[reads[n]];
+                if (next.offset >= sceneStart[s] || next.offset != end)
+                    break;
+
+                end = AlignToSector(next.offset + m_files[next.fileIndex].size);
+                run.bytes += end - next.offset;
+                run.last = n++;
+            }
+
+            // The scene's first read seeks wherever it is; only a read
+            // that follows comes back.
+            if (run.first > 0)
+                run.savedMs += SeekMs(head, placement.offset);
+            if (n < reads.size())
+                run.savedMs += SeekMs(end, head);
+
+            runs.push_back(run);
+        }
+    }
+
+    std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b)
+        {
+            return a.savedMs * std::max<uint32_t>(b.bytes, 1) > b.savedMs * std::max<uint32_t>(a.bytes, 1);
+        });
+
+    uint64_t budget = m_model.duplicateMaxBytes;
+    for (const Run& run : runs)
+    {
+        if (run.savedMs <= 0.0 || run.bytes > budget)
+            continue;
+
+        budget -= run.bytes;
+        for (size_t n = run.first; n <= run.last; ++n)
+            copy[run.scene][n] = 1;
+    }
+
+    PlaceScenes(copy, m_optimized, sceneStart);
+}
+
+PackSimResult PackLayout::Simulate(const Layout& layout, size_t sceneIndex) const
+{
+    PackSimResult result;
+
+    const double msPerByte = 1000.0 / (m_model.transferKBps * 1024.0);
+    bool headKnown = false;
+    uint32_t head = 0;
+
+    for (uint32_t p : layout.reads[sceneIndex])
+    {
+        const PackPlacement& placement = layout.placements[p];
+        const PackFile& file = m_files[placement.fileIndex];
+
+        if (!headKnown || placement.offset != head)
+        {
+            double travel = headKnown
+                ? std::abs(static_cast<double>(placement.offset) - static_cast<double>(head))
+                : 0.0;
+
+            result.ms += m_model.seekMs + m_model.seekMsPerMB * travel / (1024.0 * 1024.0);
+            ++result.seeks;
+        }
+
+        result.ms += file.size * msPerByte;
+        result.bytes += file.size;
+
+        head = AlignToSector(placement.offset + file.size);
+        headKnown = true;
+    }
+
+    return result;
+}
+
+void PackLayout::Report() const
+{
+    std::cout << "\n[PackLayout] Simulated load times (seek " << m_model.seekMs
+        << " ms, " << m_model.transferKBps << " KB/s)\n";
+
+    double beforeTotal = 0.0;
+    double afterTotal = 0.0;
+
+    for (size_t s = 0; s < m_scenes.size(); ++s)
+    {
+        PackSimResult before = Simulate(m_naive, s);
+        PackSimResult after = Simulate(m_optimized, s);
+
+        beforeTotal += before.ms;
+        afterTotal += after.ms;
+
+        std::cout << "  " << m_scenes[s].sceneName << ": "
+            << before.ms << " ms (" << before.seeks << " seeks) -> "
+            << after.ms << " ms (" << after.seeks << " seeks), "
+            << after.bytes << " bytes\n";
+    }
+
+    std::cout << "  Total: " << beforeTotal << " ms -> " << afterTotal << " ms\n";
+    std::cout << "  Pack size: " << m_naive.size << " -> " << m_optimized.size
+        << " bytes (" << m_optimized.placements.size() - m_naive.placements.size()
+        << " duplicated files, budget " << m_model.duplicateMaxBytes << " bytes)\n";
+}
+
+bool PackLayout::WritePack(const std::string& path) const
+{
+    std::vector<char> toc;
+    AppendU32(toc, m_model.sectorSize);
+    AppendU32(toc, static_cast<uint32_t>(m_optimized.placements.size()));
+
+    for (const PackPlacement& placement : m_optimized.placements)
+    {
+        AppendU32(toc, placement.offset);
+        AppendU32(toc, m_files[placement.fileIndex].size);
+        AppendString(toc, m_files[placement.fileIndex].name);
+    }
+
+    AppendU32(toc, static_cast<uint32_t>(m_scenes.size()));
+    for (size_t s = 0; s < m_scenes.size(); ++s)
+    {
+        AppendString(toc, m_scenes[s].sceneName);
+        AppendU32(toc, static_cast<uint32_t>(m_optimized.reads[s].size()));
+        for (uint32_t p : m_optimized.reads[s])
+            AppendU32(toc, p);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "[PackLayout] Cannot write: " << path << "\n";
+        return false;
+    }
+
+    WriteChunk(out, GV_CHUNK_PACK_TOC, GV_CHUNK_VERSION, toc);
+
+    // Placement offsets are relative to the first sector after the TOC.
+    const uint32_t dataStart = AlignToSector(static_cast<uint32_t>(sizeof(GV_ChunkHeader) + toc.size()));
+    std::vector<char> buffer;
+
+    for (const PackPlacement& placement : m_optimized.placements)
+    {
+        const PackFile& file = m_files[placement.fileIndex];
+
+        out.seekp(dataStart + placement.offset);
+
+        // The layout was made from the size the file had when it was added;
+        // a file that is gone or shorter now would leave a hole.
+        std::ifstream in(file.sourcePath, std::ios::binary);
+        buffer.assign(file.size, 0);
+        if (!in.is_open() || !in.read(buffer.data(), file.size) ||
+            in.gcount() != static_cast<std::streamsize>(file.size))
+        {
+            std::cout << "[PackLayout] Cannot read " << file.size << " bytes from: " << file.sourcePath << "\n";
+            return false;
+        }
+
+        out.write(buffer.data(), file.size);
+    }
+
+    // Pad the image to a whole sector.
+    const uint32_t end = dataStart + m_optimized.size;
+    if (end > dataStart)
+    {
+        out.seekp(end - 1);
+        out.put(0);
+    }
+
+    out.flush();
+    if (!out)
+    {
+        std::cout << "[PackLayout] Write failed: " << path << "\n";
+        return false;
+    }
+
+    return true;
+}
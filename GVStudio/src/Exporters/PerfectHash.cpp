@@ -0,0 +1,305 @@
+#include "Exporters/PerfectHash.h"
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    constexpr uint32_t kMaxBucketSeed = 1u << 16;
+    constexpr int kMaxAttempts = 16;
+}
+
+uint64_t PerfectHash::Hash(const char* key, size_t length, uint32_t seed)
+{
+    // 64-bit FNV-1a with a murmur3 finalizer. The key is walked once; the
+    // bucket and the displaced slot are both derived from this value.
+    uint64_t h = 14695981039346656037ull ^ seed;
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= static_cast<unsigned char>(key[i]);
+        h *= 1099511628211ull;
+    }
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+uint32_t PerfectHash::Displace(uint64_t hash, uint32_t seed)
+{
+    uint32_t h = static_cast<uint32_t>(hash) ^ (seed * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+bool PerfectHash::Build(const std::vector<std::string>& names)
+{
+    m_globalSeed = 0;
+    m_seeds.clear();
+    m_slotToIndex.clear();
+    m_slotNames.clear();
+
+    const size_t n = names.size();
+    if (n == 0)
+        return true;
+
+    std::unordered_set<std::string> unique;
+    for (const std::string& name : names)
+    {
+        if (!unique.insert(name).second)
+        {
+            std::cout << "[PerfectHash] Duplicate name: " << name << "\n";
+            return false;
+        }
+    }
+
+    const size_t bucketCount = (n + 3) / 4;
+
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt)
+    {
+        const uint32_t globalSeed = 0x9E3779B9u * static_cast<uint32_t>(attempt + 1);
+
+        std::vector<uint64_t> hashes(n);
+        std::vector<std::vector<uint32_t>> buckets(bucketCount);
+        for (size_t i = 0; i < n; ++i)
+        {
+            hashes[i] = Hash(names[i].data(), names[i].size(), globalSeed);
+            buckets[(hashes[i] >> 32) % bucketCount].push_back(static_cast<uint32_t>(i));
+        }
+
+        std::vector<uint32_t> order(bucketCount);
+        for (size_t b = 0; b < bucketCount; ++b)
+            order[b] = static_cast<uint32_t>(b);
+
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+            {
+                return buckets[a].size() > buckets[b].size();
+            });
+
+        std::vector<uint32_t> seeds(bucketCount, 0);
+        std::vector<uint32_t> slotToIndex(n, 0);
+        std::vector<bool> taken(n, false);
+        std::vector<uint32_t> slots;
+
+        bool ok = true;
+
+        for (uint32_t b : order)
+        {
+            const std::vector<uint32_t>& bucket = buckets[b];
+            if (bucket.empty())
+                break;
+
+            bool placed = false;
+
+            for (uint32_t seed = 1; seed < kMaxBucketSeed && !placed; ++seed)
+            {
+                slots.clear();
+
+                bool fits = true;
+                for (uint32_t keyIndex : bucket)
+                {
+                    uint32_t slot = Displace(hashes[keyIndex], seed) % n;
+
+                    if (taken[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+
+                if (!fits)
+                    continue;
+
+                for (size_t k = 0; k < bucket.size(); ++k)
+                {
+                    taken[slots[k]] = true;
+                    slotToIndex[slots[k]] = bucket[k];
+                }
+
+                seeds[b] = seed;
+                placed = true;
+            }
+
+            if (!placed)
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        if (!ok)
+            continue;
+
+        m_globalSeed = globalSeed;
+        m_seeds = std::move(seeds);
+        m_slotToIndex = std::move(slotToIndex);
+
+        m_slotNames.resize(n);
+        for (size_t slot = 0; slot < n; ++slot)
+            m_slotNames[slot] = names[m_slotToIndex[slot]];
+
+        return true;
+    }
+
+    std::cout << "[PerfectHash] Failed to build table for "
+        << n << " names\n";
+    return false;
+}
+
+uint32_t PerfectHash::Slot(const std::string& key) const
+{
+    uint64_t h = Hash(key.data(), key.size(), m_globalSeed);
+    uint32_t b = static_cast<uint32_t>((h >> 32) % m_seeds.size());
+    return Displace(h, m_seeds[b]) % static_cast<uint32_t>(m_slotNames.size());
+}
+
+int PerfectHash::Lookup(const std::string& key) const
+{
+    if (m_slotNames.empty())
+        return -1;
+
+    uint32_t slot = Slot(key);
+    if (m_slotNames[slot] != key)
+        return -1;
+
+    return static_cast<int>(m_slotToIndex[slot]);
+}
+
+size_t PerfectHash::GetKeyCount() const
+{
+    return m_slotNames.size();
+}
+
+size_t PerfectHash::GetBucketCount() const
+{
+    return m_seeds.size();
+}
+
+size_t PerfectHash::GetTableBytes() const
+{
+    // Header, seeds, slot table, name offsets and the blob size.
+    return 4 * (4 + m_seeds.size() + m_slotToIndex.size() + m_slotNames.size() + 1);
+}
+
+size_t PerfectHash::GetStringBytes() const
+{
+    size_t bytes = 0;
+    for (const std::string& name : m_slotNames)
+        bytes += name.size() + 1;
+    return (bytes + 3) & ~static_cast<size_t>(3);
+}
+
+std::vector<char> PerfectHash::BuildChunk(NameHashKind kind) const
+{
+    std::vector<char> payload;
+
+    AppendU32(payload, static_cast<uint32_t>(kind));
+    AppendU32(payload, static_cast<uint32_t>(m_slotNames.size()));
+    AppendU32(payload, static_cast<uint32_t>(m_seeds.size()));
+    AppendU32(payload, m_globalSeed);
+
+    for (uint32_t seed : m_seeds)
+        AppendU32(payload, seed);
+
+    for (uint32_t index : m_slotToIndex)
+        AppendU32(payload, index);
+
+    // Names are stored in slot order so verification is one strcmp.
+    std::vector<char> blob;
+    for (const std::string& name : m_slotNames)
+    {
+        AppendU32(payload, static_cast<uint32_t>(blob.size()));
+        blob.insert(blob.end(), name.begin(), name.end());
+        blob.push_back(0);
+    }
+
+    while (blob.size() % 4 != 0)
+        blob.push_back(0);
+
+    AppendU32(payload, static_cast<uint32_t>(blob.size()));
+    payload.insert(payload.end(), blob.begin(), blob.end());
+
+    return payload;
+}
+
+void PerfectHash::RunBenchmark(size_t keyCount, size_t lookups)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<std::string> names;
+    names.reserve(keyCount);
+    for (size_t i = 0; i < keyCount; ++i)
+        names.push_back("Scenes/Level/Objects/Object_" + std::to_string(i));
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> pick(0, keyCount - 1);
+
+    std::vector<const std::string*> queries(lookups);
+    for (size_t i = 0; i < lookups; ++i)
+        queries[i] = &names[pick(rng)];
+
+    auto t0 = Clock::now();
+    PerfectHash mph;
+    if (!mph.Build(names))
+        return;
+    auto t1 = Clock::now();
+
+    std::unordered_map<std::string, int> map;
+    map.reserve(keyCount);
+    for (size_t i = 0; i < keyCount; ++i)
+        map.emplace(names[i], static_cast<int>(i));
+    auto t2 = Clock::now();
+
+    long long sumMph = 0;
+    for (const std::string* q : queries)
+        sumMph += mph.Lookup(*q);
+    auto t3 = Clock::now();
+
+    long long sumMap = 0;
+    for (const std::string* q : queries)
+        sumMap += map.find(*q)->second;
+    auto t4 = Clock::now();
+
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    auto ns = [&](Clock::duration d) { return ms(d) * 1.0e6 / static_cast<double>(lookups); };
+
+    std::cout << "\n[PerfectHash] Benchmark: " << keyCount << " keys, "
+        << lookups << " lookups\n";
+    std::cout << "  Build:  perfect hash " << ms(t1 - t0) << " ms, unordered_map "
+        << ms(t2 - t1) << " ms\n";
+    std::cout << "  Lookup: perfect hash " << ns(t3 - t2) << " ns, unordered_map "
+        << ns(t4 - t3) << " ns\n";
+    // Both sides hold the names: the chunk as seeds, slot table, name
+    // offsets and the string blob, the map as bucket array plus one node
+    // per key with its string (and the string's heap block past SSO).
+    const size_t mphBytes = mph.BuildChunk(NameHashKind::Objects).size();
+
+    // An empty string's capacity is the library's inline (SSO) capacity;
+    // anything larger lives in its own heap block.
+    const size_t inlineCapacity = std::string().capacity();
+
+    size_t mapBytes = map.bucket_count() * sizeof(void*);
+    for (const auto& [name, index] : map)
+    {
+        mapBytes += sizeof(void*) + sizeof(size_t) + sizeof(std::pair<const std::string, int>);
+        if (name.capacity() > inlineCapacity)
+            mapBytes += name.capacity() + 1;
+    }
+
+    std::cout << "  Table size: perfect hash chunk " << mphBytes
+        << " bytes, unordered_map ~" << mapBytes << " bytes\n";
+
+    if (sumMph != sumMap)
+        std::cout << "  Checksum mismatch!\n";
+}
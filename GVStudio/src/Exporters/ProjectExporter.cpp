@@ -0,0 +1,963 @@
+#include "Exporters/ProjectExporter.h"
+#include "Exporters/PerfectHash.h"
+#include "Exporters/MemoryPlan.h"
+#include "Exporters/PackLayout.h"
+#include "Exporters/TriangleBVH.h"
+#include "Database/AssetDatabase.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkChecksum.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+#include "GVFramework/Scene/SceneManager.h"
+#include "GVFramework/Scene/SceneObject.h"
+#include "GVStudio/GVStudio.h"
+#include "Renderer/GatherScene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+void ExportControl::Cancel()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancel = true;
+
+    for (LightmapBaker* baker : m_bakers)
+        baker->Cancel();
+}
+
+bool ExportControl::IsCancelled() const
+{
+    return m_cancel;
+}
+
+void ExportControl::BeginBake(LightmapBaker* baker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bakers.push_back(baker);
+
+    if (m_cancel)
+        baker->Cancel();
+}
+
+void ExportControl::EndBake(LightmapBaker* baker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_bakers.erase(std::remove(m_bakers.begin(), m_bakers.end(), baker), m_bakers.end());
+}
+
+void ExportControl::SetPreview(const std::string& sceneName, const LightmapBaker& baker, uint32_t pass, uint32_t passCount)
+{
+    auto toByte = [](float value)
+        {
+            return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+        };
+
+    // Converted outside the lock; the UI only ever waits for the swap.
+    LightmapPreview preview;
+    preview.sceneName = sceneName;
+    preview.pass = pass;
+    preview.passCount = passCount;
+    preview.pageSize = baker.GetPageSize();
+    preview.pages.resize(baker.GetPageCount());
+
+    for (uint32_t p = 0; p < baker.GetPageCount(); ++p)
+    {
+        const std::vector<Vec3>& color = baker.GetPage(p);
+        preview.pages[p].resize(color.size());
+
+        for (size_t i = 0; i < color.size(); ++i)
+            preview.pages[p][i] = toByte(color[i].x) | (toByte(color[i].y) << 8) |
+                (toByte(color[i].z) << 16) | 0xFF000000u;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_preview = std::move(preview);
+    ++m_version;
+}
+
+bool ExportControl::GetPreview(uint32_t& version, LightmapPreview& out) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (version == m_version)
+        return false;
+
+    out = m_preview;
+    version = m_version;
+    return true;
+}
+
+ProjectExporter::ProjectExporter(LogicUnitRegistry& registry, const ExportSettings& settings)
+    : m_registry(registry),
+    m_settings(settings),
+    m_target(&GetTargetInfo(settings.targets.empty() ? ExportTarget::Psp : settings.targets.front()))
+{
+}
+
+void ProjectExporter::CollectObjects(
+    const SceneFolder& folder,
+    std::vector<const SceneObject*>& outObjects)
+{
+    for (const auto& obj : folder.objects)
+        outObjects.push_back(obj.get());
+
+    for (const auto& child : folder.children)
+        CollectObjects(*child, outObjects);
+}
+
+std::vector<std::string> ProjectExporter::CollectAssetPaths(
+    const std::vector<const SceneObject*>& objects)
+{
+    AssetDatabase assets;
+    std::set<std::string> paths;
+
+    for (const SceneObject* obj : objects)
+    {
+        if (!obj->assetPath.empty())
+            paths.insert(obj->assetPath);
+
+        if (obj->def)
+            assets.ProcessLogicUnitInstance(*obj->def);
+    }
+
+    for (GV_ChunkType type : { GV_CHUNK_TEXTURE, GV_CHUNK_STATIC_MESH, GV_CHUNK_HEIGHTMAP })
+        for (const AssetEntry* entry : assets.GetAssetsByChunk(type))
+            paths.insert(entry->path);
+
+    return std::vector<std::string>(paths.begin(), paths.end());
+}
+
+bool ProjectExporter::ExportProject(const GV_Project_Info& project, ExportScope* scope)
+{
+    if (m_settings.targets.size() > 1)
+    {
+        if (scope)
+        {
+            std::cout << "[Exporter] A scoped export writes one target, got "
+                << m_settings.targets.size() << "\n";
+            return false;
+        }
+
+        return ExportTargets(project);
+    }
+
+    fs::path dataDir = fs::path(project.projectRoot) / project.dataFolder / m_target->dataSubfolder;
+    m_resourceRoot = (fs::path(project.projectRoot) / project.resourceFolder).string();
+
+    std::cout << "\n[Exporter] Exporting project: " << project.projectName
+        << " (" << m_target->name << ")\n";
+    std::cout << "[Exporter] Output: " << dataDir.string() << "\n";
+
+    std::error_code ec;
+    fs::create_directories(dataDir, ec);
+
+    // Load every scene up front: event IDs are assigned project-wide.
+    std::vector<std::unique_ptr<SceneManager>> scenes;
+    std::vector<std::vector<const SceneObject*>> sceneObjects;
+
+    m_events.Clear();
+    m_meshes.Clear();
+    m_materials.Clear();
+    m_textureFormats.clear();
+    m_materials.SetResourceRoot(m_resourceRoot);
+
+    for (const GV_Scene_Info& scene : project.scenes)
+    {
+        auto manager = std::make_unique<SceneManager>(m_registry);
+
+        std::string sceneDir = project.projectRoot + "/" + scene.scenePath;
+        if (!manager->LoadScene(sceneDir))
+        {
+            std::cout << "[Exporter] Failed to load scene: " << sceneDir << "\n";
+            return false;
+        }
+
+        std::vector<const SceneObject*> objects;
+        CollectObjects(manager->GetRootFolder(), objects);
+
+        m_events.CollectScene(scene.sceneName, objects);
+
+        scenes.push_back(std::move(manager));
+        sceneObjects.push_back(std::move(objects));
+    }
+
+    m_events.AssignIds();
+    m_events.Report();
+
+    fs::path eventHeader = dataDir / "GVEvents.h";
+    if (!m_events.WriteHeader(eventHeader.string()))
+        return false;
+
+    // Cook every mesh up front and register materials scene by scene, so
+    // IDs are fixed before any scene is written, whichever ones are.
+    std::vector<std::string> modelPaths;
+    for (const std::vector<const SceneObject*>& objects : sceneObjects)
+        for (const std::string& path : CollectModelPaths(objects))
+            modelPaths.push_back(path);
+
+    m_meshes.CookAll(modelPaths);
+
+    for (const std::vector<const SceneObject*>& objects : sceneObjects)
+        RegisterMaterials(objects);
+
+    uint64_t tablesHash = HashTables(eventHeader.string());
+    bool writeAll = !scope || scope->allScenes || scope->previousTablesHash != tablesHash;
+
+    for (size_t s = 0; s < project.scenes.size(); ++s)
+    {
+        const std::string& sceneName = project.scenes[s].sceneName;
+
+        if (IsCancelled())
+        {
+            std::cout << "[Exporter] Cancelled\n";
+            return false;
+        }
+
+        if (scope)
+            CollectSceneInputs(sceneName, project.projectRoot + "/" + project.scenes[s].scenePath,
+                sceneObjects[s], *scope);
+
+        if (!writeAll && scope->scenes.count(sceneName) == 0)
+            continue;
+
+        fs::path outPath = dataDir / (sceneName + ".gvs");
+
+        if (!ExportScene(sceneName, s, sceneObjects[s], outPath.string()))
+        {
+            if (IsCancelled())
+                std::cout << "[Exporter] Cancelled\n";
+            return false;
+        }
+
+        if (scope)
+            scope->written.insert(sceneName);
+    }
+
+    if (scope)
+        scope->tablesHash = tablesHash;
+
+    std::cout << "[Materials] " << m_materials.GetMaterials().size() << " unique materials, "
+        << m_materials.GetTextures().size() << " textures across "
+        << project.scenes.size() << " scenes\n";
+
+    if (m_settings.writePack && !WritePack(project, sceneObjects, dataDir.string()))
+        return false;
+
+    if (m_settings.writeSharedPack && !WriteSharedPack(project, dataDir.string()))
+        return false;
+
+    std::cout << "[Exporter] Export complete.\n\n";
+    return true;
+}
+
+bool ProjectExporter::ExportTargets(const GV_Project_Info& project)
+{
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    // Exporters share nothing but the registry, which is only read.
+    std::vector<char> results(m_settings.targets.size(), 0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < m_settings.targets.size(); ++i)
+    {
+        ExportSettings settings = m_settings;
+        settings.targets = { m_settings.targets[i] };
+
+        threads.emplace_back([this, &project, &results, settings, i]()
+            {
+                ProjectExporter exporter(m_registry, settings);
+                results[i] = exporter.ExportProject(project) ? 1 : 0;
+            });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    bool ok = true;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const ExportTargetInfo& info = GetTargetInfo(m_settings.targets[i]);
+        std::cout << "[Exporter] Target " << info.name << ": " << (results[i] ? "ok" : "FAILED") << "\n";
+        ok = ok && results[i];
+    }
+
+    std::cout << "[Exporter] " << results.size() << " targets exported in " << ms << " ms\n";
+    return ok;
+}
+
+bool ProjectExporter::ExportScene(
+    const std::string& sceneName,
+    size_t sceneIndex,
+    const std::vector<const SceneObject*>& objects,
+    const std::string& outPath)
+{
+    std::ofstream out(outPath, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "[Exporter] Cannot write: " << outPath << "\n";
+        return false;
+    }
+
+    std::vector<char> eventTable = m_events.BuildDispatchTable(sceneIndex);
+
+    std::vector<std::string> objectNames;
+    for (const SceneObject* obj : objects)
+        objectNames.push_back(obj->name);
+
+    PerfectHash objectHash;
+    const bool hasObjectHash = objectHash.Build(objectNames);
+    if (!hasObjectHash)
+        std::cout << "[Exporter] " << sceneName
+            << ": object names are not unique, skipping name hash\n";
+
+    PerfectHash assetHash;
+    const bool hasAssetHash = assetHash.Build(CollectAssetPaths(objects));
+
+    MemoryPlan plan = MemoryPlan::ForScene(objects, m_resourceRoot,
+        static_cast<uint32_t>(eventTable.size()), m_meshes, *m_target,
+        hasObjectHash ? &objectHash : nullptr, hasAssetHash ? &assetHash : nullptr);
+    plan.Report(sceneName);
+
+    std::vector<char> planChunk = plan.BuildChunk();
+
+    // Chunks are written in the order the runtime needs them: the arena is
+    // carved first, then lookup tables, then the objects that fill it.
+    WriteChunk(out, GV_CHUNK_MEMORY_PLAN, GV_CHUNK_VERSION, planChunk);
+
+    if (hasObjectHash)
+        WriteChunk(out, GV_CHUNK_NAME_HASH, GV_CHUNK_VERSION, objectHash.BuildChunk(NameHashKind::Objects));
+
+    if (hasAssetHash)
+        WriteChunk(out, GV_CHUNK_NAME_HASH, GV_CHUNK_VERSION, assetHash.BuildChunk(NameHashKind::Assets));
+
+    WriteChunk(out, GV_CHUNK_EVENT_TABLE, GV_CHUNK_VERSION, eventTable);
+
+    // Lightmaps are baked before the meshes are written: the pages come
+    // first and every mesh carries the UVs of the objects drawn with it.
+    LightmapBaker baker;
+    std::vector<WorldTriangle> lightmapTriangles;
+    const bool baked = m_settings.bakeLightmaps && BakeLightmaps(sceneName, objects, baker, lightmapTriangles);
+
+    if (IsCancelled())
+    {
+        out.close();
+        std::error_code ec;
+        fs::remove(outPath, ec);
+        return false;
+    }
+
+    if (baked)
+        WriteChunk(out, GV_CHUNK_LIGHTMAP, GV_CHUNK_VERSION, baker.BuildChunk());
+
+    // A scene without its meshes must not be left behind for the runtime
+    // (or the next incremental export) to pick up.
+    if (!WriteStaticMeshes(out, sceneName, objects, outPath, baked ? &baker : nullptr, lightmapTriangles))
+    {
+        out.close();
+        std::error_code ec;
+        fs::remove(outPath, ec);
+        return false;
+    }
+
+    for (const SceneObject* obj : objects)
+        WriteChunk(out, GV_CHUNK_SCENE_OBJECT, GV_CHUNK_VERSION, BuildSceneObjectChunk(*obj));
+
+    if (m_settings.worldLayout == WorldLayout::Bsp)
+        WriteBspWorld(out, sceneName, objects);
+    else
+        WriteSectors(out, sceneName, objects);
+
+    out.close();
+
+    // The plan is checked against the chunks as written, not against the
+    // objects it was made from.
+    std::vector<char> written;
+    if (!ChunkReader::ReadFile(outPath, written) ||
+        !MemoryPlan::Simulate(planChunk, written.data(), written.size()))
+    {
+        std::cout << "[Exporter] " << sceneName << ": memory plan failed simulation\n";
+        std::error_code ec;
+        fs::remove(outPath, ec);
+        return false;
+    }
+
+    if (m_settings.writeChecksums && !ChunkChecksum::AppendToFile(outPath))
+        return false;
+
+    std::cout << "[Exporter] Wrote scene " << sceneName
+        << " (" << objects.size() << " objects)\n";
+
+    return true;
+}
+
+std::set<std::string> ProjectExporter::CollectModelPaths(const std::vector<const SceneObject*>& objects) const
+{
+    std::set<std::string> modelPaths;
+    for (const SceneObject* obj : objects)
+    {
+        if (!obj->def)
+            continue;
+
+        std::string modelPath;
+        GatherScene::BuildModelFromLogicUnit(obj->def.get(), m_resourceRoot, modelPath);
+
+        if (!modelPath.empty())
+            modelPaths.insert(modelPath);
+    }
+
+    return modelPaths;
+}
+
+void ProjectExporter::CollectSceneInputs(
+    const std::string& sceneName,
+    const std::string& sceneDir,
+    const std::vector<const SceneObject*>& objects,
+    ExportScope& scope)
+{
+    std::set<std::string> inputs;
+
+    std::error_code ec;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(sceneDir, ec))
+        if (entry.is_regular_file())
+            inputs.insert(entry.path().lexically_normal().generic_string());
+
+    auto absolute = [&](const std::string& path)
+        {
+            fs::path full = fs::path(path).is_absolute() ? fs::path(path) : fs::path(m_resourceRoot) / path;
+            return full.lexically_normal().generic_string();
+        };
+
+    AssetDatabase assets;
+    assets.SetResourceRoot(m_resourceRoot);
+
+    for (const SceneObject* obj : objects)
+    {
+        if (!obj->def)
+            continue;
+
+        assets.ProcessLogicUnitInstance(*obj->def);
+
+        for (const std::string& path : assets.ExtractPaths(*obj->def))
+        {
+            inputs.insert(absolute(path));
+
+            if (const AssetEntry* entry = assets.GetAsset(path))
+                for (const std::string& dep : entry->dependencies)
+                    inputs.insert(absolute(dep));
+        }
+    }
+
+    // Meshes are listed by OBJ path; what their cook reads is kept apart.
+    for (const std::string& modelPath : CollectModelPaths(objects))
+    {
+        std::string objPath = absolute(modelPath);
+        inputs.insert(objPath);
+
+        const CookedMesh* mesh = m_meshes.Get(modelPath);
+        std::set<std::string> cookInputs = { objPath };
+
+        if (mesh && !mesh->materialLibrary.empty())
+            cookInputs.insert(absolute(mesh->materialLibrary));
+
+        for (size_t p = 0; mesh && p < mesh->parts.size(); ++p)
+        {
+            const ExportMaterial& material = m_materials.ResolveMaterial(*mesh, p);
+            if (material.textureId != GV_TEXTURE_NONE)
+                cookInputs.insert(absolute(m_materials.GetTextures()[material.textureId]));
+        }
+
+        scope.meshInputs[objPath] = std::vector<std::string>(cookInputs.begin(), cookInputs.end());
+    }
+
+    scope.sceneInputs[sceneName] = std::vector<std::string>(inputs.begin(), inputs.end());
+}
+
+void ProjectExporter::RegisterMaterials(const std::vector<const SceneObject*>& objects)
+{
+    for (const std::string& modelPath : CollectModelPaths(objects))
+    {
+        const CookedMesh* mesh = m_meshes.Get(modelPath);
+        if (!mesh)
+            continue;
+
+        for (size_t p = 0; p < mesh->parts.size(); ++p)
+            m_materials.ResolveMaterial(*mesh, p);
+    }
+}
+
+uint64_t ProjectExporter::HashTables(const std::string& eventHeaderPath) const
+{
+    std::vector<char> tables;
+    ChunkReader::ReadFile(eventHeaderPath, tables);
+
+    for (const ExportMaterial& material : m_materials.GetMaterials())
+    {
+        AppendU32(tables, material.rgba);
+        AppendU32(tables, material.illum);
+        AppendU32(tables, material.textureId);
+    }
+
+    for (const std::string& texture : m_materials.GetTextures())
+        AppendString(tables, texture);
+
+    return XXHash64(tables.data(), tables.size());
+}
+
+bool ProjectExporter::IsCancelled() const
+{
+    return m_settings.control && m_settings.control->IsCancelled();
+}
+
+bool ProjectExporter::WriteStaticMeshes(
+    std::ofstream& out,
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects,
+    const std::string& outPath,
+    const LightmapBaker* baker,
+    const std::vector<WorldTriangle>& lightmapTriangles)
+{
+    std::set<std::string> modelPaths = CollectModelPaths(objects);
+
+    // Baked triangles by object, and the objects drawn with each mesh.
+    std::map<uint32_t, std::vector<uint32_t>> objectTriangles;
+    std::map<std::string, std::vector<uint32_t>> meshObjects;
+
+    if (baker)
+    {
+        for (uint32_t t = 0; t < lightmapTriangles.size(); ++t)
+            objectTriangles[lightmapTriangles[t].objectIndex].push_back(t);
+
+        for (const auto& [objectIndex, list] : objectTriangles)
+        {
+            std::string modelPath;
+            GatherScene::BuildModelFromLogicUnit(objects[objectIndex]->def.get(), m_resourceRoot, modelPath);
+            meshObjects[modelPath].push_back(objectIndex);
+        }
+    }
+
+    std::string disassembly;
+    uint32_t totalWords = 0;
+
+    for (const std::string& modelPath : modelPaths)
+    {
+        const CookedMesh* mesh = m_meshes.Get(modelPath);
+        if (!mesh)
+            continue;
+
+        std::string name = fs::path(modelPath).lexically_relative(m_resourceRoot).generic_string();
+
+        std::vector<char> info;
+        AppendString(info, name);
+        AppendU32(info, static_cast<uint32_t>(mesh->GetVertexCount()));
+        AppendU32(info, static_cast<uint32_t>(mesh->parts.size()));
+
+        std::vector<CookedPartState> states(mesh->parts.size());
+        uint32_t firstVertex = 0;
+
+        for (size_t p = 0; p < mesh->parts.size(); ++p)
+        {
+            const ExportMaterial& material = m_materials.ResolveMaterial(*mesh, p);
+            uint32_t count = static_cast<uint32_t>(mesh->parts[p].vertices.size());
+
+            AppendU32(info, firstVertex);
+            AppendU32(info, count);
+            AppendU32(info, material.id);
+            firstVertex += count;
+
+            states[p].rgba = material.rgba;
+            states[p].textureId = material.textureId;
+
+            if (material.textureId == GV_TEXTURE_NONE)
+                continue;
+
+            auto it = m_textureFormats.find(material.textureId);
+            if (it == m_textureFormats.end())
+            {
+                TextureFormat format;
+                std::string texPath = (fs::path(m_resourceRoot) / m_materials.GetTextures()[material.textureId]).string();
+
+                if (!TextureCooker::ReadFormat(texPath, format))
+                    std::cout << "[Exporter] Cannot read texture: " << texPath << "\n";
+
+                it = m_textureFormats.emplace(material.textureId, format).first;
+            }
+
+            if (it->second.width == 0)
+                states[p].textureId = GV_TEXTURE_NONE;
+            else
+                states[p].texture = it->second;
+        }
+
+        std::vector<char> vertices = m_target->buildVertexData(*mesh);
+
+        std::vector<char> payload;
+        AppendChunk(payload, GV_CHUNK_STRUCT, GV_CHUNK_VERSION, info);
+        AppendChunk(payload, GV_CHUNK_GEOMETRY, GV_CHUNK_VERSION, vertices);
+
+        if (m_target->nativeDisplayLists)
+        {
+            GeDisplayList displayList = MeshCooker::BuildDisplayList(*mesh, states);
+            std::vector<char> list = displayList.BuildChunk();
+
+            std::string error;
+            if (!GeDecoder::Validate(list, static_cast<uint32_t>(vertices.size()), error))
+            {
+                std::cout << "[Exporter] " << name << ": invalid display list: " << error << "\n";
+                return false;
+            }
+
+            if (m_settings.dumpDisplayLists)
+                disassembly += "; " + name + "\n" + GeDecoder::Disassemble(list) + "\n";
+
+            totalWords += static_cast<uint32_t>(displayList.GetWords().size());
+
+            AppendChunk(payload, GV_CHUNK_NATIVEDATA_PLG, GV_CHUNK_VERSION, list);
+        }
+
+        auto drawn = meshObjects.find(modelPath);
+        if (drawn != meshObjects.end())
+        {
+            for (uint32_t objectIndex : drawn->second)
+                AppendChunk(payload, GV_CHUNK_LIGHTMAP_UV, GV_CHUNK_VERSION,
+                    baker->BuildMeshUVChunk(objectIndex, static_cast<uint32_t>(mesh->parts.size()),
+                        lightmapTriangles, objectTriangles[objectIndex]));
+        }
+
+        WriteChunk(out, GV_CHUNK_STATIC_MESH, GV_CHUNK_VERSION, payload);
+    }
+
+    std::cout << "[Exporter] " << sceneName << ": " << modelPaths.size() << " static meshes";
+    if (m_target->nativeDisplayLists)
+        std::cout << ", " << totalWords << " GE commands, all lists validated";
+    std::cout << "\n";
+
+    if (m_settings.dumpDisplayLists && !disassembly.empty())
+    {
+        std::ofstream dump(fs::path(outPath).replace_extension(".ge.txt"));
+        dump << disassembly;
+    }
+
+    return true;
+}
+
+void ProjectExporter::WriteSectors(
+    std::ofstream& out,
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects)
+{
+    WorldSectors sectors(m_settings.sectorSize);
+    m_materials.CollectDrawItems(objects, m_meshes, sectors);
+
+    StateChangeCount totalBefore;
+    StateChangeCount totalAfter;
+
+    std::vector<WorldSector>& list = sectors.GetSectors();
+
+    for (size_t i = 0; i < list.size(); ++i)
+    {
+        WorldSector& sector = list[i];
+
+        StateChangeCount before = MaterialExporter::CountStateChanges(sector.items);
+        MaterialExporter::SortSector(sector);
+        StateChangeCount after = MaterialExporter::CountStateChanges(sector.items);
+
+        std::cout << "[Materials] " << sceneName << " sector (" << sector.cellX << "," << sector.cellZ
+            << "): " << sector.items.size() << " draws, texture changes "
+            << before.textures << " -> " << after.textures
+            << ", material changes " << before.materials << " -> " << after.materials << "\n";
+
+        totalBefore.textures += before.textures;
+        totalBefore.materials += before.materials;
+        totalAfter.textures += after.textures;
+        totalAfter.materials += after.materials;
+
+        WriteChunk(out, GV_CHUNK_WORLD_SECTOR, GV_CHUNK_VERSION,
+            m_materials.BuildSectorChunk(static_cast<uint32_t>(i), sector));
+    }
+
+    std::cout << "[Materials] " << sceneName << ": " << list.size() << " sectors, "
+        << sectors.GetItemCount() << " draws, state changes "
+        << (totalBefore.textures + totalBefore.materials) << " -> "
+        << (totalAfter.textures + totalAfter.materials) << "\n";
+
+    WritePvs(out, sceneName, objects, list);
+}
+
+void ProjectExporter::WriteBspWorld(
+    std::ofstream& out,
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects)
+{
+    std::vector<WorldTriangle> triangles;
+    m_materials.CollectTriangles(objects, m_meshes, triangles);
+
+    BspBuilder bsp;
+    bsp.Build(triangles, m_settings.bsp);
+    bsp.Report(sceneName);
+
+    WriteChunk(out, GV_CHUNK_WORLD, GV_CHUNK_VERSION, bsp.BuildChunk());
+
+    // PVS rows follow atomic sector order.
+    WritePvs(out, sceneName, objects, bsp.GetLeafSectors());
+}
+
+void ProjectExporter::WritePvs(
+    std::ofstream& out,
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects,
+    const std::vector<WorldSector>& sectors)
+{
+    if (!m_settings.computePvs || sectors.size() < 2)
+        return;
+
+    // Only opaque geometry occludes.
+    std::vector<WorldTriangle> triangles;
+    m_materials.CollectTriangles(objects, m_meshes, triangles);
+
+    std::vector<BvhTriangle> occluders;
+    for (const WorldTriangle& tri : triangles)
+        if (!tri.translucent)
+            occluders.push_back({ tri.v[0], tri.v[1], tri.v[2] });
+
+    TriangleBVH bvh;
+    bvh.Build(std::move(occluders));
+
+    PvsBuilder pvs;
+    pvs.Build(sectors, bvh, m_settings.pvs);
+    pvs.Report(sceneName);
+
+    WriteChunk(out, GV_CHUNK_PVS, GV_CHUNK_VERSION, pvs.BuildChunk());
+}
+
+bool ProjectExporter::BakeLightmaps(
+    const std::string& sceneName,
+    const std::vector<const SceneObject*>& objects,
+    LightmapBaker& baker,
+    std::vector<WorldTriangle>& outTriangles)
+{
+    std::vector<LightmapLight> lights = LightmapBaker::CollectLights(objects);
+    if (lights.empty())
+        return false;
+
+    std::vector<WorldTriangle>& triangles = outTriangles;
+    m_materials.CollectTriangles(objects, m_meshes, triangles);
+
+    std::vector<BvhTriangle> bvhTriangles;
+    std::vector<Vec3> albedo;
+
+    for (const WorldTriangle& tri : triangles)
+    {
+        uint32_t rgba = m_materials.GetMaterials()[tri.materialId].rgba;
+
+        bvhTriangles.push_back({ tri.v[0], tri.v[1], tri.v[2] });
+        albedo.push_back(Vec3(
+            (rgba & 0xFF) / 255.0f,
+            ((rgba >> 8) & 0xFF) / 255.0f,
+            ((rgba >> 16) & 0xFF) / 255.0f));
+    }
+
+    TriangleBVH bvh;
+    bvh.Build(std::move(bvhTriangles));
+
+    ExportControl* control = m_settings.control;
+    if (control)
+        control->BeginBake(&baker);
+
+    bool baked = baker.Bake(triangles, albedo, bvh, lights, m_settings.lightmap,
+        [&](uint32_t pass, uint32_t passCount)
+        {
+            std::cout << "[Lightmap] " << sceneName << ": pass " << pass << "/" << passCount << "\n";
+
+            if (!control)
+                return true;
+
+            control->SetPreview(sceneName, baker, pass, passCount);
+            return !control->IsCancelled();
+        });
+
+    if (control)
+        control->EndBake(&baker);
+
+    if (!baked || IsCancelled())
+        return false;
+
+    baker.Report(sceneName);
+    return true;
+}
+
+bool ProjectExporter::WritePack(
+    const GV_Project_Info& project,
+    const std::vector<std::vector<const SceneObject*>>& sceneObjects,
+    const std::string& dataDir)
+{
+    std::vector<size_t> order = GetLoadOrder(project);
+
+    PackLayout layout(m_settings.umd);
+
+    AssetDatabase assets;
+    assets.SetResourceRoot(m_resourceRoot);
+
+    auto addAsset = [&](const std::string& path, std::vector<uint32_t>& trace)
+        {
+            fs::path full = fs::path(path).is_absolute() ? fs::path(path) : fs::path(m_resourceRoot) / path;
+            std::string name = full.lexically_relative(m_resourceRoot).generic_string();
+            trace.push_back(layout.AddFile(name, full.string()));
+        };
+
+    for (size_t s : order)
+    {
+        const std::string& sceneName = project.scenes[s].sceneName;
+        std::vector<uint32_t> trace;
+
+        trace.push_back(layout.AddFile(sceneName + ".gvs",
+            (fs::path(dataDir) / (sceneName + ".gvs")).string()));
+
+        for (const SceneObject* obj : sceneObjects[s])
+        {
+            if (!obj->def)
+                continue;
+
+            assets.ProcessLogicUnitInstance(*obj->def);
+
+            for (const std::string& path : assets.ExtractPaths(*obj->def))
+            {
+                addAsset(path, trace);
+
+                if (const AssetEntry* entry = assets.GetAsset(path))
+                    for (const std::string& dep : entry->dependencies)
+                        addAsset(dep, trace);
+            }
+        }
+
+        layout.RecordScene(sceneName, trace);
+    }
+
+    layout.Build();
+    layout.Report();
+
+    std::string packName = project.projectName.empty() ? "Game" : project.projectName;
+    return layout.WritePack((fs::path(dataDir) / (packName + ".gvpack")).string());
+}
+
+bool ProjectExporter::WriteSharedPack(
+    const GV_Project_Info& project,
+    const std::string& dataDir)
+{
+    SharedChunkPack pack(m_settings.shared);
+
+    for (size_t s : GetLoadOrder(project))
+    {
+        const std::string& sceneName = project.scenes[s].sceneName;
+        fs::path scenePath = fs::path(dataDir) / (sceneName + ".gvs");
+
+        std::vector<char> data;
+        if (!ChunkReader::ReadFile(scenePath.string(), data))
+        {
+            std::cout << "[SharedPack] Failed to read: " << scenePath.string() << "\n";
+            return false;
+        }
+
+        if (!pack.AddScene(sceneName, data))
+            return false;
+    }
+
+    pack.Build();
+    pack.Report();
+
+    std::string packName = project.projectName.empty() ? "Game" : project.projectName;
+    return pack.Write((fs::path(dataDir) / (packName + ".gvchunks")).string(), dataDir);
+}
+
+std::vector<size_t> ProjectExporter::GetLoadOrder(const GV_Project_Info& project)
+{
+    std::vector<size_t> order;
+    for (size_t s = 0; s < project.scenes.size(); ++s)
+        if (project.scenes[s].scenePath == project.startupScene)
+            order.push_back(s);
+    for (size_t s = 0; s < project.scenes.size(); ++s)
+        if (project.scenes[s].scenePath != project.startupScene)
+            order.push_back(s);
+
+    return order;
+}
+
+std::vector<char> ProjectExporter::BuildSceneObjectChunk(const SceneObject& obj) const
+{
+    std::vector<char> payload;
+
+    std::vector<char> name;
+    AppendString(name, obj.name);
+    AppendChunk(payload, GV_CHUNK_STRING, GV_CHUNK_VERSION, name);
+
+    if (obj.def && obj.def->def)
+        AppendChunk(payload, GV_CHUNK_LOGIC_UNIT, GV_CHUNK_VERSION, BuildLogicUnitChunk(*obj.def));
+
+    return payload;
+}
+
+std::vector<char> ProjectExporter::BuildLogicUnitChunk(const GV_Logic_Unit_Instance& inst) const
+{
+    const GV_Logic_Unit& def = *inst.def;
+    size_t count = std::min(def.params.size(), inst.values.size());
+
+    std::vector<char> payload;
+    AppendString(payload, def.typeName);
+    AppendU32(payload, def.chunkType);
+
+    uint32_t paramCount = 0;
+    for (size_t i = 0; i < count; ++i)
+        if (def.params[i].type != ParamType::Separator)
+            ++paramCount;
+
+    AppendU32(payload, paramCount);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const LU_Param_Def& pDef = def.params[i];
+        const LU_Param_Val& pVal = inst.values[i];
+
+        if (pDef.type == ParamType::Separator)
+            continue;
+
+        AppendU32(payload, static_cast<uint32_t>(pDef.type));
+
+        switch (pDef.type)
+        {
+        case ParamType::Float:
+            AppendF32(payload, pVal.fval);
+            break;
+
+        case ParamType::Int:
+            AppendU32(payload, static_cast<uint32_t>(pVal.ival));
+            break;
+
+        case ParamType::Bool:
+            AppendU32(payload, pVal.bval ? 1 : 0);
+            break;
+
+        case ParamType::String:
+            AppendString(payload, pVal.sval);
+            break;
+
+        case ParamType::Event:
+        case ParamType::Message:
+            AppendU32(payload, m_events.GetId(pVal.sval));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    return payload;
+}
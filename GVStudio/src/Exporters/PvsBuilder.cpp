@@ -0,0 +1,254 @@
+#include "Exporters/PvsBuilder.h"
+#include "Exporters/TriangleBVH.h"
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace
+{
+    // xorshift32: deterministic per pair so exports are reproducible.
+    struct SampleRng
+    {
+        uint32_t state;
+
+        explicit SampleRng(uint32_t seed) : state(seed * 2654435761u + 1u) {}
+
+        float Next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    // Stay off the bounds faces: floors and walls usually lie exactly on them.
+    Vec3 SamplePoint(const WorldSector& sector, SampleRng& rng)
+    {
+        const float inset = 0.02f;
+        Vec3 size = sector.boundsMax - sector.boundsMin;
+
+        auto pick = [&](float lo, float extent)
+            {
+                return lo + extent * (inset + (1.0f - 2.0f * inset) * rng.Next());
+            };
+
+        return Vec3(
+            pick(sector.boundsMin.x, size.x),
+            pick(sector.boundsMin.y, size.y),
+            pick(sector.boundsMin.z, size.z));
+    }
+
+    Vec3 Centre(const WorldSector& sector)
+    {
+        return (sector.boundsMin + sector.boundsMax) * 0.5f;
+    }
+}
+
+void PvsBuilder::SetVisible(uint32_t a, uint32_t b)
+{
+    m_bits[a * m_rowBytes + b / 8] |= static_cast<uint8_t>(1u << (b % 8));
+}
+
+void PvsBuilder::Build(const std::vector<WorldSector>& sectors,
+    const TriangleBVH& occluders,
+    const PvsSettings& settings)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    m_sectorCount = static_cast<uint32_t>(sectors.size());
+    m_rowBytes = (m_sectorCount + 7) / 8;
+    m_bits.assign(static_cast<size_t>(m_rowBytes) * m_sectorCount, 0);
+    m_occluderCount = occluders.GetTriangleCount();
+
+    for (uint32_t s = 0; s < m_sectorCount; ++s)
+        SetVisible(s, s);
+
+    // Visibility is symmetric: test each unordered pair once.
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t a = 0; a < m_sectorCount; ++a)
+        for (uint32_t b = a + 1; b < m_sectorCount; ++b)
+            pairs.emplace_back(a, b);
+
+    std::vector<uint8_t> visible(pairs.size(), 0);
+    std::atomic<size_t> next{ 0 };
+    std::atomic<uint64_t> rays{ 0 };
+
+    auto worker = [&]()
+        {
+            uint64_t localRays = 0;
+
+            for (;;)
+            {
+                size_t index = next.fetch_add(1);
+                if (index >= pairs.size())
+                    break;
+
+                const WorldSector& a = sectors[pairs[index].first];
+                const WorldSector& b = sectors[pairs[index].second];
+
+                // Centre to centre first: open areas resolve in one ray.
+                ++localRays;
+                if (!occluders.Occluded(Centre(a), Centre(b)))
+                {
+                    visible[index] = 1;
+                    continue;
+                }
+
+                SampleRng rng(static_cast<uint32_t>(index));
+
+                for (uint32_t r = 1; r < settings.raysPerPair; ++r)
+                {
+                    ++localRays;
+                    if (!occluders.Occluded(SamplePoint(a, rng), SamplePoint(b, rng)))
+                    {
+                        visible[index] = 1;
+                        break;
+                    }
+                }
+            }
+
+            rays += localRays;
+        };
+
+    uint32_t threadCount = settings.threads ? settings.threads : std::thread::hardware_concurrency();
+    threadCount = std::max(1u, std::min<uint32_t>(threadCount, static_cast<uint32_t>(pairs.size())));
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < threadCount; ++t)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (!visible[i])
+            continue;
+
+        SetVisible(pairs[i].first, pairs[i].second);
+        SetVisible(pairs[i].second, pairs[i].first);
+    }
+
+    m_raysCast = rays;
+    m_threadCount = threadCount;
+    m_buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool PvsBuilder::IsVisible(uint32_t from, uint32_t to) const
+{
+    return (m_bits[from * m_rowBytes + to / 8] >> (to % 8)) & 1;
+}
+
+uint32_t PvsBuilder::GetVisibleCount(uint32_t from) const
+{
+    uint32_t count = 0;
+    for (uint32_t to = 0; to < m_sectorCount; ++to)
+        count += IsVisible(from, to) ? 1 : 0;
+    return count;
+}
+
+uint32_t PvsBuilder::GetSectorCount() const
+{
+    return m_sectorCount;
+}
+
+std::vector<uint8_t> PvsBuilder::CompressRow(const uint8_t* row, uint32_t rowBytes)
+{
+    std::vector<uint8_t> out;
+
+    for (uint32_t i = 0; i < rowBytes; )
+    {
+        if (row[i] != 0)
+        {
+            out.push_back(row[i++]);
+            continue;
+        }
+
+        uint32_t run = 0;
+        while (i < rowBytes && row[i] == 0 && run < 255)
+        {
+            ++run;
+            ++i;
+        }
+
+        out.push_back(0);
+        out.push_back(static_cast<uint8_t>(run));
+    }
+
+    return out;
+}
+
+std::vector<uint8_t> PvsBuilder::DecompressRow(const uint8_t* data, size_t size, uint32_t rowBytes)
+{
+    std::vector<uint8_t> row;
+    row.reserve(rowBytes);
+
+    for (size_t i = 0; i < size && row.size() < rowBytes; ++i)
+    {
+        if (data[i] != 0)
+        {
+            row.push_back(data[i]);
+            continue;
+        }
+
+        uint32_t run = (i + 1 < size) ? data[++i] : 0;
+        row.insert(row.end(), run, 0);
+    }
+
+    row.resize(rowBytes, 0);
+    return row;
+}
+
+std::vector<char> PvsBuilder::BuildChunk() const
+{
+    std::vector<uint8_t> blob;
+    std::vector<uint32_t> offsets;
+
+    for (uint32_t s = 0; s < m_sectorCount; ++s)
+    {
+        offsets.push_back(static_cast<uint32_t>(blob.size()));
+
+        std::vector<uint8_t> row = CompressRow(&m_bits[s * m_rowBytes], m_rowBytes);
+        blob.insert(blob.end(), row.begin(), row.end());
+    }
+
+    offsets.push_back(static_cast<uint32_t>(blob.size()));
+
+    std::vector<char> payload;
+    AppendU32(payload, m_sectorCount);
+    AppendU32(payload, m_rowBytes);
+
+    for (uint32_t offset : offsets)
+        AppendU32(payload, offset);
+
+    payload.insert(payload.end(), blob.begin(), blob.end());
+    payload.resize((payload.size() + 3) & ~size_t(3), 0);
+    return payload;
+}
+
+void PvsBuilder::Report(const std::string& sceneName) const
+{
+    uint64_t visibleTotal = 0;
+    for (uint32_t s = 0; s < m_sectorCount; ++s)
+        visibleTotal += GetVisibleCount(s);
+
+    double average = m_sectorCount ? static_cast<double>(visibleTotal) / m_sectorCount : 0.0;
+    double percent = m_sectorCount ? 100.0 * average / m_sectorCount : 0.0;
+
+    std::cout << "[PVS] " << sceneName << ": " << m_sectorCount << " sectors, "
+        << m_occluderCount << " occluder triangles, "
+        << m_raysCast << " rays on " << m_threadCount << " threads in "
+        << static_cast<uint32_t>(m_buildMs) << " ms\n";
+
+    std::cout << "[PVS] " << sceneName << ": average visible set "
+        << average << " / " << m_sectorCount << " sectors ("
+        << static_cast<uint32_t>(percent + 0.5) << "%), "
+        << BuildChunk().size() << " bytes\n";
+}
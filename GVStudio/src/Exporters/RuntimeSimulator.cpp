@@ -0,0 +1,763 @@
+#include "Exporters/RuntimeSimulator.h"
+#include "Exporters/GeDisplayList.h"
+#include "Exporters/MemoryPlan.h"
+#include "Exporters/PerfectHash.h"
+#include "Exporters/PvsBuilder.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    bool IsPowerOfTwo(uint32_t value)
+    {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    std::vector<char> Slice(const std::vector<char>& data, size_t begin, size_t end)
+    {
+        return std::vector<char>(data.begin() + begin, data.begin() + end);
+    }
+
+    void StoreU32(char* dest, uint32_t value)
+    {
+        dest[0] = static_cast<char>(value & 0xFF);
+        dest[1] = static_cast<char>((value >> 8) & 0xFF);
+        dest[2] = static_cast<char>((value >> 16) & 0xFF);
+        dest[3] = static_cast<char>((value >> 24) & 0xFF);
+    }
+
+    uint32_t LoadU32(const char* src)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+        return static_cast<uint32_t>(p[0]) |
+            (static_cast<uint32_t>(p[1]) << 8) |
+            (static_cast<uint32_t>(p[2]) << 16) |
+            (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    std::string ToHex(uint32_t value)
+    {
+        char text[12];
+        std::snprintf(text, sizeof(text), "%08X", value);
+        return text;
+    }
+
+    std::string JsonString(const std::string& value)
+    {
+        std::string out = "\"";
+        for (char c : value)
+        {
+            switch (c)
+            {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+        return out + "\"";
+    }
+
+    struct PlanSlot
+    {
+        MemoryPlanKind kind = MemoryPlanKind::ObjectArray;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint32_t align = 4;
+        uint32_t count = 0;
+    };
+
+    struct PendingList
+    {
+        std::string mesh;
+        uint32_t list = 0;     // address of the copied command words
+        uint32_t words = 0;
+        uint32_t vertices = 0; // address of the mesh's vertex buffer
+        std::vector<GeRelocation> relocations;
+    };
+
+    // Textures stream from the pack after the scene, so their relocations
+    // are patched against a placeholder in VRAM.
+    const uint32_t kVramBase = 0x04000000;
+    const uint32_t kVramTextureStride = 0x8000;
+}
+
+// Two-ended stack over the user partition: resident data grows up from the
+// bottom, load-time buffers grow down from the top and are dropped together.
+class RuntimeSimulator::Heap
+{
+public:
+    Heap(const SimulatorSettings& settings, SimSceneReport& report)
+        : m_settings(settings)
+        , m_report(report)
+        , m_memory(settings.memoryCap)
+        , m_top(settings.memoryCap)
+    {
+    }
+
+    bool Alloc(const std::string& label, uint32_t size, uint32_t align, bool temporary, uint32_t& address)
+    {
+        if (!IsPowerOfTwo(align) || align < 4)
+            return Fail(label + ": bad alignment " + std::to_string(align));
+
+        uint64_t start = 0;
+        if (temporary)
+        {
+            if (size > m_top)
+                return Fail(label + ": out of memory");
+
+            start = (m_top - size) & ~static_cast<uint64_t>(align - 1);
+            if (start < m_bottom)
+                return Fail(label + ": out of memory");
+
+            m_top = static_cast<uint32_t>(start);
+        }
+        else
+        {
+            start = (static_cast<uint64_t>(m_bottom) + align - 1) & ~static_cast<uint64_t>(align - 1);
+            if (start + size > m_top)
+                return Fail(label + ": out of memory");
+
+            m_bottom = static_cast<uint32_t>(start + size);
+        }
+
+        address = m_settings.userBase + static_cast<uint32_t>(start);
+        if (address % align != 0)
+            return Fail(label + ": misaligned at 0x" + ToHex(address));
+
+        SimAllocation alloc;
+        alloc.label = label;
+        alloc.address = address;
+        alloc.size = size;
+        alloc.align = align;
+        alloc.temporary = temporary;
+        m_report.allocations.push_back(alloc);
+
+        m_peak = std::max(m_peak, m_bottom + (m_settings.memoryCap - m_top));
+        return true;
+    }
+
+    void FreeTemporary()
+    {
+        m_top = m_settings.memoryCap;
+    }
+
+    char* At(uint32_t address)
+    {
+        return m_memory.data() + (address - m_settings.userBase);
+    }
+
+    uint32_t GetPeak() const { return m_peak; }
+    uint32_t GetResident() const { return m_bottom; }
+
+    bool Fail(const std::string& error)
+    {
+        if (m_report.error.empty())
+            m_report.error = error;
+        return false;
+    }
+
+private:
+    const SimulatorSettings& m_settings;
+    SimSceneReport& m_report;
+    std::vector<char> m_memory;
+    uint32_t m_bottom = 0;
+    uint32_t m_top = 0;
+    uint32_t m_peak = 0;
+};
+
+RuntimeSimulator::RuntimeSimulator(const SimulatorSettings& settings)
+    : m_settings(settings)
+{
+}
+
+bool RuntimeSimulator::LoadScene(const std::string& path)
+{
+    SimSceneReport best;
+    best.scene = fs::path(path).stem().string();
+    best.path = path;
+
+    const uint32_t iterations = std::max<uint32_t>(m_settings.iterations, 1);
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        SimSceneReport run;
+        run.scene = best.scene;
+        run.path = path;
+
+        Clock::time_point start = Clock::now();
+
+        std::vector<char> data;
+        if (!ChunkReader::ReadFile(path, data))
+        {
+            best.error = "cannot read file";
+            break;
+        }
+
+        run.readMs = ElapsedMs(start);
+        run.ok = LoadOnce(data, run);
+        run.totalMs = run.readMs + run.verifyMs + run.parseMs + run.decompressMs + run.fixupMs;
+
+        if (i == 0 || !run.ok)
+        {
+            best = run;
+            if (!run.ok)
+                break;
+            continue;
+        }
+
+        best.readMs = std::min(best.readMs, run.readMs);
+        best.verifyMs = std::min(best.verifyMs, run.verifyMs);
+        best.parseMs = std::min(best.parseMs, run.parseMs);
+        best.decompressMs = std::min(best.decompressMs, run.decompressMs);
+        best.fixupMs = std::min(best.fixupMs, run.fixupMs);
+        best.totalMs = std::min(best.totalMs, run.totalMs);
+    }
+
+    const UmdCostModel& umd = m_settings.umd;
+    best.umdReadMs = umd.seekMs + static_cast<double>(best.fileBytes) / 1024.0 / umd.transferKBps * 1000.0;
+
+    std::cout << "[Simulator] " << best.scene << ": ";
+    if (best.ok)
+    {
+        std::cout << std::fixed << std::setprecision(2)
+            << "peak " << best.peakBytes << " / " << m_settings.memoryCap << " bytes, resident "
+            << best.residentBytes << ", " << best.allocations.size() << " allocations, "
+            << best.totalMs << " ms (parse " << best.parseMs << ", decompress " << best.decompressMs
+            << ", fixup " << best.fixupMs << "), ~" << static_cast<uint32_t>(best.umdReadMs) << " ms UMD\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    else
+    {
+        std::cout << "FAILED: " << best.error << "\n";
+    }
+
+    m_reports.push_back(best);
+    return best.ok;
+}
+
+bool RuntimeSimulator::LoadOnce(const std::vector<char>& data, SimSceneReport& report) const
+{
+    report.fileBytes = data.size();
+
+    Heap heap(m_settings, report);
+
+    // Verify
+
+    Clock::time_point start = Clock::now();
+
+    if (m_settings.verifyChecksums)
+    {
+        ChunkReader reader(data);
+        if (reader.EnableChecksums())
+        {
+            GV_ChunkView chunk;
+            while (reader.Next(chunk))
+            {
+            }
+
+            if (reader.IsCorrupt())
+                return heap.Fail("checksum mismatch");
+
+            report.checksumsVerified = reader.GetVerifiedCount();
+        }
+    }
+
+    report.verifyMs = ElapsedMs(start);
+
+    // Parse: the file lands in a load buffer, resident chunks are copied out
+
+    start = Clock::now();
+
+    uint32_t fileBuffer = 0;
+    if (!heap.Alloc("File", static_cast<uint32_t>(data.size()), 64, true, fileBuffer))
+        return false;
+
+    const char* file = heap.At(fileBuffer);
+    std::memcpy(heap.At(fileBuffer), data.data(), data.size());
+
+    uint32_t arena = 0;
+    bool hasPlan = false;
+    std::map<std::string, PlanSlot> meshSlots;
+    PlanSlot objectSlot;
+    PlanSlot eventSlot;
+    bool hasEventSlot = false;
+    std::map<std::string, PlanSlot> nameSlots;
+    std::map<std::string, PlanSlot> stringSlots;
+
+    std::vector<PendingList> lists;
+    GV_ChunkView pvs;
+    bool hasPvs = false;
+    uint32_t sectorIndex = 0;
+
+    ChunkReader reader(file, data.size());
+    GV_ChunkView chunk;
+
+    while (reader.Next(chunk))
+    {
+        ++report.chunks;
+
+        if (chunk.type == GV_CHUNK_MEMORY_PLAN)
+        {
+            std::vector<char> payload = Slice(data, chunk.payload, chunk.GetEnd());
+            if (!MemoryPlan::Simulate(payload, data.data(), data.size()))
+                return heap.Fail("memory plan does not replay");
+
+            size_t at = 0;
+            const uint32_t arenaSize = ReadU32(payload, at);
+            const uint32_t arenaAlign = ReadU32(payload, at);
+            const uint32_t count = ReadU32(payload, at);
+
+            if (!heap.Alloc("Arena", arenaSize, arenaAlign, false, arena))
+                return false;
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                PlanSlot slot;
+                slot.kind = static_cast<MemoryPlanKind>(ReadU32(payload, at));
+                slot.offset = ReadU32(payload, at);
+                slot.size = ReadU32(payload, at);
+                slot.align = ReadU32(payload, at);
+                slot.count = ReadU32(payload, at);
+                ReadU32(payload, at); // element size
+                const std::string label = ReadString(payload, at);
+
+                const bool geBuffer = slot.kind == MemoryPlanKind::MeshBuffer ||
+                    slot.kind == MemoryPlanKind::TextureBuffer ||
+                    slot.kind == MemoryPlanKind::ClutBuffer;
+
+                if (geBuffer && slot.align < m_settings.geAlign)
+                    return heap.Fail(label + ": GE buffer aligned to " + std::to_string(slot.align));
+
+                if (slot.kind == MemoryPlanKind::MeshBuffer)
+                    meshSlots[label] = slot;
+                else if (slot.kind == MemoryPlanKind::ObjectArray)
+                    objectSlot = slot;
+                else if (slot.kind == MemoryPlanKind::EventTable)
+                {
+                    eventSlot = slot;
+                    hasEventSlot = true;
+                }
+                else if (slot.kind == MemoryPlanKind::NameHash)
+                    nameSlots[label] = slot;
+                else if (slot.kind == MemoryPlanKind::NameStrings)
+                    stringSlots[label] = slot;
+            }
+
+            hasPlan = true;
+            continue;
+        }
+
+        if (!hasPlan && chunk.type != GV_CHUNK_CHECKSUMS)
+            return heap.Fail("first chunk is not a memory plan");
+
+        switch (chunk.type)
+        {
+        case GV_CHUNK_SCENE_OBJECT:
+            ++report.objects;
+            break;
+
+        case GV_CHUNK_EVENT_TABLE:
+            if (chunk.size == 0)
+                break;
+
+            if (!hasEventSlot || chunk.size > eventSlot.size)
+                return heap.Fail("event table does not fit its plan slot");
+
+            std::memcpy(heap.At(arena + eventSlot.offset), file + chunk.payload, chunk.size);
+            break;
+
+        case GV_CHUNK_NAME_HASH:
+        {
+            // Tables and names go to their own slots; Simulate() checked
+            // that both fit.
+            std::vector<char> payload = Slice(data, chunk.payload, chunk.GetEnd());
+            size_t at = 0;
+            const uint32_t kind = ReadU32(payload, at);
+            const uint32_t keys = ReadU32(payload, at);
+            const uint32_t buckets = ReadU32(payload, at);
+            const size_t tableBytes = 4 * (4 + static_cast<size_t>(buckets) + 2 * static_cast<size_t>(keys) + 1);
+
+            const std::string label = kind == static_cast<uint32_t>(NameHashKind::Objects) ? "Object Names" : "Asset Names";
+            auto table = nameSlots.find(label);
+            auto strings = stringSlots.find(label);
+            if (table == nameSlots.end() || strings == stringSlots.end())
+                return heap.Fail(label + ": no name hash in the memory plan");
+
+            std::memcpy(heap.At(arena + table->second.offset), file + chunk.payload, tableBytes);
+            std::memcpy(heap.At(arena + strings->second.offset), file + chunk.payload + tableBytes, chunk.size - tableBytes);
+            break;
+        }
+
+        case GV_CHUNK_STATIC_MESH:
+        {
+            ++report.meshes;
+
+            std::string name;
+            uint32_t vertices = 0;
+            ChunkReader parts = reader.Children(chunk);
+            GV_ChunkView part;
+
+            while (parts.Next(part))
+            {
+                if (part.type == GV_CHUNK_STRUCT)
+                {
+                    size_t at = 0;
+                    name = ReadString(Slice(data, part.payload, part.GetEnd()), at);
+                }
+                else if (part.type == GV_CHUNK_GEOMETRY)
+                {
+                    auto it = meshSlots.find(name);
+                    if (it == meshSlots.end())
+                        return heap.Fail(name + ": no vertex buffer in the memory plan");
+
+                    if (part.size > it->second.size)
+                        return heap.Fail(name + ": vertex data overflows its plan slot");
+
+                    vertices = arena + it->second.offset;
+                    std::memcpy(heap.At(vertices), file + part.payload, part.size);
+                }
+                else if (part.type == GV_CHUNK_NATIVEDATA_PLG)
+                {
+                    std::vector<char> payload = Slice(data, part.payload, part.GetEnd());
+                    size_t at = 0;
+
+                    ReadU32(payload, at); // stride
+                    PendingList pending;
+                    pending.mesh = name;
+                    pending.vertices = vertices;
+                    pending.words = ReadU32(payload, at);
+
+                    if (!heap.Alloc(name + " list", pending.words * 4, m_settings.geAlign, false, pending.list))
+                        return false;
+
+                    if (at + pending.words * 4 > payload.size())
+                        return heap.Fail(name + ": truncated display list");
+
+                    std::memcpy(heap.At(pending.list), payload.data() + at, pending.words * 4);
+                    at += pending.words * 4;
+
+                    const uint32_t count = ReadU32(payload, at);
+                    for (uint32_t r = 0; r < count && at < payload.size(); ++r)
+                    {
+                        GeRelocation reloc;
+                        reloc.word = ReadU32(payload, at);
+                        reloc.target = static_cast<GeRelocTarget>(ReadU32(payload, at));
+                        reloc.index = ReadU32(payload, at);
+                        reloc.offset = ReadU32(payload, at);
+                        reloc.high = ReadU32(payload, at) != 0;
+                        pending.relocations.push_back(reloc);
+                    }
+
+                    lists.push_back(std::move(pending));
+                }
+                else if (part.type == GV_CHUNK_LIGHTMAP_UV)
+                {
+                    uint32_t address = 0;
+                    if (!heap.Alloc(name + " lightmap UVs", part.size, 4, false, address))
+                        return false;
+
+                    std::memcpy(heap.At(address), file + part.payload, part.size);
+                }
+            }
+            break;
+        }
+
+        case GV_CHUNK_WORLD_SECTOR:
+        {
+            uint32_t address = 0;
+            if (!heap.Alloc("Sector " + std::to_string(sectorIndex++), chunk.size, m_settings.geAlign, false, address))
+                return false;
+
+            std::memcpy(heap.At(address), file + chunk.payload, chunk.size);
+            break;
+        }
+
+        case GV_CHUNK_PVS:
+            pvs = chunk;
+            hasPvs = true;
+            break;
+
+        case GV_CHUNK_LIGHTMAP:
+        {
+            ChunkReader pages = reader.Children(chunk, 8);
+            GV_ChunkView page;
+
+            while (pages.Next(page))
+            {
+                if (page.type != GV_CHUNK_TEXTURE_NATIVE)
+                    break;
+
+                uint32_t address = 0;
+                if (!heap.Alloc("Lightmap " + std::to_string(report.lightmapPages++), page.size,
+                    m_settings.geAlign, false, address))
+                    return false;
+
+                std::memcpy(heap.At(address), file + page.payload, page.size);
+            }
+            break;
+        }
+
+        case GV_CHUNK_CHECKSUMS:
+            break;
+
+        default:
+        {
+            // The BSP and anything newer stay resident as-is.
+            std::string label = chunk.type == GV_CHUNK_WORLD ? "BSP" : "Chunk 0x" + ToHex(chunk.type);
+
+            uint32_t address = 0;
+            if (chunk.size > 0 && !heap.Alloc(label, chunk.size, 4, false, address))
+                return false;
+
+            if (chunk.size > 0)
+                std::memcpy(heap.At(address), file + chunk.payload, chunk.size);
+            break;
+        }
+        }
+    }
+
+    if (!reader.IsValid())
+        return heap.Fail("truncated chunk");
+
+    if (!hasPlan)
+        return heap.Fail("no memory plan");
+
+    if (report.objects > objectSlot.count)
+        return heap.Fail("more objects than the plan's object array");
+
+    report.parseMs = ElapsedMs(start);
+
+    // Decompress: PVS rows are expanded into one resident bitset
+
+    start = Clock::now();
+
+    if (hasPvs)
+    {
+        std::vector<char> payload = Slice(data, pvs.payload, pvs.GetEnd());
+        size_t at = 0;
+        const uint32_t sectors = ReadU32(payload, at);
+        const uint32_t rowBytes = ReadU32(payload, at);
+
+        if (at + (static_cast<size_t>(sectors) + 1) * 4 > payload.size())
+            return heap.Fail("truncated PVS");
+
+        uint32_t bits = 0;
+        if (!heap.Alloc("PVS", sectors * rowBytes, 4, false, bits))
+            return false;
+
+        const size_t blob = at + (static_cast<size_t>(sectors) + 1) * 4;
+        const uint8_t* compressed = reinterpret_cast<const uint8_t*>(payload.data() + blob);
+
+        for (uint32_t s = 0; s < sectors; ++s)
+        {
+            const uint32_t begin = LoadU32(payload.data() + at + s * 4);
+            const uint32_t end = LoadU32(payload.data() + at + (s + 1) * 4);
+
+            if (begin > end || blob + end > payload.size())
+                return heap.Fail("PVS row " + std::to_string(s) + " out of range");
+
+            std::vector<uint8_t> row = PvsBuilder::DecompressRow(compressed + begin, end - begin, rowBytes);
+            std::memcpy(heap.At(bits + s * rowBytes), row.data(), rowBytes);
+            ++report.pvsRows;
+        }
+    }
+
+    report.decompressMs = ElapsedMs(start);
+
+    // Fixup: display list addresses are patched in place
+
+    start = Clock::now();
+
+    for (const PendingList& pending : lists)
+    {
+        char* words = heap.At(pending.list);
+
+        for (const GeRelocation& reloc : pending.relocations)
+        {
+            if (reloc.word >= pending.words)
+                return heap.Fail(pending.mesh + ": relocation past the end of the list");
+
+            uint32_t target = 0;
+            switch (reloc.target)
+            {
+            case GeRelocTarget::VertexBuffer:
+                if (pending.vertices == 0)
+                    return heap.Fail(pending.mesh + ": list relocates a missing vertex buffer");
+                target = pending.vertices;
+                break;
+            case GeRelocTarget::Texture:
+            case GeRelocTarget::Clut:
+                target = kVramBase + reloc.index * kVramTextureStride;
+                break;
+            default:
+                return heap.Fail(pending.mesh + ": unknown relocation target");
+            }
+
+            target += reloc.offset;
+
+            const uint32_t mask = reloc.high ? 0x0F0000 : 0xFFFFFF;
+            const uint32_t value = reloc.high ? (target >> 8) & 0x0F0000 : target & 0xFFFFFF;
+
+            uint32_t word = LoadU32(words + reloc.word * 4);
+            StoreU32(words + reloc.word * 4, (word & ~mask) | value);
+            ++report.relocations;
+        }
+    }
+
+    report.fixupMs = ElapsedMs(start);
+
+    heap.FreeTemporary();
+    report.peakBytes = heap.GetPeak();
+    report.residentBytes = heap.GetResident();
+    return true;
+}
+
+bool RuntimeSimulator::LoadFolder(const std::string& dataDir)
+{
+    std::vector<fs::path> scenes;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dataDir, ec))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".gvs")
+            scenes.push_back(entry.path());
+    }
+
+    if (scenes.empty())
+    {
+        std::cout << "[Simulator] No scenes in " << dataDir << "\n";
+        return false;
+    }
+
+    std::sort(scenes.begin(), scenes.end());
+
+    bool ok = true;
+    for (const fs::path& scene : scenes)
+        ok = LoadScene(scene.string()) && ok;
+
+    return ok;
+}
+
+const std::vector<SimSceneReport>& RuntimeSimulator::GetReports() const
+{
+    return m_reports;
+}
+
+bool RuntimeSimulator::WriteReport(const std::string& path) const
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cout << "[Simulator] Cannot write " << path << "\n";
+        return false;
+    }
+
+    uint32_t peak = 0;
+    bool ok = true;
+    for (const SimSceneReport& report : m_reports)
+    {
+        peak = std::max(peak, report.peakBytes);
+        ok = ok && report.ok;
+    }
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"memoryCap\": " << m_settings.memoryCap << ",\n";
+    out << "  \"userBase\": " << m_settings.userBase << ",\n";
+    out << "  \"iterations\": " << m_settings.iterations << ",\n";
+    out << "  \"ok\": " << (ok ? "true" : "false") << ",\n";
+    out << "  \"peakBytes\": " << peak << ",\n";
+    out << "  \"scenes\": [";
+
+    for (size_t s = 0; s < m_reports.size(); ++s)
+    {
+        const SimSceneReport& r = m_reports[s];
+
+        out << (s ? ",\n" : "\n") << "    {\n";
+        out << "      \"scene\": " << JsonString(r.scene) << ",\n";
+        out << "      \"path\": " << JsonString(r.path) << ",\n";
+        out << "      \"ok\": " << (r.ok ? "true" : "false") << ",\n";
+        out << "      \"error\": " << JsonString(r.error) << ",\n";
+        out << "      \"fileBytes\": " << r.fileBytes << ",\n";
+        out << "      \"chunks\": " << r.chunks << ",\n";
+        out << "      \"checksumsVerified\": " << r.checksumsVerified << ",\n";
+        out << "      \"meshes\": " << r.meshes << ",\n";
+        out << "      \"objects\": " << r.objects << ",\n";
+        out << "      \"relocations\": " << r.relocations << ",\n";
+        out << "      \"pvsRows\": " << r.pvsRows << ",\n";
+        out << "      \"lightmapPages\": " << r.lightmapPages << ",\n";
+        out << "      \"peakBytes\": " << r.peakBytes << ",\n";
+        out << "      \"residentBytes\": " << r.residentBytes << ",\n";
+        out << "      \"headroomBytes\": " << (r.ok ? m_settings.memoryCap - r.peakBytes : 0) << ",\n";
+        out << "      \"timeMs\": { \"read\": " << r.readMs
+            << ", \"verify\": " << r.verifyMs
+            << ", \"parse\": " << r.parseMs
+            << ", \"decompress\": " << r.decompressMs
+            << ", \"fixup\": " << r.fixupMs
+            << ", \"total\": " << r.totalMs
+            << ", \"umdModel\": " << r.umdReadMs << " },\n";
+        out << "      \"allocations\": [";
+
+        for (size_t a = 0; a < r.allocations.size(); ++a)
+        {
+            const SimAllocation& alloc = r.allocations[a];
+            out << (a ? ",\n" : "\n")
+                << "        { \"label\": " << JsonString(alloc.label)
+                << ", \"address\": " << alloc.address
+                << ", \"size\": " << alloc.size
+                << ", \"align\": " << alloc.align
+                << ", \"temporary\": " << (alloc.temporary ? "true" : "false") << " }";
+        }
+
+        out << (r.allocations.empty() ? "]\n" : "\n      ]\n");
+        out << "    }";
+    }
+
+    out << (m_reports.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+
+    std::cout << "[Simulator] Report written to " << path << "\n";
+    return static_cast<bool>(out);
+}
+
+bool RuntimeSimulator::Run(const std::string& dataDir, const std::string& reportPath,
+    const SimulatorSettings& settings)
+{
+    RuntimeSimulator simulator(settings);
+    bool ok = simulator.LoadFolder(dataDir);
+
+    std::string path = reportPath.empty() ? (fs::path(dataDir) / "RuntimeReport.json").string() : reportPath;
+    return simulator.WriteReport(path) && ok;
+}
@@ -0,0 +1,431 @@
+#include "Exporters/SharedChunkPack.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "GVFramework/Chunk/ChunkReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const uint32_t STORE_SECTOR = 2048;
+
+    uint32_t AlignTo(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool IsContainer(uint32_t type)
+    {
+        return type == GV_CHUNK_SCENE_OBJECT ||
+            type == GV_CHUNK_STATIC_MESH ||
+            type == GV_CHUNK_WORLD_SECTOR;
+    }
+
+    // Scene 0 is the most significant bit, so every group the first scene
+    // reads lands in one contiguous block, the second scene's next, etc.
+    bool ReadersBefore(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b)
+    {
+        size_t n = std::min(a.size(), b.size());
+        for (size_t i = 0; i < n; ++i)
+            if (a[i] != b[i])
+                return a[i] < b[i];
+
+        return a.size() > b.size();
+    }
+
+    bool Contains(const std::vector<uint32_t>& scenes, uint32_t scene)
+    {
+        return std::binary_search(scenes.begin(), scenes.end(), scene);
+    }
+}
+
+SharedChunkPack::SharedChunkPack(const SharedPackSettings& settings)
+    : m_settings(settings)
+{
+}
+
+bool SharedChunkPack::AddScene(const std::string& sceneName, const std::vector<char>& sceneData)
+{
+    uint32_t sceneIndex = static_cast<uint32_t>(m_sceneNames.size());
+
+    m_sceneNames.push_back(sceneName);
+    m_sceneEntries.emplace_back();
+    m_sceneBytes.push_back(sceneData.size());
+    m_sceneUseOrder.emplace_back();
+
+    if (!SplitChunks(sceneData, 0, sceneData.size(), sceneIndex, m_sceneEntries.back()))
+    {
+        std::cout << "[SharedPack] Failed to split scene: " << sceneName << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool SharedChunkPack::SplitChunks(const std::vector<char>& data, size_t begin, size_t end,
+    uint32_t sceneIndex, std::vector<Entry>& out)
+{
+    ChunkReader reader(data.data(), data.size(), begin, end);
+    GV_ChunkView chunk;
+
+    while (reader.Next(chunk))
+    {
+        Entry entry;
+        entry.type = chunk.type;
+        entry.version = chunk.version;
+
+        if (IsContainer(chunk.type) && chunk.size > 0)
+        {
+            // Containers are rebuilt from their children at load time, so
+            // only split them when the payload is a clean chunk sequence.
+            std::vector<Entry> children;
+            ChunkReader probe = reader.Children(chunk);
+            GV_ChunkView child;
+            while (probe.Next(child)) {}
+
+            if (probe.IsValid() && SplitChunks(data, chunk.payload, chunk.GetEnd(), sceneIndex, children))
+            {
+                entry.children = std::move(children);
+                out.push_back(std::move(entry));
+                continue;
+            }
+        }
+
+        const char* bytes = data.data() + chunk.start;
+        size_t size = chunk.GetEnd() - chunk.start;
+        entry.hash = XXHash64(bytes, size);
+
+        auto it = m_blobs.find(entry.hash);
+        if (it == m_blobs.end())
+        {
+            Blob blob;
+            blob.bytes.assign(bytes, bytes + size);
+            it = m_blobs.emplace(entry.hash, std::move(blob)).first;
+        }
+        else if (it->second.bytes.size() != size ||
+            std::memcmp(it->second.bytes.data(), bytes, size) != 0)
+        {
+            std::cout << "[SharedPack] Hash collision on chunk type 0x" << std::hex << chunk.type
+                << std::dec << " in " << m_sceneNames[sceneIndex] << "\n";
+            return false;
+        }
+
+        std::vector<uint32_t>& scenes = it->second.scenes;
+        if (scenes.empty() || scenes.back() != sceneIndex)
+        {
+            scenes.push_back(sceneIndex);
+            m_sceneUseOrder[sceneIndex].push_back(entry.hash);
+        }
+
+        out.push_back(std::move(entry));
+    }
+
+    return reader.IsValid();
+}
+
+void SharedChunkPack::Build()
+{
+    m_groups.clear();
+    m_duplicatedBytes = 0;
+
+    // One group per distinct set of scenes, blobs in first-use order.
+    std::map<std::vector<uint32_t>, size_t> groupOf;
+    for (uint32_t s = 0; s < m_sceneUseOrder.size(); ++s)
+    {
+        for (uint64_t hash : m_sceneUseOrder[s])
+        {
+            const Blob& blob = m_blobs[hash];
+            if (blob.scenes.front() != s)
+                continue; // placed by an earlier scene
+
+            auto it = groupOf.find(blob.scenes);
+            if (it == groupOf.end())
+            {
+                Group group;
+                group.readers = blob.scenes;
+                m_groups.push_back(group);
+                it = groupOf.emplace(blob.scenes, m_groups.size() - 1).first;
+            }
+
+            m_groups[it->second].blobs.push_back(hash);
+        }
+    }
+
+    Layout();
+
+    // Bound the reads per scene: while a scene needs too many runs, give it
+    // a private copy of its smallest shared group and lay out again.
+    for (uint32_t s = 0; s < m_sceneNames.size(); ++s)
+    {
+        while (GetReads(s).size() > m_settings.maxReadsPerScene)
+        {
+            if (!PrivatizeSmallestShared(s))
+                break;
+
+            Layout();
+        }
+    }
+}
+
+bool SharedChunkPack::PrivatizeSmallestShared(uint32_t sceneIndex)
+{
+    size_t best = m_groups.size();
+    for (size_t g = 0; g < m_groups.size(); ++g)
+    {
+        const Group& group = m_groups[g];
+        if (group.readers.size() < 2 || !Contains(group.readers, sceneIndex))
+            continue;
+
+        if (best == m_groups.size() || group.size < m_groups[best].size)
+            best = g;
+    }
+
+    if (best == m_groups.size())
+        return false;
+
+    Group copy;
+    copy.readers = { sceneIndex };
+    copy.blobs = m_groups[best].blobs;
+
+    for (uint64_t hash : copy.blobs)
+        m_duplicatedBytes += m_blobs[hash].bytes.size();
+
+    std::vector<uint32_t>& readers = m_groups[best].readers;
+    readers.erase(std::find(readers.begin(), readers.end(), sceneIndex));
+
+    m_groups.push_back(std::move(copy));
+    return true;
+}
+
+void SharedChunkPack::Layout()
+{
+    std::stable_sort(m_groups.begin(), m_groups.end(), [](const Group& a, const Group& b)
+        {
+            return ReadersBefore(a.readers, b.readers);
+        });
+
+    // Groups left with the same readers after privatizing are one group.
+    std::vector<Group> merged;
+    for (Group& group : m_groups)
+    {
+        if (!merged.empty() && merged.back().readers == group.readers)
+            merged.back().blobs.insert(merged.back().blobs.end(), group.blobs.begin(), group.blobs.end());
+        else
+            merged.push_back(std::move(group));
+    }
+    m_groups = std::move(merged);
+
+    size_t copies = 0;
+    for (const Group& group : m_groups)
+        copies += group.blobs.size();
+
+    // chunk header, count, data start, then 16 bytes per TOC entry
+    m_dataStart = AlignTo(static_cast<uint32_t>(12 + 8 + copies * 16), STORE_SECTOR);
+
+    m_offsets.clear();
+    uint32_t offset = m_dataStart;
+
+    for (size_t g = 0; g < m_groups.size(); ++g)
+    {
+        Group& group = m_groups[g];
+        group.offset = offset;
+
+        for (uint64_t hash : group.blobs)
+        {
+            m_offsets[{ g, hash }] = offset;
+            offset += static_cast<uint32_t>(m_blobs[hash].bytes.size());
+        }
+
+        group.size = offset - group.offset;
+        offset = AlignTo(offset, STORE_SECTOR);
+    }
+}
+
+std::vector<SharedChunkPack::Read> SharedChunkPack::GetReads(uint32_t sceneIndex) const
+{
+    std::vector<Read> reads;
+
+    for (const Group& group : m_groups)
+    {
+        if (!Contains(group.readers, sceneIndex) || group.size == 0)
+            continue;
+
+        if (!reads.empty())
+        {
+            Read& last = reads.back();
+            uint32_t end = last.offset + last.size;
+
+            if (group.offset - end <= m_settings.coalesceGapBytes)
+            {
+                last.size = group.offset + group.size - last.offset;
+                continue;
+            }
+        }
+
+        reads.push_back({ group.offset, group.size });
+    }
+
+    return reads;
+}
+
+uint32_t SharedChunkPack::FindBlobOffset(uint32_t sceneIndex, uint64_t hash) const
+{
+    for (size_t g = 0; g < m_groups.size(); ++g)
+    {
+        if (!Contains(m_groups[g].readers, sceneIndex))
+            continue;
+
+        auto it = m_offsets.find({ g, hash });
+        if (it != m_offsets.end())
+            return it->second;
+    }
+
+    return 0;
+}
+
+uint32_t SharedChunkPack::GetStoreSize() const
+{
+    if (m_groups.empty())
+        return m_dataStart;
+
+    return m_groups.back().offset + m_groups.back().size;
+}
+
+void SharedChunkPack::AppendEntries(std::vector<char>& out, uint32_t sceneIndex, const std::vector<Entry>& entries) const
+{
+    AppendU32(out, static_cast<uint32_t>(entries.size()));
+
+    for (const Entry& entry : entries)
+    {
+        AppendU32(out, entry.type);
+        AppendU32(out, entry.version);
+        AppendU32(out, static_cast<uint32_t>(entry.children.size()));
+
+        if (!entry.children.empty())
+        {
+            AppendEntries(out, sceneIndex, entry.children);
+            continue;
+        }
+
+        // Leaves: where to find the whole chunk (header included) in the
+        // scene's reads, plus the hash for verification.
+        AppendU32(out, FindBlobOffset(sceneIndex, entry.hash));
+        AppendU32(out, static_cast<uint32_t>(m_blobs.at(entry.hash).bytes.size()));
+        AppendU32(out, static_cast<uint32_t>(entry.hash));
+        AppendU32(out, static_cast<uint32_t>(entry.hash >> 32));
+    }
+}
+
+bool SharedChunkPack::Write(const std::string& storePath, const std::string& refDir) const
+{
+    std::ofstream out(storePath, std::ios::binary);
+    if (!out.is_open())
+    {
+        std::cout << "[SharedPack] Failed to open: " << storePath << "\n";
+        return false;
+    }
+
+    std::vector<char> payload;
+    payload.reserve(GetStoreSize());
+
+    uint32_t count = 0;
+    for (const Group& group : m_groups)
+        count += static_cast<uint32_t>(group.blobs.size());
+
+    AppendU32(payload, count);
+    AppendU32(payload, m_dataStart);
+
+    for (size_t g = 0; g < m_groups.size(); ++g)
+    {
+        for (uint64_t hash : m_groups[g].blobs)
+        {
+            AppendU32(payload, static_cast<uint32_t>(hash));
+            AppendU32(payload, static_cast<uint32_t>(hash >> 32));
+            AppendU32(payload, m_offsets.at({ g, hash }));
+            AppendU32(payload, static_cast<uint32_t>(m_blobs.at(hash).bytes.size()));
+        }
+    }
+
+    // Offsets are absolute in the file; the payload starts after the header.
+    for (const Group& group : m_groups)
+    {
+        payload.resize(group.offset - 12, 0);
+
+        for (uint64_t hash : group.blobs)
+        {
+            const std::vector<char>& bytes = m_blobs.at(hash).bytes;
+            payload.insert(payload.end(), bytes.begin(), bytes.end());
+        }
+    }
+
+    WriteChunk(out, GV_CHUNK_CHUNK_STORE, GV_CHUNK_VERSION, payload);
+
+    std::string storeName = fs::path(storePath).filename().string();
+
+    for (uint32_t s = 0; s < m_sceneNames.size(); ++s)
+    {
+        fs::path refPath = fs::path(refDir) / (m_sceneNames[s] + ".gvref");
+        std::ofstream ref(refPath, std::ios::binary);
+        if (!ref.is_open())
+        {
+            std::cout << "[SharedPack] Failed to open: " << refPath.string() << "\n";
+            return false;
+        }
+
+        std::vector<char> refPayload;
+        AppendString(refPayload, storeName);
+
+        std::vector<Read> reads = GetReads(s);
+        AppendU32(refPayload, static_cast<uint32_t>(reads.size()));
+        for (const Read& read : reads)
+        {
+            AppendU32(refPayload, read.offset);
+            AppendU32(refPayload, read.size);
+        }
+
+        AppendEntries(refPayload, s, m_sceneEntries[s]);
+        WriteChunk(ref, GV_CHUNK_SCENE_REF, GV_CHUNK_VERSION, refPayload);
+    }
+
+    std::cout << "[SharedPack] Wrote " << storePath << "\n";
+    return true;
+}
+
+void SharedChunkPack::Report() const
+{
+    uint64_t sceneTotal = 0;
+    for (uint64_t bytes : m_sceneBytes)
+        sceneTotal += bytes;
+
+    uint64_t unique = 0;
+    for (const auto& [hash, blob] : m_blobs)
+        unique += blob.bytes.size();
+
+    uint64_t stored = unique + m_duplicatedBytes;
+    int64_t saved = static_cast<int64_t>(sceneTotal) - static_cast<int64_t>(stored);
+
+    std::cout << "[SharedPack] " << m_blobs.size() << " unique chunks, "
+        << stored << " bytes stored for " << sceneTotal << " bytes of scenes ("
+        << saved << " bytes saved, " << m_duplicatedBytes << " duplicated to bound reads)\n";
+
+    for (uint32_t s = 0; s < m_sceneNames.size(); ++s)
+    {
+        std::vector<Read> reads = GetReads(s);
+
+        uint64_t readBytes = 0;
+        for (const Read& read : reads)
+            readBytes += read.size;
+
+        std::cout << "[SharedPack]   " << m_sceneNames[s] << ": "
+            << m_sceneUseOrder[s].size() << " chunks, "
+            << reads.size() << " reads, "
+            << readBytes << " bytes read\n";
+    }
+}
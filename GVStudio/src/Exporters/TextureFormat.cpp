@@ -0,0 +1,70 @@
+#include "Exporters/TextureFormat.h"
+
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+    uint32_t NextPow2(uint32_t value)
+    {
+        uint32_t p = 1;
+        while (p < value)
+            p <<= 1;
+        return p;
+    }
+}
+
+uint32_t TextureFormat::GetDataSize() const
+{
+    return (bufferWidth * bufferHeight * bpp + 7) / 8;
+}
+
+uint32_t TextureFormat::GetClutSize() const
+{
+    return clutEntries * 4;
+}
+
+bool TextureCooker::ReadFormat(const std::string& path, TextureFormat& outFormat)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    unsigned char header[54] = {};
+    if (!file.read(reinterpret_cast<char*>(header), sizeof(header)))
+        return false;
+
+    if (header[0] != 'B' || header[1] != 'M')
+        return false;
+
+    auto le32 = [&](int at)
+        {
+            return static_cast<uint32_t>(header[at]) |
+                (static_cast<uint32_t>(header[at + 1]) << 8) |
+                (static_cast<uint32_t>(header[at + 2]) << 16) |
+                (static_cast<uint32_t>(header[at + 3]) << 24);
+        };
+
+    uint32_t sourceBpp = header[28] | (header[29] << 8);
+
+    outFormat = TextureFormat{};
+    outFormat.width = le32(18);
+    outFormat.height = static_cast<uint32_t>(std::abs(static_cast<int32_t>(le32(22))));
+    outFormat.bufferWidth = NextPow2(outFormat.width);
+    outFormat.bufferHeight = NextPow2(outFormat.height);
+
+    if (sourceBpp <= 4)
+    {
+        outFormat.bpp = 4;
+        outFormat.psm = GePixelFormat::PSM_T4;
+        outFormat.clutEntries = 16;
+    }
+    else if (sourceBpp <= 8)
+    {
+        outFormat.bpp = 8;
+        outFormat.psm = GePixelFormat::PSM_T8;
+        outFormat.clutEntries = 256;
+    }
+
+    return true;
+}
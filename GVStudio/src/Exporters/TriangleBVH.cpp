@@ -0,0 +1,245 @@
+#include "Exporters/TriangleBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+    constexpr uint32_t kLeafSize = 4;
+    constexpr float kEpsilon = 1e-5f;
+
+    Vec3 Min(const Vec3& a, const Vec3& b)
+    {
+        return Vec3(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z));
+    }
+
+    Vec3 Max(const Vec3& a, const Vec3& b)
+    {
+        return Vec3(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z));
+    }
+
+    float Axis(const Vec3& v, int axis)
+    {
+        return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+    }
+
+    bool HitBox(const Vec3& origin, const Vec3& invDir, float maxT,
+        const Vec3& boxMin, const Vec3& boxMax)
+    {
+        float tMin = 0.0f;
+        float tMax = maxT;
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float o = Axis(origin, axis);
+            float inv = Axis(invDir, axis);
+
+            float t0 = (Axis(boxMin, axis) - o) * inv;
+            float t1 = (Axis(boxMax, axis) - o) * inv;
+            if (t0 > t1)
+                std::swap(t0, t1);
+
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Moller-Trumbore, both faces.
+    bool HitTriangle(const Vec3& origin, const Vec3& dir, const BvhTriangle& tri, float& outT)
+    {
+        Vec3 e1 = tri.v1 - tri.v0;
+        Vec3 e2 = tri.v2 - tri.v0;
+        Vec3 p = Cross(dir, e2);
+
+        float det = Dot(e1, p);
+        if (std::fabs(det) < 1e-12f)
+            return false;
+
+        float invDet = 1.0f / det;
+        Vec3 s = origin - tri.v0;
+
+        float u = Dot(s, p) * invDet;
+        if (u < 0.0f || u > 1.0f)
+            return false;
+
+        Vec3 q = Cross(s, e1);
+        float v = Dot(dir, q) * invDet;
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+
+        outT = Dot(e2, q) * invDet;
+        return true;
+    }
+}
+
+void TriangleBVH::Build(std::vector<BvhTriangle> triangles)
+{
+    m_triangles.clear();
+    m_nodes.clear();
+    m_sourceIndex.clear();
+
+    if (triangles.empty())
+        return;
+
+    std::vector<uint32_t> order(triangles.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    m_nodes.reserve(triangles.size() * 2 / kLeafSize + 1);
+    m_triangles = std::move(triangles);
+
+    BuildNode(order, 0, static_cast<uint32_t>(order.size()));
+
+    // Store triangles in leaf order so leaves are contiguous.
+    std::vector<BvhTriangle> sorted(m_triangles.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        sorted[i] = m_triangles[order[i]];
+    m_triangles.swap(sorted);
+    m_sourceIndex.swap(order);
+}
+
+uint32_t TriangleBVH::BuildNode(std::vector<uint32_t>& order, uint32_t first, uint32_t count)
+{
+    uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    Vec3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+    Vec3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    Vec3 centroidMin = boundsMin;
+    Vec3 centroidMax = boundsMax;
+
+    for (uint32_t i = first; i < first + count; ++i)
+    {
+        const BvhTriangle& tri = m_triangles[order[i]];
+        boundsMin = Min(boundsMin, Min(tri.v0, Min(tri.v1, tri.v2)));
+        boundsMax = Max(boundsMax, Max(tri.v0, Max(tri.v1, tri.v2)));
+
+        Vec3 c = (tri.v0 + tri.v1 + tri.v2) * (1.0f / 3.0f);
+        centroidMin = Min(centroidMin, c);
+        centroidMax = Max(centroidMax, c);
+    }
+
+    m_nodes[index].boundsMin = boundsMin;
+    m_nodes[index].boundsMax = boundsMax;
+
+    Vec3 extent = centroidMax - centroidMin;
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > Axis(extent, axis)) axis = 2;
+
+    if (count <= kLeafSize || Axis(extent, axis) <= 0.0f)
+    {
+        m_nodes[index].first = first;
+        m_nodes[index].count = count;
+        return index;
+    }
+
+    // Median split on the widest centroid axis.
+    uint32_t half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+        [&](uint32_t a, uint32_t b)
+        {
+            const BvhTriangle& ta = m_triangles[a];
+            const BvhTriangle& tb = m_triangles[b];
+            return Axis(ta.v0 + ta.v1 + ta.v2, axis) < Axis(tb.v0 + tb.v1 + tb.v2, axis);
+        });
+
+    BuildNode(order, first, half);
+    uint32_t right = BuildNode(order, first + half, count - half);
+
+    m_nodes[index].first = right;
+    m_nodes[index].count = 0;
+    return index;
+}
+
+template <typename Visit>
+void TriangleBVH::Traverse(const Vec3& origin, const Vec3& dir, float maxT, Visit&& visit) const
+{
+    if (m_nodes.empty())
+        return;
+
+    Vec3 invDir(
+        1.0f / (dir.x != 0.0f ? dir.x : 1e-20f),
+        1.0f / (dir.y != 0.0f ? dir.y : 1e-20f),
+        1.0f / (dir.z != 0.0f ? dir.z : 1e-20f));
+
+    float limit = maxT;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+
+        if (!HitBox(origin, invDir, limit, node.boundsMin, node.boundsMax))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i)
+                if (!visit(i, limit))
+                    return;
+            continue;
+        }
+
+        // Left child always follows its parent.
+        stack[top++] = node.first;
+        stack[top++] = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+    }
+}
+
+bool TriangleBVH::Occluded(const Vec3& from, const Vec3& to) const
+{
+    Vec3 dir = to - from;
+    bool hit = false;
+
+    Traverse(from, dir, 1.0f, [&](uint32_t i, float&)
+        {
+            float t = 0.0f;
+            if (HitTriangle(from, dir, m_triangles[i], t) && t > kEpsilon && t < 1.0f - kEpsilon)
+            {
+                hit = true;
+                return false;
+            }
+            return true;
+        });
+
+    return hit;
+}
+
+bool TriangleBVH::Intersect(const Vec3& origin, const Vec3& dir, float maxT,
+    float& outT, uint32_t& outTriangle) const
+{
+    bool hit = false;
+
+    Traverse(origin, dir, maxT, [&](uint32_t i, float& limit)
+        {
+            float t = 0.0f;
+            if (HitTriangle(origin, dir, m_triangles[i], t) && t > kEpsilon && t < limit)
+            {
+                limit = t;
+                outT = t;
+                outTriangle = m_sourceIndex[i];
+                hit = true;
+            }
+            return true;
+        });
+
+    return hit;
+}
+
+size_t TriangleBVH::GetTriangleCount() const
+{
+    return m_triangles.size();
+}
+
+size_t TriangleBVH::GetNodeCount() const
+{
+    return m_nodes.size();
+}
@@ -0,0 +1,73 @@
+#include "Exporters/WorldSectors.h"
+
+#include <algorithm>
+#include <cmath>
+
+WorldSectors::WorldSectors(float sectorSize)
+    : m_sectorSize(sectorSize > 0.0f ? sectorSize : 1.0f)
+{
+}
+
+void WorldSectors::Add(const WorldDrawItem& item)
+{
+    float cx = (item.boundsMin.x + item.boundsMax.x) * 0.5f;
+    float cz = (item.boundsMin.z + item.boundsMax.z) * 0.5f;
+
+    int cellX = static_cast<int>(std::floor(cx / m_sectorSize));
+    int cellZ = static_cast<int>(std::floor(cz / m_sectorSize));
+
+    auto key = std::make_pair(cellZ, cellX);
+    auto it = m_cells.find(key);
+
+    if (it == m_cells.end())
+    {
+        WorldSector sector;
+        sector.cellX = cellX;
+        sector.cellZ = cellZ;
+        sector.boundsMin = item.boundsMin;
+        sector.boundsMax = item.boundsMax;
+
+        it = m_cells.emplace(key, m_sectors.size()).first;
+        m_sectors.push_back(sector);
+        m_sorted = false;
+    }
+
+    WorldSector& sector = m_sectors[it->second];
+
+    sector.boundsMin.x = std::min(sector.boundsMin.x, item.boundsMin.x);
+    sector.boundsMin.y = std::min(sector.boundsMin.y, item.boundsMin.y);
+    sector.boundsMin.z = std::min(sector.boundsMin.z, item.boundsMin.z);
+    sector.boundsMax.x = std::max(sector.boundsMax.x, item.boundsMax.x);
+    sector.boundsMax.y = std::max(sector.boundsMax.y, item.boundsMax.y);
+    sector.boundsMax.z = std::max(sector.boundsMax.z, item.boundsMax.z);
+
+    sector.items.push_back(item);
+}
+
+std::vector<WorldSector>& WorldSectors::GetSectors()
+{
+    if (!m_sorted)
+    {
+        std::vector<WorldSector> ordered;
+        ordered.reserve(m_sectors.size());
+
+        for (auto& cell : m_cells)
+        {
+            ordered.push_back(std::move(m_sectors[cell.second]));
+            cell.second = ordered.size() - 1;
+        }
+
+        m_sectors.swap(ordered);
+        m_sorted = true;
+    }
+
+    return m_sectors;
+}
+
+size_t WorldSectors::GetItemCount() const
+{
+    size_t count = 0;
+    for (const WorldSector& sector : m_sectors)
+        count += sector.items.size();
+    return count;
+}
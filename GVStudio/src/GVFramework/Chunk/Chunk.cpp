@@ -0,0 +1,84 @@
+#include "GVFramework/Chunk/Chunk.h"
+
+#include <cstring>
+
+void WriteChunk(std::ofstream& out, uint32_t type, uint32_t version, const std::vector<char>& data)
+{
+    std::vector<char> chunk;
+    AppendChunk(chunk, type, version, data);
+
+    out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+}
+
+void AppendChunk(std::vector<char>& dest, uint32_t type, uint32_t version, const std::vector<char>& payload)
+{
+    AppendU32(dest, type);
+    AppendU32(dest, static_cast<uint32_t>(payload.size()));
+    AppendU32(dest, version);
+
+    dest.insert(dest.end(), payload.begin(), payload.end());
+}
+
+void AppendU32(std::vector<char>& dest, uint32_t value)
+{
+    dest.push_back(static_cast<char>(value & 0xFF));
+    dest.push_back(static_cast<char>((value >> 8) & 0xFF));
+    dest.push_back(static_cast<char>((value >> 16) & 0xFF));
+    dest.push_back(static_cast<char>((value >> 24) & 0xFF));
+}
+
+void AppendF32(std::vector<char>& dest, float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    AppendU32(dest, bits);
+}
+
+void AppendString(std::vector<char>& dest, const std::string& value)
+{
+    AppendU32(dest, static_cast<uint32_t>(value.size()));
+    dest.insert(dest.end(), value.begin(), value.end());
+
+    const size_t padding = (4 - value.size() % 4) % 4;
+    dest.insert(dest.end(), padding, 0);
+}
+
+uint32_t ReadU32(const std::vector<char>& src, size_t& offset)
+{
+    if (offset + 4 > src.size())
+    {
+        offset = src.size();
+        return 0;
+    }
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(src.data() + offset);
+    offset += 4;
+
+    return static_cast<uint32_t>(p[0]) |
+        (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) |
+        (static_cast<uint32_t>(p[3]) << 24);
+}
+
+float ReadF32(const std::vector<char>& src, size_t& offset)
+{
+    uint32_t bits = ReadU32(src, offset);
+
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string ReadString(const std::vector<char>& src, size_t& offset)
+{
+    uint32_t length = ReadU32(src, offset);
+    if (offset + length > src.size())
+    {
+        offset = src.size();
+        return {};
+    }
+
+    std::string value(src.data() + offset, length);
+    offset += length + (4 - length % 4) % 4;
+    return value;
+}
@@ -0,0 +1,291 @@
+#include "GVFramework/Chunk/ChunkHash.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define GV_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace
+{
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    uint64_t Rotl(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // Little-endian loads; memcpy keeps unaligned reads legal.
+    uint64_t Read64(const unsigned char* p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t Read32(const unsigned char* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint64_t Round(uint64_t acc, uint64_t input)
+    {
+        acc += input * kPrime2;
+        acc = Rotl(acc, 31);
+        return acc * kPrime1;
+    }
+
+    uint64_t MergeRound(uint64_t acc, uint64_t value)
+    {
+        acc ^= Round(0, value);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    uint64_t Converge(const uint64_t v[4])
+    {
+        uint64_t h = Rotl(v[0], 1) + Rotl(v[1], 7) + Rotl(v[2], 12) + Rotl(v[3], 18);
+        for (int i = 0; i < 4; ++i)
+            h = MergeRound(h, v[i]);
+        return h;
+    }
+
+    // Consumes the last < 32 bytes and avalanches.
+    uint64_t Finish(uint64_t h, const unsigned char* p, const unsigned char* end)
+    {
+        while (p + 8 <= end)
+        {
+            h ^= Round(0, Read64(p));
+            h = Rotl(h, 27) * kPrime1 + kPrime4;
+            p += 8;
+        }
+
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+            h = Rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+
+        while (p < end)
+        {
+            h ^= (*p) * kPrime5;
+            h = Rotl(h, 11) * kPrime1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+}
+
+uint64_t XXHash64(const void* data, size_t size, uint64_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t h;
+
+    if (size >= 32)
+    {
+        uint64_t v1 = seed + kPrime1 + kPrime2;
+        uint64_t v2 = seed + kPrime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kPrime1;
+
+        const unsigned char* limit = end - 32;
+        do
+        {
+            v1 = Round(v1, Read64(p)); p += 8;
+            v2 = Round(v2, Read64(p)); p += 8;
+            v3 = Round(v3, Read64(p)); p += 8;
+            v4 = Round(v4, Read64(p)); p += 8;
+        } while (p <= limit);
+
+        const uint64_t v[4] = { v1, v2, v3, v4 };
+        h = Converge(v);
+    }
+    else
+    {
+        h = seed + kPrime5;
+    }
+
+    return Finish(h + static_cast<uint64_t>(size), p, end);
+}
+
+XXHash64Stream::XXHash64Stream(uint64_t seed)
+    : m_seed(seed)
+{
+    m_v[0] = seed + kPrime1 + kPrime2;
+    m_v[1] = seed + kPrime2;
+    m_v[2] = seed;
+    m_v[3] = seed - kPrime1;
+}
+
+void XXHash64Stream::Update(const void* data, size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    m_total += size;
+
+    if (m_buffered + size < 32)
+    {
+        std::memcpy(m_buffer + m_buffered, p, size);
+        m_buffered += size;
+        return;
+    }
+
+    if (m_buffered > 0)
+    {
+        size_t fill = 32 - m_buffered;
+        std::memcpy(m_buffer + m_buffered, p, fill);
+        p += fill;
+
+        for (int i = 0; i < 4; ++i)
+            m_v[i] = Round(m_v[i], Read64(m_buffer + i * 8));
+        m_buffered = 0;
+    }
+
+    while (p + 32 <= end)
+    {
+        for (int i = 0; i < 4; ++i)
+            m_v[i] = Round(m_v[i], Read64(p + i * 8));
+        p += 32;
+    }
+
+    m_buffered = static_cast<size_t>(end - p);
+    std::memcpy(m_buffer, p, m_buffered);
+}
+
+uint64_t XXHash64Stream::Digest() const
+{
+    uint64_t h = m_total >= 32 ? Converge(m_v) : m_seed + kPrime5;
+    return Finish(h + m_total, m_buffer, m_buffer + m_buffered);
+}
+
+namespace
+{
+    struct Crc32CTables
+    {
+        uint32_t t[8][256];
+
+        Crc32CTables()
+        {
+            const uint32_t poly = 0x82F63B78; // reflected Castagnoli
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+                t[0][i] = c;
+            }
+
+            for (uint32_t i = 0; i < 256; ++i)
+                for (int k = 1; k < 8; ++k)
+                    t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+        }
+    };
+
+    const Crc32CTables& GetCrcTables()
+    {
+        static const Crc32CTables tables;
+        return tables;
+    }
+
+#ifdef GV_CRC32C_SSE42
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("sse4.2")))
+#endif
+    uint32_t Crc32CHardware(const unsigned char* p, size_t size, uint32_t crc)
+    {
+        uint64_t c = ~crc;
+
+        while (size > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0)
+        {
+            c = _mm_crc32_u8(static_cast<uint32_t>(c), *p++);
+            --size;
+        }
+
+        while (size >= 8)
+        {
+            c = _mm_crc32_u64(c, Read64(p));
+            p += 8;
+            size -= 8;
+        }
+
+        while (size > 0)
+        {
+            c = _mm_crc32_u8(static_cast<uint32_t>(c), *p++);
+            --size;
+        }
+
+        return ~static_cast<uint32_t>(c);
+    }
+#endif
+}
+
+uint32_t Crc32CSlice8(const void* data, size_t size, uint32_t crc)
+{
+    const auto& t = GetCrcTables().t;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint32_t c = ~crc;
+
+    while (size >= 8)
+    {
+        uint32_t lo = Read32(p) ^ c;
+        uint32_t hi = Read32(p + 4);
+
+        c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+            t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+
+        p += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        c = (c >> 8) ^ t[0][(c ^ *p++) & 0xFF];
+        --size;
+    }
+
+    return ~c;
+}
+
+bool HasHardwareCrc32C()
+{
+#if defined(GV_CRC32C_SSE42) && defined(_MSC_VER)
+    static const bool supported = []
+        {
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 20)) != 0;
+        }();
+    return supported;
+#elif defined(GV_CRC32C_SSE42)
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint32_t Crc32C(const void* data, size_t size, uint32_t crc)
+{
+#ifdef GV_CRC32C_SSE42
+    if (HasHardwareCrc32C())
+        return Crc32CHardware(static_cast<const unsigned char*>(data), size, crc);
+#endif
+    return Crc32CSlice8(data, size, crc);
+}
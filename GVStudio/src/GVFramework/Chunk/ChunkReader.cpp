@@ -0,0 +1,181 @@
+#include "GVFramework/Chunk/ChunkReader.h"
+#include "GVFramework/Chunk/Chunk.h"
+#include "GVFramework/Chunk/ChunkChecksum.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    uint32_t LoadU32(const char* p)
+    {
+        const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+        return static_cast<uint32_t>(b[0]) |
+            (static_cast<uint32_t>(b[1]) << 8) |
+            (static_cast<uint32_t>(b[2]) << 16) |
+            (static_cast<uint32_t>(b[3]) << 24);
+    }
+}
+
+ChunkReader::ChunkReader(const char* data, size_t size, size_t begin, size_t end)
+    : m_data(data),
+    m_size(size),
+    m_pos(begin),
+    m_end(std::min(end, size))
+{
+}
+
+ChunkReader::ChunkReader(const std::vector<char>& data)
+    : ChunkReader(data.data(), data.size())
+{
+}
+
+bool ChunkReader::Next(GV_ChunkView& out)
+{
+    if (!m_valid || m_pos >= m_end)
+        return false;
+
+    if (m_end - m_pos < 12)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    out.start = m_pos;
+    out.type = LoadU32(m_data + m_pos);
+    out.size = LoadU32(m_data + m_pos + 4);
+    out.version = LoadU32(m_data + m_pos + 8);
+    out.payload = m_pos + 12;
+
+    if (out.size > m_end - out.payload)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    if (m_checksums && !Verify(out))
+    {
+        m_valid = false;
+        return false;
+    }
+
+    m_pos = out.GetEnd();
+    return true;
+}
+
+bool ChunkReader::IsValid() const
+{
+    return m_valid;
+}
+
+ChunkReader ChunkReader::Children(const GV_ChunkView& chunk, size_t skip) const
+{
+    ChunkReader reader(m_data, m_size, chunk.payload + skip, chunk.GetEnd());
+    reader.m_checksums = m_checksums;
+    return reader;
+}
+
+const char* ChunkReader::GetData() const
+{
+    return m_data;
+}
+
+bool ChunkReader::EnableChecksums()
+{
+    ChunkReader top(m_data, m_size);
+    GV_ChunkView chunk;
+    GV_ChunkView table;
+    bool found = false;
+
+    while (top.Next(chunk))
+    {
+        if (chunk.type == GV_CHUNK_CHECKSUMS)
+        {
+            table = chunk;
+            found = true;
+        }
+    }
+
+    if (!found || table.size < 8 || LoadU32(m_data + table.payload) != ChunkChecksum::ALGORITHM_CRC32C)
+        return false;
+
+    uint32_t count = LoadU32(m_data + table.payload + 4);
+    if (count > (table.size - 8) / 12)
+        return false;
+
+    auto state = std::make_shared<ChecksumState>();
+    state->offsets.resize(count);
+    state->sizes.resize(count);
+    state->crcs.resize(count);
+    state->status.assign(count, 0);
+
+    const char* p = m_data + table.payload + 8;
+    for (uint32_t i = 0; i < count; ++i, p += 12)
+    {
+        state->offsets[i] = LoadU32(p);
+        state->sizes[i] = LoadU32(p + 4);
+        state->crcs[i] = LoadU32(p + 8);
+    }
+
+    if (!std::is_sorted(state->offsets.begin(), state->offsets.end()))
+        return false;
+
+    m_checksums = std::move(state);
+    return true;
+}
+
+bool ChunkReader::IsCorrupt() const
+{
+    return m_checksums && m_checksums->corrupt;
+}
+
+uint32_t ChunkReader::GetVerifiedCount() const
+{
+    return m_checksums ? m_checksums->verified : 0;
+}
+
+bool ChunkReader::Verify(const GV_ChunkView& chunk)
+{
+    ChecksumState& state = *m_checksums;
+
+    // The covering entry is the last one starting at or before the chunk.
+    auto it = std::upper_bound(state.offsets.begin(), state.offsets.end(), chunk.start);
+    if (it == state.offsets.begin())
+        return true;
+
+    size_t i = static_cast<size_t>(it - state.offsets.begin()) - 1;
+    if (chunk.start >= static_cast<size_t>(state.offsets[i]) + state.sizes[i])
+        return true; // not covered, e.g. the table itself
+
+    if (state.status[i] == 0)
+    {
+        bool inside = static_cast<size_t>(state.offsets[i]) + state.sizes[i] <= m_size;
+        bool good = inside && Crc32C(m_data + state.offsets[i], state.sizes[i]) == state.crcs[i];
+
+        state.status[i] = good ? 1 : 2;
+        ++state.verified;
+
+        if (!good)
+        {
+            state.corrupt = true;
+            std::cout << "[ChunkReader] Checksum mismatch in chunk at offset " << state.offsets[i] << "\n";
+        }
+    }
+
+    return state.status[i] == 1;
+}
+
+bool ChunkReader::ReadFile(const std::string& path, std::vector<char>& out)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    out.resize(static_cast<size_t>(size));
+    return size == 0 || static_cast<bool>(file.read(out.data(), size));
+}
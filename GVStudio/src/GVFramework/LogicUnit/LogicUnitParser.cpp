@@ -18,6 +18,9 @@ static GV_ChunkType ParseChunkType(const std::string& s)
     if (s == "GV_CHUNK_STATIC_MESH")
         return GV_ChunkType::GV_CHUNK_STATIC_MESH;
 
+    if (s == "GV_CHUNK_LIGHT")
+        return GV_ChunkType::GV_CHUNK_LIGHT;
+
     return GV_ChunkType::GV_CHUNK_UNKNOWN;
 }
 
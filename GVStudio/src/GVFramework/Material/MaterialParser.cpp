@@ -0,0 +1,64 @@
+#include "GVFramework/Material/MaterialParser.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+std::vector<GV_Material> MaterialParser::ParseFile(const std::string& filename)
+{
+    std::vector<GV_Material> materials;
+
+    std::ifstream file(filename);
+    if (!file.is_open())
+        return materials;
+
+    GV_Material* current = nullptr;
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        std::stringstream ss(line);
+        std::string type;
+        ss >> type;
+
+        if (type == "newmtl")
+        {
+            materials.emplace_back();
+            current = &materials.back();
+            ss >> current->name;
+            continue;
+        }
+
+        if (!current)
+            continue;
+
+        if (type == "Kd")
+        {
+            ss >> current->diffuse[0] >> current->diffuse[1] >> current->diffuse[2];
+        }
+        else if (type == "d")
+        {
+            ss >> current->alpha;
+        }
+        else if (type == "Tr")
+        {
+            float tr = 0.0f;
+            ss >> tr;
+            current->alpha = 1.0f - tr;
+        }
+        else if (type == "illum")
+        {
+            ss >> current->illum;
+        }
+        else if (type == "map_Kd")
+        {
+            std::string tex;
+            ss >> tex;
+            current->texturePath = (fs::path(filename).parent_path() / tex).string();
+        }
+    }
+
+    return materials;
+}
@@ -0,0 +1,393 @@
+#include "GVFramework/Scene/ObjectPack.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    template <typename T>
+    void Put(std::vector<char>& out, const T& value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    bool Get(const char* data, size_t size, size_t& pos, T& out)
+    {
+        if (size - pos < sizeof(T))
+            return false;
+        std::memcpy(&out, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+}
+
+bool ObjectPack::Open(const std::string& path)
+{
+    Close();
+    m_path = path;
+
+    std::error_code ec;
+    if (!fs::exists(path, ec))
+        return true;
+
+    if (!m_file.Open(path) || !ReadIndex())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ObjectPack::Close()
+{
+    m_file.Close();
+    m_path.clear();
+    m_entries.clear();
+    m_pending.clear();
+    m_end = 0;
+    m_indexBytes = 0;
+    m_liveBytes = 0;
+    m_deadBytes = 0;
+    m_appended = 0;
+    m_dirty = false;
+}
+
+bool ObjectPack::ReadIndex()
+{
+    const char* data = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    Header header;
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != MAGIC || header.version != VERSION)
+        return false;
+    if (header.indexOffset < sizeof(header) || header.indexOffset > size ||
+        header.indexBytes > size - header.indexOffset)
+        return false;
+
+    const char* index = data + header.indexOffset;
+    const size_t indexBytes = static_cast<size_t>(header.indexBytes);
+    if (XXHash64(index, indexBytes) != header.indexHash)
+        return false;
+
+    size_t pos = 0;
+    uint32_t count = 0;
+    if (!Get(index, indexBytes, pos, count))
+        return false;
+
+    m_entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Entry entry;
+        uint32_t nameLength = 0;
+        if (!Get(index, indexBytes, pos, entry.offset) ||
+            !Get(index, indexBytes, pos, entry.size) ||
+            !Get(index, indexBytes, pos, entry.hash) ||
+            !Get(index, indexBytes, pos, nameLength) ||
+            indexBytes - pos < nameLength)
+            return false;
+
+        if (entry.offset < sizeof(header) || entry.offset > header.indexOffset ||
+            entry.size > header.indexOffset - entry.offset)
+            return false;
+
+        m_entries[std::string(index + pos, nameLength)] = entry;
+        m_liveBytes += entry.size;
+        pos += nameLength;
+    }
+
+    // Bytes after the index are a save that never reached the header.
+    m_end = size;
+    m_indexBytes = header.indexBytes;
+    m_deadBytes = header.deadBytes + (size - header.indexOffset - header.indexBytes);
+    return true;
+}
+
+std::string_view ObjectPack::GetRecord(const Entry& entry) const
+{
+    if (entry.pending >= 0)
+        return m_pending[entry.pending];
+    return std::string_view(m_file.GetData() + entry.offset, entry.size);
+}
+
+std::string_view ObjectPack::Find(const std::string& name) const
+{
+    auto it = m_entries.find(name);
+    return it == m_entries.end() ? std::string_view() : GetRecord(it->second);
+}
+
+void ObjectPack::Write(const std::string& name, std::string_view record)
+{
+    const uint64_t hash = XXHash64(record.data(), record.size());
+
+    auto it = m_entries.find(name);
+    if (it == m_entries.end())
+        it = m_entries.emplace(name, Entry()).first;
+    else if (it->second.hash == hash && GetRecord(it->second) == record)
+        return;
+
+    Entry& entry = it->second;
+    m_liveBytes += record.size();
+    m_liveBytes -= entry.size;
+
+    if (entry.pending >= 0)
+    {
+        m_pending[entry.pending].assign(record);
+    }
+    else
+    {
+        m_deadBytes += entry.size;
+        entry.pending = static_cast<int32_t>(m_pending.size());
+        m_pending.emplace_back(record);
+    }
+
+    entry.size = static_cast<uint32_t>(record.size());
+    entry.hash = hash;
+    m_dirty = true;
+}
+
+void ObjectPack::Remove(const std::string& name)
+{
+    auto it = m_entries.find(name);
+    if (it == m_entries.end())
+        return;
+
+    const Entry& entry = it->second;
+    m_liveBytes -= entry.size;
+
+    // A queued record is dropped from the queue, a stored one goes dead.
+    if (entry.pending >= 0)
+        m_pending[entry.pending].clear();
+    else
+        m_deadBytes += entry.size;
+
+    m_entries.erase(it);
+    m_dirty = true;
+}
+
+std::vector<std::string> ObjectPack::GetNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_entries.size());
+    for (const auto& [name, entry] : m_entries)
+        names.push_back(name);
+    return names;
+}
+
+void ObjectPack::BuildIndex(const std::unordered_map<std::string, Entry>& entries, std::vector<char>& out)
+{
+    out.clear();
+    Put(out, static_cast<uint32_t>(entries.size()));
+
+    for (const auto& [name, entry] : entries)
+    {
+        Put(out, entry.offset);
+        Put(out, entry.size);
+        Put(out, entry.hash);
+        Put(out, static_cast<uint32_t>(name.size()));
+        out.insert(out.end(), name.begin(), name.end());
+    }
+}
+
+bool ObjectPack::Commit()
+{
+    m_appended = 0;
+    if (!m_dirty)
+        return true;
+
+    // The current index goes dead as soon as a new one is appended.
+    const uint64_t dead = m_deadBytes + m_indexBytes;
+    if (dead > m_liveBytes && dead >= COMPACT_MIN_BYTES)
+        return Compact();
+
+    const bool create = m_end == 0;
+    const std::string path = m_path;
+
+    uint64_t pos = create ? sizeof(Header) : m_end;
+    const uint64_t recordStart = pos;
+    std::vector<uint64_t> offsets(m_pending.size());
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        offsets[i] = pos;
+        pos += m_pending[i].size();
+    }
+
+    uint32_t appended = 0;
+    for (auto& [name, entry] : m_entries)
+    {
+        if (entry.pending < 0)
+            continue;
+        entry.offset = offsets[entry.pending];
+        entry.pending = -1;
+        ++appended;
+    }
+
+    std::vector<char> index;
+    BuildIndex(m_entries, index);
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.indexOffset = pos;
+    header.indexBytes = index.size();
+    header.indexHash = XXHash64(index.data(), index.size());
+    header.deadBytes = create ? 0 : dead;
+
+    // Windows will not truncate or replace a mapped file, and the mapping
+    // would not cover the appended bytes, so it is dropped and remade
+    // around the write.
+    m_file.Close();
+
+    bool ok = false;
+    {
+        std::fstream out;
+        if (create)
+            out.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+        else
+            out.open(path, std::ios::binary | std::ios::in | std::ios::out);
+
+        if (out.is_open())
+        {
+            // A pack created by a save that never finishes keeps a zero
+            // header, which Open() rejects.
+            if (create)
+            {
+                const Header empty = {};
+                out.write(reinterpret_cast<const char*>(&empty), sizeof(empty));
+            }
+
+            out.seekp(static_cast<std::streamoff>(recordStart));
+            for (const std::string& record : m_pending)
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+            out.write(index.data(), static_cast<std::streamsize>(index.size()));
+            out.flush();
+
+            // Only now does the pack point at the new records.
+            out.seekp(0);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.flush();
+            ok = static_cast<bool>(out);
+        }
+    }
+
+    // Back to what the file says, the queued records are lost.
+    if (!ok)
+    {
+        Open(path);
+        return false;
+    }
+
+    m_pending.clear();
+    m_end = header.indexOffset + header.indexBytes;
+    m_indexBytes = header.indexBytes;
+    m_deadBytes = header.deadBytes;
+    m_appended = appended;
+    m_dirty = false;
+    return m_file.Open(path);
+}
+
+bool ObjectPack::Compact()
+{
+    const std::string path = m_path;
+    const std::string tempPath = path + ".tmp";
+
+    std::unordered_map<std::string, Entry> entries;
+    entries.reserve(m_entries.size());
+
+    std::vector<char> index;
+    Header header;
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+
+        const Header empty = {};
+        out.write(reinterpret_cast<const char*>(&empty), sizeof(empty));
+
+        uint64_t pos = sizeof(Header);
+        for (const auto& [name, entry] : m_entries)
+        {
+            std::string_view record = GetRecord(entry);
+            out.write(record.data(), static_cast<std::streamsize>(record.size()));
+
+            Entry& moved = entries[name];
+            moved.offset = pos;
+            moved.size = entry.size;
+            moved.hash = entry.hash;
+            pos += entry.size;
+        }
+
+        BuildIndex(entries, index);
+        out.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.indexOffset = pos;
+        header.indexBytes = index.size();
+        header.indexHash = XXHash64(index.data(), index.size());
+        header.deadBytes = 0;
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.flush();
+
+        if (!out)
+        {
+            out.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // The records were read from the mapping, which has to go before the
+    // rename can replace the file.
+    m_file.Close();
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec)
+    {
+        fs::remove(tempPath, ec);
+        Open(path);
+        return false;
+    }
+
+    m_appended = static_cast<uint32_t>(entries.size());
+    m_entries.swap(entries);
+    m_pending.clear();
+    m_end = header.indexOffset + header.indexBytes;
+    m_indexBytes = header.indexBytes;
+    m_deadBytes = 0;
+    m_dirty = false;
+    return m_file.Open(path);
+}
+
+size_t ObjectPack::GetCount() const
+{
+    return m_entries.size();
+}
+
+uint64_t ObjectPack::GetLiveBytes() const
+{
+    return m_liveBytes;
+}
+
+uint64_t ObjectPack::GetDeadBytes() const
+{
+    return m_deadBytes;
+}
+
+uint32_t ObjectPack::GetAppendedCount() const
+{
+    return m_appended;
+}
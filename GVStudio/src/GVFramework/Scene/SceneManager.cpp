@@ -1,12 +1,63 @@
 #include "MiniXml/SceneXml.h"
 #include "MiniXml/ObjectXml.h"
+#include "MiniXml/XmlCache.h"
 #include "GVFramework/Scene/SceneManager.h"
+#include "GVFramework/Scene/ObjectPack.h"
+#include "GVFramework/Chunk/ChunkHash.h"
 #include "GVStudio/GVStudio.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <iostream>
 
 namespace fs = std::filesystem;
 
+namespace
+{
+    // Names and parameter values of every object, in folder order.
+    void HashObjects(const SceneFolder& folder, XXHash64Stream& hash)
+    {
+        for (const auto& objPtr : folder.objects)
+        {
+            const SceneObject& obj = *objPtr;
+            hash.Update(obj.name.data(), obj.name.size());
+
+            if (!obj.def)
+                continue;
+
+            for (const LU_Param_Val& val : obj.def->values)
+            {
+                hash.Update(&val.fval, sizeof(val.fval));
+                hash.Update(&val.ival, sizeof(val.ival));
+                hash.Update(&val.bval, sizeof(val.bval));
+                hash.Update(val.sval.data(), val.sval.size());
+            }
+        }
+
+        for (const auto& child : folder.children)
+            HashObjects(*child, hash);
+    }
+
+    uint64_t HashObjects(const SceneFolder& folder)
+    {
+        XXHash64Stream hash;
+        HashObjects(folder, hash);
+        return hash.Digest();
+    }
+
+    uint64_t GetFolderBytes(const fs::path& dir)
+    {
+        uint64_t bytes = 0;
+        std::error_code ec;
+        for (const fs::directory_entry& entry : fs::directory_iterator(dir, ec))
+            if (entry.is_regular_file(ec))
+                bytes += entry.file_size(ec);
+        return bytes;
+    }
+}
+
 SceneManager::SceneManager(LogicUnitRegistry& registry)
     : m_registry(registry)
 {
@@ -31,6 +82,11 @@ std::string SceneManager::GetCurrentSceneDirectory(const GV_State& state) const
     return scenePath.parent_path().string();
 }
 
+LogicUnitRegistry& SceneManager::GetRegistry() const
+{
+    return m_registry;
+}
+
 bool SceneManager::LoadScene(const std::string& sceneDir)
 {
     m_root = SceneFolder{}; // reset root
@@ -43,18 +99,41 @@ bool SceneManager::LoadScene(const std::string& sceneDir)
 
     fs::path objectsDir = fs::path(sceneDir) / "Objects";
 
-    LoadAllObjects(m_root, objectsDir.string());
+    // Objects the pack does not have still come from Objects/.
+    const std::string packPath = GetObjectPackPath(sceneDir);
+    std::error_code ec;
+    ObjectPack pack;
+    bool packed = false;
+
+    if (fs::exists(packPath, ec))
+    {
+        packed = pack.Open(packPath);
+        if (!packed)
+            std::cout << "[SceneManager] Damaged object pack, reading Objects/: " << packPath << "\n";
+    }
+
+    LoadAllObjects(m_root, objectsDir.string(), packed ? &pack : nullptr);
 
     return true;
 }
 
 void SceneManager::LoadAllObjects(SceneFolder& folder,
-    const std::string& objectsDir)
+    const std::string& objectsDir, const ObjectPack* pack)
 {
     for (auto& objPtr : folder.objects)
     {
         SceneObject& obj = *objPtr;
 
+        std::string_view record = pack ? pack->Find(obj.name) : std::string_view();
+        if (!record.empty())
+        {
+            ObjectXml::LoadObjectFromText(obj, record, m_registry);
+            continue;
+        }
+
+        if (pack)
+            std::cout << "[SceneManager] Object missing from pack, reading Objects/: " << obj.name << "\n";
+
         fs::path xmlPath = fs::path(objectsDir) /
             (obj.name + ".gObject");
 
@@ -63,18 +142,63 @@ void SceneManager::LoadAllObjects(SceneFolder& folder,
 
     for (auto& child : folder.children)
     {
-        LoadAllObjects(*child, objectsDir);
+        LoadAllObjects(*child, objectsDir, pack);
     }
 }
 
 bool SceneManager::SaveScene(const std::string& sceneDir) const
 {
-    fs::path objectsDir = fs::path(sceneDir) / "Objects";
+    const std::string packPath = GetObjectPackPath(sceneDir);
+    std::error_code ec;
+
+    if (m_storage == ObjectStorage::Packed)
+    {
+        ObjectPack pack;
+        if (!pack.Open(packPath))
+        {
+            // Every object is in memory, so a damaged pack is started over.
+            std::cout << "[SceneManager] Rebuilding damaged object pack: " << packPath << "\n";
+            fs::remove(packPath, ec);
+
+            if (!pack.Open(packPath))
+            {
+                std::cout << "[SceneManager] Cannot create object pack: " << packPath << "\n";
+                return false;
+            }
+        }
+
+        std::unordered_set<std::string> names;
+        std::string record;
+        PackAllObjects(m_root, pack, names, record);
+
+        for (const std::string& name : pack.GetNames())
+            if (names.find(name) == names.end())
+                pack.Remove(name);
+
+        // The .gScene is left alone too, so it never lists objects the
+        // pack does not have.
+        if (!pack.Commit())
+        {
+            std::cout << "[SceneManager] Failed to write object pack: " << packPath << "\n";
+            return false;
+        }
+
+        // The pack now holds every object; files left in Objects/ would
+        // only be read back if the pack is lost, and then they are stale.
+        RemoveObjectFiles((fs::path(sceneDir) / "Objects").string(), names);
+    }
+    else
+    {
+        fs::path objectsDir = fs::path(sceneDir) / "Objects";
+
+        if (!fs::exists(objectsDir))
+            fs::create_directory(objectsDir);
 
-    if (!fs::exists(objectsDir))
-        fs::create_directory(objectsDir);
+        SaveAllObjects(m_root, objectsDir.string());
 
-    SaveAllObjects(m_root, objectsDir.string());
+        // Loading prefers a pack, and it is older than the files now.
+        fs::remove(packPath, ec);
+    }
 
     fs::path sceneFile = fs::path(sceneDir) /
         (fs::path(sceneDir).filename().string() + ".gScene");
@@ -101,6 +225,55 @@ void SceneManager::SaveAllObjects(const SceneFolder& folder,
     }
 }
 
+void SceneManager::RemoveObjectFiles(const std::string& objectsDir,
+    const std::unordered_set<std::string>& names)
+{
+    std::error_code ec;
+    if (!fs::exists(objectsDir, ec))
+        return;
+
+    for (const std::string& name : names)
+        fs::remove(fs::path(objectsDir) / (name + ".gObject"), ec);
+
+    // Only drops the folder if nothing else was kept in it.
+    if (fs::is_empty(objectsDir, ec))
+        fs::remove(objectsDir, ec);
+}
+
+void SceneManager::PackAllObjects(const SceneFolder& folder, ObjectPack& pack,
+    std::unordered_set<std::string>& names, std::string& record) const
+{
+    for (const auto& objPtr : folder.objects)
+    {
+        const SceneObject& obj = *objPtr;
+
+        if (ObjectXml::SaveObjectToText(obj, record, m_registry))
+            pack.Write(obj.name, record);
+        names.insert(obj.name);
+    }
+
+    for (const auto& child : folder.children)
+    {
+        PackAllObjects(*child, pack, names, record);
+    }
+}
+
+void SceneManager::SetObjectStorage(ObjectStorage storage)
+{
+    m_storage = storage;
+}
+
+ObjectStorage SceneManager::GetObjectStorage() const
+{
+    return m_storage;
+}
+
+std::string SceneManager::GetObjectPackPath(const std::string& sceneDir)
+{
+    fs::path dir(sceneDir);
+    return (dir / (dir.filename().string() + ".gObjectPack")).string();
+}
+
 SceneObject* SceneManager::CreateObjectFromLogicUnit(
     const std::string& typeName,
     SceneFolder* targetFolder)
@@ -154,3 +327,135 @@ SceneObject* SceneManager::CreateObjectFromLogicUnit(
 
     return ptr;
 }
+
+void SceneManager::RunStorageBenchmark(uint32_t objectCount)
+{
+    using Clock = std::chrono::steady_clock;
+    const uint32_t perFolder = 50;
+
+    auto ms = [](Clock::time_point t0)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        };
+
+    // One logic unit with the usual mix of parameters.
+    GV_Logic_Unit unit;
+    unit.typeName = "BenchProp";
+    unit.chunkType = GV_CHUNK_LOGIC_UNIT;
+    for (const char* name : { "PositionX", "PositionY", "PositionZ", "RotationY", "Scale" })
+        unit.params.push_back({ name, ParamType::Float, true, "0", "" });
+    unit.params.push_back({ "Health", ParamType::Int, true, "100", "" });
+    unit.params.push_back({ "Visible", ParamType::Bool, true, "true", "" });
+    unit.params.push_back({ "Mesh", ParamType::String, false, "Props/Crate.gMesh", "" });
+    unit.params.push_back({ "OnUse", ParamType::Event, false, "", "" });
+
+    LogicUnitRegistry registry;
+    registry.Register(unit);
+
+    SceneManager scene(registry);
+    SceneFolder& root = scene.GetRootFolder();
+    root.name = "Root";
+
+    char name[32];
+    for (uint32_t first = 0; first < objectCount; first += perFolder)
+    {
+        auto folder = std::make_unique<SceneFolder>();
+        std::snprintf(name, sizeof(name), "Group%u", first / perFolder);
+        folder->name = name;
+        folder->parent = &root;
+
+        for (uint32_t o = first; o < std::min(objectCount, first + perFolder); ++o)
+        {
+            SceneObject* obj = scene.CreateObjectFromLogicUnit(unit.typeName, folder.get());
+            std::snprintf(name, sizeof(name), "Prop_%u", o);
+            obj->name = name;
+
+            for (size_t p = 0; p < 5; ++p)
+                obj->def->values[p].fval = static_cast<float>(o) * 0.37f + static_cast<float>(p);
+            obj->def->values[5].ival = static_cast<int>(o % 200);
+        }
+
+        root.children.push_back(std::move(folder));
+    }
+
+    const fs::path folder = fs::temp_directory_path() / "GVSceneStorageBench";
+    const std::string sceneDir = (folder / "Bench").string();
+    const std::string packPath = GetObjectPackPath(sceneDir);
+
+    std::error_code ec;
+    fs::remove_all(folder, ec);
+    fs::create_directories(sceneDir, ec);
+
+    // Per-file loads would otherwise build a cache file for every object.
+    // Only this thread's loads are affected, not a running export.
+    XmlCache::ScopedMode noCache(XmlCache::Mode::Off);
+
+    auto load = [&](double& outMs)
+        {
+            SceneManager loaded(registry);
+            Clock::time_point t0 = Clock::now();
+            bool ok = loaded.LoadScene(sceneDir);
+            outMs = ms(t0);
+            return ok ? HashObjects(loaded.GetRootFolder()) : 0;
+        };
+
+    const uint64_t original = HashObjects(root);
+
+    scene.SetObjectStorage(ObjectStorage::Files);
+    Clock::time_point t0 = Clock::now();
+    scene.SaveScene(sceneDir);
+    const double filesSaveMs = ms(t0);
+    const uint64_t filesBytes = GetFolderBytes(fs::path(sceneDir) / "Objects");
+
+    double filesLoadMs = 0.0;
+    const bool filesMatch = load(filesLoadMs) == original;
+
+    // Packing removes the object files written above.
+    scene.SetObjectStorage(ObjectStorage::Packed);
+    t0 = Clock::now();
+    scene.SaveScene(sceneDir);
+    const double packSaveMs = ms(t0);
+
+    // Every hundredth object moves.
+    uint32_t index = 0;
+    uint32_t changed = 0;
+    for (auto& child : root.children)
+    {
+        for (auto& obj : child->objects)
+        {
+            if (index++ % 100 != 0)
+                continue;
+            obj->def->values[0].fval += 1.0f;
+            ++changed;
+        }
+    }
+    const uint64_t edited = HashObjects(root);
+
+    t0 = Clock::now();
+    scene.SaveScene(sceneDir);
+    const double packUpdateMs = ms(t0);
+
+    double packLoadMs = 0.0;
+    const bool packMatch = load(packLoadMs) == edited;
+
+    uint64_t liveBytes = 0;
+    uint64_t deadBytes = 0;
+    {
+        ObjectPack pack;
+        if (pack.Open(packPath))
+        {
+            liveBytes = pack.GetLiveBytes();
+            deadBytes = pack.GetDeadBytes();
+        }
+    }
+
+    fs::remove_all(folder, ec);
+
+    std::cout << "[SceneManager] Storage benchmark: " << objectCount << " objects\n";
+    std::cout << "[SceneManager]   Files:  " << filesBytes / 1024 << " KB in " << objectCount << " files, save "
+        << filesSaveMs << " ms, load " << filesLoadMs << " ms" << (filesMatch ? "" : " (MISMATCH)") << "\n";
+    std::cout << "[SceneManager]   Packed: " << liveBytes / 1024 << " KB live, " << deadBytes / 1024
+        << " KB dead, save " << packSaveMs << " ms, load " << packLoadMs << " ms"
+        << (packMatch ? "" : " (MISMATCH)") << "\n";
+    std::cout << "[SceneManager]   Packed save with " << changed << " objects changed: " << packUpdateMs << " ms\n";
+}
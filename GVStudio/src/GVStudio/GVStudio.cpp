@@ -1,5 +1,6 @@
 ﻿#include "GVStudio/GVStudio.h"
 #include "Viewports/Dialogs/StartupDialog.h"
+#include "MiniXml/XmlCache.h"
 
 #include <SDL3/SDL.h>
 #include "3rdParty/glad/glad.h"
@@ -160,6 +161,25 @@ void GV_STUDIO::InitProject()
 
     m_resourceDatabase.BuildFolderTree(fullResources.string());
 
+    if (m_state.project.cacheFolder.empty())
+    {
+        XmlCache::SetMode(XmlCache::Mode::Off);
+    }
+    else if (m_state.project.cacheFolder == XmlCache::SIDECAR_FOLDER)
+    {
+        std::cout << "  CachePath:    next to each source file\n";
+        XmlCache::SetMode(XmlCache::Mode::Sidecar);
+    }
+    else
+    {
+        fs::path fullCache = root / m_state.project.cacheFolder;
+        std::cout << "  CachePath:    " << fullCache.string() << "\n";
+        XmlCache::SetMode(XmlCache::Mode::Directory, fullCache.string());
+    }
+
+    m_sceneManager.SetObjectStorage(m_state.project.packObjects ?
+        ObjectStorage::Packed : ObjectStorage::Files);
+
     fs::path fullScenePath = root / m_state.currentScene.scenePath;
     std::cout << "  ScenePath:    " << fullScenePath.string() << "\n";
 
@@ -1,18 +1,18 @@
 ﻿#include "MiniXML/MiniXml.h"
+#include "MiniXml/XmlScan.h"
+#include "MiniXml/XmlWriter.h"
+#include "Platform/MappedFile.h"
 
-#include <fstream>
-#include <sstream>
-#include <cctype>
+#include <utility>
 
 namespace
 {
-    void SkipWhitespace(const std::string& s, size_t& i)
+    void SkipWhitespace(std::string_view s, size_t& i)
     {
-        while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i])))
-            ++i;
+        i += XmlScan::SkipSpace(s.data() + i, s.size() - i);
     }
 
-    bool StartsWith(const std::string& s, size_t i, const char* lit)
+    bool StartsWith(std::string_view s, size_t i, const char* lit)
     {
         size_t j = 0;
         while (lit[j] != '\0')
@@ -24,29 +24,21 @@ namespace
         return true;
     }
 
-    std::string ReadName(const std::string& s, size_t& i)
+    std::string_view ReadName(std::string_view s, size_t& i)
     {
         size_t start = i;
-        while (i < s.size())
-        {
-            char c = s[i];
-            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == ':')
-                ++i;
-            else
-                break;
-        }
+        i += XmlScan::SkipName(s.data() + i, s.size() - i);
         return s.substr(start, i - start);
     }
 
-    std::string ReadUntil(const std::string& s, size_t& i, char endChar)
+    std::string_view ReadUntil(std::string_view s, size_t& i, char endChar)
     {
         size_t start = i;
-        while (i < s.size() && s[i] != endChar)
-            ++i;
+        i += XmlScan::FindChar(s.data() + i, s.size() - i, endChar);
         return s.substr(start, i - start);
     }
 
-    bool ReadQuoted(const std::string& s, size_t& i, std::string& out)
+    bool ReadQuoted(std::string_view s, size_t& i, std::string& out)
     {
         if (i >= s.size())
             return false;
@@ -55,8 +47,7 @@ namespace
             return false;
         ++i;
         size_t start = i;
-        while (i < s.size() && s[i] != quote)
-            ++i;
+        i += XmlScan::FindChar(s.data() + i, s.size() - i, quote);
         if (i >= s.size())
             return false;
         out = s.substr(start, i - start);
@@ -64,7 +55,7 @@ namespace
         return true;
     }
 
-    bool ParseAttributes(const std::string& s, size_t& i, std::vector<XmlAttribute>& attrs)
+    bool ParseAttributes(std::string_view s, size_t& i, std::vector<XmlAttribute>& attrs)
     {
         while (true)
         {
@@ -74,7 +65,7 @@ namespace
             char c = s[i];
             if (c == '/' || c == '>')
                 break;
-            std::string name = ReadName(s, i);
+            std::string_view name = ReadName(s, i);
             if (name.empty())
                 return false;
             SkipWhitespace(s, i);
@@ -93,9 +84,9 @@ namespace
         return true;
     }
 
-    bool ParseNodeInner(const std::string& s, size_t& i, XmlNode& outNode);
+    bool ParseNodeInner(std::string_view s, size_t& i, XmlNode& outNode);
 
-    bool ParseNode(const std::string& s, size_t& i, XmlNode& outNode)
+    bool ParseNode(std::string_view s, size_t& i, XmlNode& outNode)
     {
         if (i >= s.size() || s[i] != '<')
             return false;
@@ -107,7 +98,7 @@ namespace
         {
             ++i;
             size_t endPos = s.find("?>", i);
-            if (endPos == std::string::npos)
+            if (endPos == std::string_view::npos)
                 return false;
             i = endPos + 2;
             SkipWhitespace(s, i);
@@ -118,7 +109,7 @@ namespace
         {
             i += 3;
             size_t endPos = s.find("-->", i);
-            if (endPos == std::string::npos)
+            if (endPos == std::string_view::npos)
                 return false;
             i = endPos + 3;
             SkipWhitespace(s, i);
@@ -152,7 +143,7 @@ namespace
         return ParseNodeInner(s, i, outNode);
     }
 
-    bool ParseNodeInner(const std::string& s, size_t& i, XmlNode& outNode)
+    bool ParseNodeInner(std::string_view s, size_t& i, XmlNode& outNode)
     {
         std::string collectedText;
 
@@ -163,7 +154,7 @@ namespace
                 if (StartsWith(s, i, "</"))
                 {
                     i += 2;
-                    std::string closeName = ReadName(s, i);
+                    std::string_view closeName = ReadName(s, i);
                     SkipWhitespace(s, i);
                     if (i >= s.size() || s[i] != '>')
                         return false;
@@ -174,9 +165,9 @@ namespace
                     {
                         size_t start = 0;
                         size_t end = collectedText.size();
-                        while (start < end && std::isspace(static_cast<unsigned char>(collectedText[start])))
+                        while (start < end && XmlScan::IsSpace(collectedText[start]))
                             ++start;
-                        while (end > start && std::isspace(static_cast<unsigned char>(collectedText[end - 1])))
+                        while (end > start && XmlScan::IsSpace(collectedText[end - 1]))
                             --end;
                         if (end > start)
                             outNode.text = collectedText.substr(start, end - start);
@@ -187,7 +178,7 @@ namespace
                 {
                     i += 4;
                     size_t endPos = s.find("-->", i);
-                    if (endPos == std::string::npos)
+                    if (endPos == std::string_view::npos)
                         return false;
                     i = endPos + 3;
                     continue;
@@ -196,7 +187,7 @@ namespace
                 {
                     ++i;
                     size_t endPos = s.find("?>", i);
-                    if (endPos == std::string::npos)
+                    if (endPos == std::string_view::npos)
                         return false;
                     i = endPos + 2;
                     continue;
@@ -210,21 +201,22 @@ namespace
                     {
                         size_t start = 0;
                         size_t end = collectedText.size();
-                        while (start < end && std::isspace(static_cast<unsigned char>(collectedText[start])))
+                        while (start < end && XmlScan::IsSpace(collectedText[start]))
                             ++start;
-                        while (end > start && std::isspace(static_cast<unsigned char>(collectedText[end - 1])))
+                        while (end > start && XmlScan::IsSpace(collectedText[end - 1]))
                             --end;
                         if (end > start && outNode.text.empty())
                             outNode.text = collectedText.substr(start, end - start);
                         collectedText.clear();
                     }
-                    outNode.children.push_back(child);
+                    outNode.children.push_back(std::move(child));
                 }
             }
             else
             {
-                collectedText.push_back(s[i]);
-                ++i;
+                size_t end = i + XmlScan::FindChar(s.data() + i, s.size() - i, '<');
+                collectedText.append(s, i, end - i);
+                i = end;
             }
         }
 
@@ -288,7 +280,7 @@ namespace
     }
 }
 
-bool XmlParseString(const std::string& text, XmlNode& outRoot)
+bool XmlParseString(std::string_view text, XmlNode& outRoot)
 {
     size_t i = 0;
     SkipWhitespace(text, i);
@@ -307,19 +299,18 @@ std::string XmlToString(const XmlNode& root, int indentSpaces)
 
 bool XmlLoadFromFile(const std::string& path, XmlNode& outRoot)
 {
-    std::ifstream ifs(path);
-    if (!ifs.is_open())
+    // Parsed in place: the mapping is only read, the tree gets copies.
+    MappedFile file;
+    if (!file.Open(path))
         return false;
-    std::stringstream ss;
-    ss << ifs.rdbuf();
-    return XmlParseString(ss.str(), outRoot);
+    return XmlParseString(file.GetView(), outRoot);
 }
 
 bool XmlSaveToFile(const std::string& path, const XmlNode& root)
 {
-    std::ofstream ofs(path);
-    if (!ofs.is_open())
+    XmlWriter writer;
+    if (!writer.Open(path))
         return false;
-    ofs << XmlToString(root, 2);
-    return true;
+    writer.WriteNode(root);
+    return writer.Close();
 }
@@ -1,21 +1,16 @@
 #include "MiniXml/ObjectXml.h"
 #include "GVFramework/Scene/SceneObject.h"
 #include "Database/LogicUnitRegistry.h"
-#include "MiniXML/MiniXml.h"
+#include "MiniXml/XmlNumber.h"
+#include "MiniXml/XmlPullParser.h"
+#include "MiniXml/XmlWriter.h"
 
-#include <cstdlib>
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
 namespace
 {
-    const XmlAttribute* FindAttr(const XmlNode& node, const std::string& name)
-    {
-        for (const XmlAttribute& a : node.attributes)
-            if (a.name == name)
-                return &a;
-        return nullptr;
-    }
-
     int FindParamIndex(const GV_Logic_Unit& def, const std::string& paramName)
     {
         for (size_t i = 0; i < def.params.size(); ++i)
@@ -23,119 +18,192 @@ namespace
                 return static_cast<int>(i);
         return -1;
     }
-}
 
-namespace ObjectXml
-{
-    bool LoadObjectFromXml(
-        SceneObject& obj,
-        const std::string& xmlPath,
-        LogicUnitRegistry& registry)
+    void ApplyParam(const GV_Logic_Unit& def, GV_Logic_Unit_Instance& inst,
+        const std::string& paramName, const std::string& val)
     {
-        XmlNode root;
-        if (!XmlLoadFromFile(xmlPath, root))
-            return false;
-
-        if (root.name != "Object")
-            return false;
+        int idx = FindParamIndex(def, paramName);
+        if (idx < 0)
+            return;
 
-        if (const XmlAttribute* n = FindAttr(root, "name"))
-            if (obj.name.empty())
-                obj.name = n->value;
+        const LU_Param_Def& pDef = def.params[idx];
+        LU_Param_Val& pVal = inst.values[idx];
 
-        obj.def.reset();
-
-        const XmlNode* luNode = nullptr;
-        for (const XmlNode& child : root.children)
+        switch (pDef.type)
         {
-            if (child.name == "LogicUnit")
-            {
-                luNode = &child;
-                break;
-            }
+        case ParamType::Float:
+            pVal.fval = XmlNumber::ParseFloat(val);
+            break;
+
+        case ParamType::Int:
+            pVal.ival = XmlNumber::ParseInt(val);
+            break;
+
+        case ParamType::Bool:
+            pVal.bval = (val == "true" || val == "1");
+            break;
+
+        case ParamType::String:
+        case ParamType::Event:
+        case ParamType::Message:
+            pVal.sval = val;
+            break;
+
+        case ParamType::Separator:
+            break;
         }
+    }
+
+    // Which element the attributes being read belong to.
+    enum class AttrOwner
+    {
+        None,
+        Object,
+        LogicUnit,
+        Param
+    };
+
+    bool ReadObject(XmlPullParser& xml, SceneObject& obj, LogicUnitRegistry& registry)
+    {
+        if (xml.Next() != XmlEvent::StartElement || xml.GetAtom() != ATOM_OBJECT)
+            return false;
+
+        // Nothing touches obj until the whole file has parsed.
+        std::string objectName;
+        bool hasObjectName = false;
 
-        if (!luNode)
-            return true;
+        std::string unitName;
+        bool hasUnitName = false;
+        bool unitSeen = false; // only the first LogicUnit counts
+        bool inUnit = false;
+        bool unitResolved = false;
 
-        const XmlAttribute* nameAttr = FindAttr(*luNode, "name");
-        if (!nameAttr)
-            return true;
+        const GV_Logic_Unit* def = nullptr;
+        std::unique_ptr<GV_Logic_Unit_Instance> inst;
 
-        const GV_Logic_Unit* def = registry.Find(nameAttr->value);
-        if (!def)
-            return true;
+        std::string paramName;
+        std::string paramValue;
+        bool hasParamName = false;
+        bool hasParamValue = false;
+        bool inParam = false;
 
-        auto inst = std::make_unique<GV_Logic_Unit_Instance>();
-        inst->def = const_cast<GV_Logic_Unit*>(def);
-        inst->instanceName.clear();
-        inst->values.resize(def->params.size());
+        AttrOwner owner = AttrOwner::Object;
 
-        for (const XmlNode& pNode : luNode->children)
+        // Params need the definition, which is known once the LogicUnit
+        // element's attributes are done.
+        auto endAttributes = [&]()
         {
-            if (pNode.name != "Param")
-                continue;
+            if (owner == AttrOwner::LogicUnit && !unitResolved)
+            {
+                unitResolved = true;
+                def = hasUnitName ? registry.Find(unitName) : nullptr;
 
-            const XmlAttribute* pn = FindAttr(pNode, "name");
-            const XmlAttribute* pv = FindAttr(pNode, "value");
-            if (!pn || !pv)
-                continue;
+                if (def)
+                {
+                    inst = std::make_unique<GV_Logic_Unit_Instance>();
+                    inst->def = const_cast<GV_Logic_Unit*>(def);
+                    inst->instanceName.clear();
+                    inst->values.resize(def->params.size());
+                }
+            }
 
-            int idx = FindParamIndex(*def, pn->value);
-            if (idx < 0)
-                continue;
+            owner = AttrOwner::None;
+        };
 
-            const LU_Param_Def& pDef = def->params[idx];
-            LU_Param_Val& pVal = inst->values[idx];
+        while (true)
+        {
+            XmlEvent event = xml.Next();
 
-            const std::string& val = pv->value;
+            if (event == XmlEvent::Error)
+                return false;
+            if (event == XmlEvent::EndDocument)
+                break;
 
-            switch (pDef.type)
+            if (event == XmlEvent::Attribute)
             {
-            case ParamType::Float:
-                pVal.fval = std::strtof(val.c_str(), nullptr);
-                break;
+                const XmlAtom name = xml.GetAtom();
 
-            case ParamType::Int:
-                pVal.ival = std::strtol(val.c_str(), nullptr, 10);
-                break;
+                if (owner == AttrOwner::Object && name == ATOM_ATTR_NAME && !hasObjectName)
+                {
+                    objectName = xml.GetValue();
+                    hasObjectName = true;
+                }
+                else if (owner == AttrOwner::LogicUnit && name == ATOM_ATTR_NAME && !hasUnitName)
+                {
+                    unitName = xml.GetValue();
+                    hasUnitName = true;
+                }
+                else if (owner == AttrOwner::Param && name == ATOM_ATTR_NAME && !hasParamName)
+                {
+                    paramName = xml.GetValue();
+                    hasParamName = true;
+                }
+                else if (owner == AttrOwner::Param && name == ATOM_ATTR_VALUE && !hasParamValue)
+                {
+                    paramValue = xml.GetValue();
+                    hasParamValue = true;
+                }
+                continue;
+            }
 
-            case ParamType::Bool:
-                pVal.bval = (val == "true" || val == "1");
-                break;
+            endAttributes();
 
-            case ParamType::String:
-            case ParamType::Event:
-            case ParamType::Message:
-                pVal.sval = val;
-                break;
+            if (event == XmlEvent::StartElement)
+            {
+                const XmlAtom name = xml.GetAtom();
 
-            case ParamType::Separator:
-                break;
+                if (xml.GetDepth() == 2 && name == ATOM_LOGIC_UNIT && !unitSeen)
+                {
+                    unitSeen = true;
+                    inUnit = true;
+                    owner = AttrOwner::LogicUnit;
+                }
+                else if (xml.GetDepth() == 3 && inUnit && name == ATOM_PARAM)
+                {
+                    inParam = true;
+                    hasParamName = false;
+                    hasParamValue = false;
+                    owner = AttrOwner::Param;
+                }
+                else if (!xml.Skip())
+                {
+                    return false;
+                }
+            }
+            else if (event == XmlEvent::EndElement)
+            {
+                if (inParam)
+                {
+                    if (inst && hasParamName && hasParamValue)
+                        ApplyParam(*def, *inst, paramName, paramValue);
+                    inParam = false;
+                }
+                else
+                {
+                    inUnit = false;
+                }
             }
         }
 
+        if (hasObjectName && obj.name.empty())
+            obj.name = objectName;
+
         obj.def = std::move(inst);
         return true;
     }
 
-    bool SaveObjectToXml(
-        const SceneObject& obj,
-        const std::string& xmlPath,
-        LogicUnitRegistry& registry)
+    void WriteObject(XmlWriter& writer, const SceneObject& obj)
     {
-        XmlNode root;
-        root.name = "Object";
-        root.attributes.push_back({ "name", obj.name });
+        writer.StartElement("Object");
+        writer.Attribute("name", obj.name);
 
         if (obj.def && obj.def->def)
         {
             const GV_Logic_Unit_Instance& inst = *obj.def;
             const GV_Logic_Unit& def = *inst.def;
 
-            XmlNode luNode;
-            luNode.name = "LogicUnit";
-            luNode.attributes.push_back({ "name", def.typeName });
+            writer.StartElement("LogicUnit");
+            writer.Attribute("name", def.typeName);
 
             size_t count = std::min(def.params.size(), inst.values.size());
 
@@ -147,44 +215,91 @@ namespace ObjectXml
                 if (pDef.type == ParamType::Separator)
                     continue;
 
-                XmlNode pNode;
-                pNode.name = "Param";
-                pNode.attributes.push_back({ "name", pDef.name });
-
-                XmlAttribute v;
-                v.name = "value";
+                writer.StartElement("Param");
+                writer.Attribute("name", pDef.name);
 
                 switch (pDef.type)
                 {
                 case ParamType::Float:
-                    v.value = std::to_string(pVal.fval);
+                    writer.Attribute("value", pVal.fval);
                     break;
 
                 case ParamType::Int:
-                    v.value = std::to_string(pVal.ival);
+                    writer.Attribute("value", pVal.ival);
                     break;
 
                 case ParamType::Bool:
-                    v.value = pVal.bval ? "true" : "false";
+                    writer.Attribute("value", pVal.bval ? "true" : "false");
                     break;
 
                 case ParamType::String:
                 case ParamType::Event:
                 case ParamType::Message:
-                    v.value = pVal.sval;
+                    writer.Attribute("value", pVal.sval);
                     break;
 
                 default:
+                    writer.Attribute("value", "");
                     break;
                 }
 
-                pNode.attributes.push_back(v);
-                luNode.children.push_back(std::move(pNode));
+                writer.EndElement();
             }
 
-            root.children.push_back(std::move(luNode));
+            writer.EndElement();
         }
 
-        return XmlSaveToFile(xmlPath, root);
+        writer.EndElement();
+    }
+}
+
+namespace ObjectXml
+{
+    bool LoadObjectFromXml(
+        SceneObject& obj,
+        const std::string& xmlPath,
+        LogicUnitRegistry& registry)
+    {
+        XmlPullParser xml;
+        if (!xml.Open(xmlPath))
+            return false;
+
+        return ReadObject(xml, obj, registry);
+    }
+
+    bool LoadObjectFromText(
+        SceneObject& obj,
+        std::string_view text,
+        LogicUnitRegistry& registry)
+    {
+        XmlPullParser xml;
+        xml.SetBuffer(text);
+        return ReadObject(xml, obj, registry);
+    }
+
+    bool SaveObjectToXml(
+        const SceneObject& obj,
+        const std::string& xmlPath,
+        LogicUnitRegistry& registry)
+    {
+        XmlWriter writer;
+        if (!writer.Open(xmlPath))
+            return false;
+
+        WriteObject(writer, obj);
+        return writer.Close();
+    }
+
+    bool SaveObjectToText(
+        const SceneObject& obj,
+        std::string& text,
+        LogicUnitRegistry& registry)
+    {
+        text.clear();
+
+        XmlWriter writer;
+        writer.OpenString(text);
+        WriteObject(writer, obj);
+        return writer.Close();
     }
 }
@@ -1,5 +1,7 @@
 #include "MiniXml/ProjectXml.h"
 #include "MiniXml/MiniXml.h"
+#include "MiniXml/XmlDocument.h"
+#include "MiniXml/XmlNumber.h"
 
 #include <iostream>
 #include <filesystem>
@@ -8,16 +10,6 @@ namespace fs = std::filesystem;
 
 namespace
 {
-    const XmlAttribute* FindAttr(const XmlNode& node, const std::string& name)
-    {
-        for (const XmlAttribute& a : node.attributes)
-        {
-            if (a.name == name)
-                return &a;
-        }
-        return nullptr;
-    }
-
     std::string GetFileNameFromPath(const std::string& path)
     {
         size_t slash = path.find_last_of("\\/");
@@ -32,15 +24,17 @@ bool ProjectXml::LoadProjectFromXml(GV_Project_Info& project, const std::string&
 {
     std::cout << "\n[ProjectXml] Loading project: " << xmlPath << "\n";
 
-    XmlNode root;
+    XmlDocument document;
 
-    if (!XmlLoadFromFile(xmlPath, root))
+    if (!document.LoadFromFile(xmlPath))
     {
         std::cout << "[ProjectXml] Failed to load XML file.\n";
         return false;
     }
 
-    if (root.name != "Project")
+    const XmlViewNode& root = *document.GetRoot();
+
+    if (root.atom != ATOM_PROJECT)
     {
         std::cout << "[ProjectXml] Invalid root node: " << root.name << "\n";
         return false;
@@ -48,55 +42,62 @@ bool ProjectXml::LoadProjectFromXml(GV_Project_Info& project, const std::string&
 
     project = GV_Project_Info();
     project.projectPath = xmlPath;
+    project.projectVersion = XmlNumber::ParseInt(root.GetAttribute(ATOM_ATTR_VERSION), 1);
 
     project.projectRoot =
         fs::path(xmlPath).parent_path().string();
 
 
-    for (const XmlNode& child : root.children)
+    for (const XmlViewNode* child = root.firstChild; child; child = child->nextSibling)
     {
-        if (child.name == "Name")
+        if (child->atom == ATOM_NAME)
         {
-            project.projectName = child.text;
+            project.projectName = child->text;
             std::cout << "[ProjectXml] Project Name: "
                 << project.projectName << "\n";
         }
-        else if (child.name == "Paths")
+        else if (child->atom == ATOM_PATHS)
         {
             std::cout << "[ProjectXml] Reading Paths...\n";
 
-            for (const XmlNode& pathNode : child.children)
+            for (const XmlViewNode* pathNode = child->firstChild; pathNode; pathNode = pathNode->nextSibling)
             {
-                if (pathNode.name == "DataFolder")
+                if (pathNode->atom == ATOM_DATA_FOLDER)
                 {
-                    project.dataFolder = pathNode.text;
+                    project.dataFolder = pathNode->text;
                     std::cout << "  DataFolder: "
                         << project.dataFolder << "\n";
                 }
-                else if (pathNode.name == "ResourceFolder")
+                else if (pathNode->atom == ATOM_RESOURCE_FOLDER)
                 {
-                    project.resourceFolder = pathNode.text;
+                    project.resourceFolder = pathNode->text;
                     std::cout << "  ResourceFolder: "
                         << project.resourceFolder << "\n";
                 }
-                else if (pathNode.name == "SourceFolder")
+                else if (pathNode->atom == ATOM_SOURCE_FOLDER)
                 {
-                    project.sourceFolder = pathNode.text;
+                    project.sourceFolder = pathNode->text;
                     std::cout << "  SourceFolder: "
                         << project.sourceFolder << "\n";
                 }
+                else if (pathNode->atom == ATOM_CACHE_FOLDER)
+                {
+                    project.cacheFolder = pathNode->text;
+                    std::cout << "  CacheFolder: "
+                        << project.cacheFolder << "\n";
+                }
             }
         }
-        else if (child.name == "Scenes")
+        else if (child->atom == ATOM_SCENES)
         {
             std::cout << "[ProjectXml] Reading Scenes...\n";
 
-            for (const XmlNode& sceneNode : child.children)
+            for (const XmlViewNode* sceneNode = child->firstChild; sceneNode; sceneNode = sceneNode->nextSibling)
             {
-                if (sceneNode.name == "Scene")
+                if (sceneNode->atom == ATOM_SCENE)
                 {
-                    const XmlAttribute* pathAttr =
-                        FindAttr(sceneNode, "path");
+                    const XmlViewAttribute* pathAttr =
+                        sceneNode->FindAttribute(ATOM_ATTR_PATH);
 
                     if (pathAttr)
                     {
@@ -116,12 +117,18 @@ bool ProjectXml::LoadProjectFromXml(GV_Project_Info& project, const std::string&
                 }
             }
         }
-        else if (child.name == "StartupScene")
+        else if (child->atom == ATOM_STARTUP_SCENE)
         {
-            project.startupScene = child.text;
+            project.startupScene = child->text;
             std::cout << "[ProjectXml] StartupScene: "
                 << project.startupScene << "\n";
         }
+        else if (child->atom == ATOM_OBJECT_STORAGE)
+        {
+            project.packObjects = child->text == "Packed";
+            std::cout << "[ProjectXml] ObjectStorage: "
+                << child->text << "\n";
+        }
     }
 
     std::cout << "[ProjectXml] Total Scenes: "
@@ -144,7 +151,8 @@ bool ProjectXml::SaveProjectToXml(
 
     XmlAttribute versionAttr;
     versionAttr.name = "version";
-    versionAttr.value = "1";
+    char versionText[XmlNumber::MAX_CHARS];
+    versionAttr.value = XmlNumber::Format(project.projectVersion, versionText);
     root.attributes.push_back(versionAttr);
 
     {
@@ -173,6 +181,14 @@ bool ProjectXml::SaveProjectToXml(
         sourceNode.text = project.sourceFolder;
         pathsNode.children.push_back(sourceNode);
 
+        if (!project.cacheFolder.empty())
+        {
+            XmlNode cacheNode;
+            cacheNode.name = "CacheFolder";
+            cacheNode.text = project.cacheFolder;
+            pathsNode.children.push_back(cacheNode);
+        }
+
         root.children.push_back(pathsNode);
     }
 
@@ -210,6 +226,14 @@ bool ProjectXml::SaveProjectToXml(
             << project.startupScene << "\n";
     }
 
+    if (project.packObjects)
+    {
+        XmlNode storageNode;
+        storageNode.name = "ObjectStorage";
+        storageNode.text = "Packed";
+        root.children.push_back(storageNode);
+    }
+
     if (!XmlSaveToFile(xmlPath, root))
     {
         std::cout << "[ProjectXml] Failed to save project file.\n";
@@ -1,79 +1,216 @@
 ﻿#include "MiniXml/SceneXml.h"
 #include "GVFramework/Scene/SceneObject.h"
 #include "GVFramework/Scene/SceneManager.h"
-#include "MiniXML/MiniXml.h"
+#include "MiniXml/XmlCache.h"
+#include "MiniXml/XmlDocument.h"
+#include "MiniXml/XmlPullParser.h"
+#include "MiniXml/XmlWriter.h"
 
+#include <filesystem>
 #include <iostream>
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace
 {
-    const XmlAttribute* FindAttr(const XmlNode& node, const std::string& name)
+    void WriteFolder(XmlWriter& writer, const SceneFolder& folder)
     {
-        for (const XmlAttribute& a : node.attributes)
-            if (a.name == name)
-                return &a;
-        return nullptr;
+        writer.StartElement("Folder");
+        writer.Attribute("name", folder.name);
+
+        for (const auto& obj : folder.objects)
+        {
+            writer.StartElement("Object");
+            writer.Attribute("name", obj->name);
+
+            if (!obj->assetPath.empty())
+                writer.Attribute("asset", obj->assetPath);
+
+            writer.EndElement();
+        }
+
+        for (const auto& sub : folder.children)
+            WriteFolder(writer, *sub);
+
+        writer.EndElement();
     }
 
-    void LoadFolder(const XmlNode& xmlFolder, SceneFolder& folder, SceneFolder* parent)
+    // Same reading as the pull parser path: the last name or asset
+    // attribute wins and unknown elements are skipped whole. True if the
+    // folder had a name attribute.
+    bool ReadFolder(const XmlViewNode* node, SceneFolder& folder)
     {
-        folder.parent = parent;
+        bool hasName = false;
+        for (const XmlViewAttribute* a = node->firstAttribute; a; a = a->next)
+        {
+            if (a->atom == ATOM_ATTR_NAME)
+            {
+                folder.name = std::string(a->value);
+                hasName = true;
+            }
+        }
 
-        if (const XmlAttribute* nameAttr = FindAttr(xmlFolder, "name"))
-            folder.name = nameAttr->value;
+        for (const XmlViewNode* child = node->firstChild; child; child = child->nextSibling)
+        {
+            if (child->atom == ATOM_FOLDER)
+            {
+                auto sub = std::make_unique<SceneFolder>();
+                sub->parent = &folder;
 
-        folder.objects.clear();
-        folder.children.clear();
+                ReadFolder(child, *sub);
+                folder.children.push_back(std::move(sub));
+            }
+            else if (child->atom == ATOM_OBJECT)
+            {
+                auto obj = std::make_unique<SceneObject>();
+
+                for (const XmlViewAttribute* a = child->firstAttribute; a; a = a->next)
+                {
+                    if (a->atom == ATOM_ATTR_NAME)
+                        obj->name = std::string(a->value);
+                    else if (a->atom == ATOM_ATTR_ASSET)
+                        obj->assetPath = std::string(a->value);
+                }
+
+                folder.objects.push_back(std::move(obj));
+            }
+        }
+
+        return hasName;
+    }
 
-        for (const XmlNode& child : xmlFolder.children)
+    bool LoadGScenePull(const std::string& path, SceneFolder& loaded, bool& hasRootName)
+    {
+        XmlPullParser xml;
+        if (!xml.Open(path))
+            return false;
+
+        if (xml.Next() != XmlEvent::StartElement || xml.GetAtom() != ATOM_SCENE)
+            return false;
+
+        bool hasRoot = false;
+
+        std::vector<SceneFolder*> folders; // open Folder elements
+        SceneObject* object = nullptr;     // open Object element
+
+        // Attributes follow their StartElement; at most one of these is set.
+        SceneFolder* attrFolder = nullptr;
+        SceneObject* attrObject = nullptr;
+
+        while (true)
         {
-            if (child.name == "Object")
+            XmlEvent event = xml.Next();
+
+            if (event == XmlEvent::Error)
+                return false;
+            if (event == XmlEvent::EndDocument)
+                break;
+
+            if (event == XmlEvent::Attribute)
             {
-                auto obj = std::make_unique<SceneObject>();
+                const XmlAtom name = xml.GetAtom();
 
-                if (const XmlAttribute* n = FindAttr(child, "name"))
-                    obj->name = n->value;
+                if (attrObject && name == ATOM_ATTR_NAME)
+                    attrObject->name = xml.GetValue();
+                else if (attrObject && name == ATOM_ATTR_ASSET)
+                    attrObject->assetPath = xml.GetValue();
+                else if (attrFolder && name == ATOM_ATTR_NAME)
+                {
+                    attrFolder->name = xml.GetValue();
+                    hasRootName = hasRootName || attrFolder == &loaded;
+                }
+                continue;
+            }
 
-                if (const XmlAttribute* a = FindAttr(child, "asset"))
-                    obj->assetPath = a->value;
+            attrFolder = nullptr;
+            attrObject = nullptr;
 
-                folder.objects.push_back(std::move(obj));
+            if (event == XmlEvent::StartElement)
+            {
+                const XmlAtom name = xml.GetAtom();
+
+                // Anything not read here is skipped whole, so every element
+                // seen is a direct child of the Scene or the open Folder.
+                if (name == ATOM_FOLDER && !object && (!folders.empty() || !hasRoot))
+                {
+                    SceneFolder* folder = &loaded;
+
+                    if (!folders.empty())
+                    {
+                        auto sub = std::make_unique<SceneFolder>();
+                        sub->parent = folders.back();
+                        folder = sub.get();
+                        folders.back()->children.push_back(std::move(sub));
+                    }
+
+                    folders.push_back(folder);
+                    attrFolder = folder;
+                }
+                else if (name == ATOM_OBJECT && !object && !folders.empty())
+                {
+                    auto obj = std::make_unique<SceneObject>();
+                    object = obj.get();
+                    attrObject = object;
+                    folders.back()->objects.push_back(std::move(obj));
+                }
+                else if (!xml.Skip())
+                {
+                    return false;
+                }
             }
-            else if (child.name == "Folder")
+            else if (event == XmlEvent::EndElement)
             {
-                auto sub = std::make_unique<SceneFolder>();
-                LoadFolder(child, *sub, &folder);
-                folder.children.push_back(std::move(sub));
+                if (object)
+                {
+                    object = nullptr;
+                }
+                else if (!folders.empty())
+                {
+                    folders.pop_back();
+                    hasRoot = hasRoot || folders.empty();
+                }
             }
         }
+
+        return hasRoot;
     }
 
-    void BuildFolderNode(const SceneFolder& folder, XmlNode& outNode)
+    // Large scenes go through XmlDocument, which splits them across
+    // threads. XmlPullParser is serial but replays an XmlCache, which
+    // beats tokenizing on any number of threads, so it keeps every scene
+    // when caching is on and the small ones either way.
+    bool UseDocument(const std::string& path)
     {
-        outNode.name = "Folder";
-        outNode.attributes.push_back({ "name", folder.name });
+        if (XmlCache::GetMode() != XmlCache::Mode::Off || std::thread::hardware_concurrency() < 2)
+            return false;
 
-        for (const auto& obj : folder.objects)
-        {
-            XmlNode objNode;
-            objNode.name = "Object";
-            objNode.attributes.push_back({ "name", obj->name });
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(path, ec);
+        return !ec && size >= XmlDocument::PARALLEL_MIN_BYTES;
+    }
 
-            if (!obj->assetPath.empty())
-                objNode.attributes.push_back({ "asset", obj->assetPath });
+    bool LoadGSceneDocument(const std::string& path, SceneFolder& loaded, bool& hasRootName)
+    {
+        XmlDocument doc;
+        if (!doc.LoadFromFile(path))
+            return false;
 
-            outNode.children.push_back(std::move(objNode));
-        }
+        const XmlViewNode* scene = doc.GetRoot();
+        if (!scene || scene->atom != ATOM_SCENE)
+            return false;
 
-        for (const auto& sub : folder.children)
-        {
-            XmlNode subNode;
-            BuildFolderNode(*sub, subNode);
-            outNode.children.push_back(std::move(subNode));
-        }
+        const XmlViewNode* rootNode = scene->firstChild;
+        while (rootNode && rootNode->atom != ATOM_FOLDER)
+            rootNode = rootNode->nextSibling;
+
+        if (!rootNode)
+            return false;
+
+        hasRootName = ReadFolder(rootNode, loaded);
+        return true;
     }
 }
 
@@ -81,42 +218,43 @@ namespace SceneXml
 {
     bool LoadGScene(const std::string& path, SceneFolder& root)
     {
-        XmlNode xml;
-        if (!XmlLoadFromFile(path, xml))
-            return false;
-
-        if (xml.name != "Scene")
-            return false;
+        // Built aside and moved in at the end, so a bad file leaves root alone.
+        SceneFolder loaded;
+        bool hasRootName = false;
 
-        const XmlNode* rootFolderNode = nullptr;
-        for (const XmlNode& child : xml.children)
+        if (UseDocument(path))
         {
-            if (child.name == "Folder")
-            {
-                rootFolderNode = &child;
-                break;
-            }
+            if (!LoadGSceneDocument(path, loaded, hasRootName))
+                return false;
         }
-
-        if (!rootFolderNode)
+        else if (!LoadGScenePull(path, loaded, hasRootName))
+        {
             return false;
+        }
+
+        root.parent = nullptr;
+        if (hasRootName)
+            root.name = loaded.name;
 
-        root.children.clear();
-        root.objects.clear();
+        root.objects = std::move(loaded.objects);
+        root.children = std::move(loaded.children);
+
+        for (auto& child : root.children)
+            child->parent = &root;
 
-        LoadFolder(*rootFolderNode, root, nullptr);
         return true;
     }
 
     bool SaveGScene(const std::string& path, const SceneFolder& rootFolder)
     {
-        XmlNode scene;
-        scene.name = "Scene";
+        XmlWriter writer;
+        if (!writer.Open(path))
+            return false;
 
-        XmlNode rootNode;
-        BuildFolderNode(rootFolder, rootNode);
-        scene.children.push_back(std::move(rootNode));
+        writer.StartElement("Scene");
+        WriteFolder(writer, rootFolder);
+        writer.EndElement();
 
-        return XmlSaveToFile(path, scene);
+        return writer.Close();
     }
 }
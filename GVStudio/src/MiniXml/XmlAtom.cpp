@@ -0,0 +1,183 @@
+#include "MiniXml/XmlAtom.h"
+
+#include <cstring>
+
+namespace
+{
+    // Same order as the ATOM_ enum.
+    const char* const kSchemaNames[ATOM_SCHEMA_COUNT] =
+    {
+        "",
+        "Scene",
+        "Folder",
+        "Object",
+        "LogicUnit",
+        "Param",
+        "Project",
+        "Name",
+        "Paths",
+        "DataFolder",
+        "ResourceFolder",
+        "SourceFolder",
+        "CacheFolder",
+        "Scenes",
+        "StartupScene",
+        "ObjectStorage",
+        "name",
+        "asset",
+        "value",
+        "path",
+        "version"
+    };
+
+    // Eight bytes per multiply; short tails use overlapping fixed-size
+    // loads, since a variable-length memcpy would be a call per name.
+    uint32_t HashName(std::string_view name)
+    {
+        const uint64_t k = 0xFF51AFD7ED558CCDull;
+        const char* p = name.data();
+        const size_t n = name.size();
+        uint64_t hash = n * 0x9E3779B97F4A7C15ull;
+
+        if (n >= 8)
+        {
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                uint64_t v;
+                std::memcpy(&v, p + i, 8);
+                hash = (hash ^ v) * k;
+            }
+
+            if (i < n)
+            {
+                uint64_t v;
+                std::memcpy(&v, p + n - 8, 8);
+                hash = (hash ^ v) * k;
+            }
+        }
+        else if (n >= 4)
+        {
+            uint32_t lo;
+            uint32_t hi;
+            std::memcpy(&lo, p, 4);
+            std::memcpy(&hi, p + n - 4, 4);
+            hash = (hash ^ (static_cast<uint64_t>(hi) << 32 | lo)) * k;
+        }
+        else if (n > 0)
+        {
+            uint64_t v = static_cast<unsigned char>(p[0]) |
+                static_cast<unsigned char>(p[n / 2]) << 8 |
+                static_cast<unsigned char>(p[n - 1]) << 16;
+            hash = (hash ^ v) * k;
+        }
+
+        return static_cast<uint32_t>(hash ^ (hash >> 29));
+    }
+
+    const XmlAtomTable& GetSchemaTable()
+    {
+        static const XmlAtomTable table;
+        return table;
+    }
+}
+
+XmlAtom XmlFindSchemaAtom(std::string_view name)
+{
+    return GetSchemaTable().Find(name);
+}
+
+XmlAtomTable::XmlAtomTable()
+{
+    Reset();
+}
+
+void XmlAtomTable::Reset()
+{
+    if (m_names.size() == ATOM_SCHEMA_COUNT)
+        return;
+
+    m_storage.clear();
+    m_names.assign(1, std::string_view());
+    m_slots.assign(64, Slot());
+
+    // Schema names point at the literals, nothing is copied.
+    for (XmlAtom atom = 1; atom < ATOM_SCHEMA_COUNT; ++atom)
+    {
+        std::string_view name(kSchemaNames[atom]);
+        uint32_t hash = HashName(name);
+
+        m_slots[FindSlot(name, hash)] = { hash, atom };
+        m_names.push_back(name);
+    }
+}
+
+size_t XmlAtomTable::FindSlot(std::string_view name, uint32_t hash) const
+{
+    const size_t mask = m_slots.size() - 1;
+    size_t slot = hash & mask;
+
+    while (m_slots[slot].atom != ATOM_NONE)
+    {
+        const Slot& s = m_slots[slot];
+        if (s.hash == hash && m_names[s.atom] == name)
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void XmlAtomTable::Grow()
+{
+    std::vector<Slot> old(m_slots.size() * 2);
+    old.swap(m_slots);
+
+    const size_t mask = m_slots.size() - 1;
+    for (const Slot& s : old)
+    {
+        if (s.atom == ATOM_NONE)
+            continue;
+
+        size_t slot = s.hash & mask;
+        while (m_slots[slot].atom != ATOM_NONE)
+            slot = (slot + 1) & mask;
+        m_slots[slot] = s;
+    }
+}
+
+XmlAtom XmlAtomTable::Intern(std::string_view name)
+{
+    const uint32_t hash = HashName(name);
+    size_t slot = FindSlot(name, hash);
+
+    if (m_slots[slot].atom != ATOM_NONE)
+        return m_slots[slot].atom;
+
+    // Half full at most, so probes stay short.
+    if (m_names.size() * 2 >= m_slots.size())
+    {
+        Grow();
+        slot = FindSlot(name, hash);
+    }
+
+    const XmlAtom atom = static_cast<XmlAtom>(m_names.size());
+    m_storage.emplace_back(name);
+    m_names.push_back(m_storage.back());
+    m_slots[slot] = { hash, atom };
+    return atom;
+}
+
+XmlAtom XmlAtomTable::Find(std::string_view name) const
+{
+    return m_slots[FindSlot(name, HashName(name))].atom;
+}
+
+std::string_view XmlAtomTable::GetName(XmlAtom atom) const
+{
+    return atom < m_names.size() ? m_names[atom] : std::string_view();
+}
+
+size_t XmlAtomTable::GetCount() const
+{
+    return m_names.size() - 1;
+}
@@ -0,0 +1,528 @@
+#include "MiniXml/XmlCache.h"
+#include "MiniXml/XmlWriter.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "Platform/MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Record kinds. Every record is the kind byte, then for each of its
+    // strings a LEB128 length and the bytes:
+    //   StartElement name | Attribute name value | Text value
+    //   EndElement | EndDocument
+    enum RecordKind : uint8_t
+    {
+        RECORD_START = 1,
+        RECORD_ATTRIBUTE = 2,
+        RECORD_TEXT = 3,
+        RECORD_END = 4,
+        RECORD_END_DOCUMENT = 5
+    };
+
+    struct Settings
+    {
+        std::mutex mutex;
+        XmlCache::Mode mode = XmlCache::Mode::Off;
+        fs::path directory;
+    };
+
+    Settings& GetSettings()
+    {
+        static Settings settings;
+        return settings;
+    }
+
+    thread_local const XmlCache::ScopedMode* t_scope = nullptr;
+
+    // Checks a cache folder can be used; false turns caching off.
+    bool PrepareDirectory(const std::string& directory, fs::path& out)
+    {
+        std::error_code ec;
+        out = fs::absolute(directory, ec);
+        fs::create_directories(out, ec);
+
+        if (ec || directory.empty())
+        {
+            std::cout << "[XmlCache] Cannot use cache folder " << directory << ", caching is off\n";
+            out.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void PutString(std::vector<char>& out, std::string_view text)
+    {
+        size_t length = text.size();
+        do
+        {
+            uint8_t byte = static_cast<uint8_t>(length & 0x7F);
+            length >>= 7;
+            if (length)
+                byte |= 0x80;
+            out.push_back(static_cast<char>(byte));
+        } while (length);
+
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    bool GetString(std::string_view events, size_t& pos, std::string_view& out)
+    {
+        size_t length = 0;
+        for (int shift = 0; ; shift += 7)
+        {
+            if (pos >= events.size() || shift > 56)
+                return false;
+
+            const uint8_t byte = static_cast<uint8_t>(events[pos++]);
+            length |= static_cast<size_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+
+        if (length > events.size() - pos)
+            return false;
+
+        out = events.substr(pos, length);
+        pos += length;
+        return true;
+    }
+
+    int64_t GetWriteTime(const std::string& path, std::error_code& ec)
+    {
+        return static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    }
+
+    // Exports to several targets parse the same scenes at once, and another
+    // editor may share the cache folder, so each write gets its own file.
+    std::string MakeTempPath(const std::string& cachePath)
+    {
+        static const uint32_t process = std::random_device()();
+        static std::atomic<uint32_t> counter{ 0 };
+
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), ".%08x.%u.tmp", process, counter.fetch_add(1));
+        return cachePath + suffix;
+    }
+
+    bool WriteCache(const std::string& cachePath, const std::vector<char>& data)
+    {
+        std::error_code ec;
+        fs::create_directories(fs::path(cachePath).parent_path(), ec);
+
+        // Written aside and renamed so a reader never maps half a file.
+        const std::string tempPath = MakeTempPath(cachePath);
+        bool written = false;
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+                return false;
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            out.close();
+            written = !out.fail();
+        }
+
+        if (!written)
+        {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+
+        fs::rename(tempPath, cachePath, ec);
+        if (ec)
+        {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool MapCache(const std::string& cachePath, MappedFile& cache, XmlCache::Header& header)
+    {
+        if (!cache.Open(cachePath) || cache.GetSize() < sizeof(XmlCache::Header))
+        {
+            cache.Close();
+            return false;
+        }
+
+        std::memcpy(&header, cache.GetData(), sizeof(header));
+
+        if (header.magic != XmlCache::MAGIC || header.version != XmlCache::VERSION ||
+            header.eventBytes != cache.GetSize() - sizeof(header) ||
+            header.eventHash != XXHash64(cache.GetData() + sizeof(header), header.eventBytes))
+        {
+            cache.Close();
+            return false;
+        }
+        return true;
+    }
+
+    std::string_view GetEvents(const MappedFile& cache)
+    {
+        return cache.GetView().substr(sizeof(XmlCache::Header));
+    }
+
+    size_t Drain(XmlPullParser& parser)
+    {
+        size_t events = 0;
+        XmlEvent event;
+        while ((event = parser.Next()) != XmlEvent::EndDocument && event != XmlEvent::Error)
+            ++events;
+        return events;
+    }
+}
+
+namespace XmlCache
+{
+    struct ModeAccess
+    {
+        // The calling thread's scope if it has one, else the global setting.
+        static Mode Get(fs::path& directory)
+        {
+            if (t_scope)
+            {
+                directory = t_scope->m_directory;
+                return t_scope->m_mode;
+            }
+
+            Settings& settings = GetSettings();
+            std::lock_guard<std::mutex> lock(settings.mutex);
+            directory = settings.directory;
+            return settings.mode;
+        }
+    };
+
+    void SetMode(Mode mode, const std::string& directory)
+    {
+        fs::path folder;
+        if (mode == Mode::Directory && !PrepareDirectory(directory, folder))
+            mode = Mode::Off;
+
+        Settings& settings = GetSettings();
+        std::lock_guard<std::mutex> lock(settings.mutex);
+        settings.mode = mode;
+        settings.directory = folder;
+    }
+
+    Mode GetMode()
+    {
+        fs::path directory;
+        return ModeAccess::Get(directory);
+    }
+
+    std::string GetDirectory()
+    {
+        fs::path directory;
+        ModeAccess::Get(directory);
+        return directory.string();
+    }
+
+    ScopedMode::ScopedMode(Mode mode, const std::string& directory)
+        : m_outer(t_scope)
+        , m_mode(mode)
+    {
+        fs::path folder;
+        if (mode == Mode::Directory && !PrepareDirectory(directory, folder))
+            m_mode = Mode::Off;
+        m_directory = folder.string();
+
+        t_scope = this;
+    }
+
+    ScopedMode::~ScopedMode()
+    {
+        t_scope = m_outer;
+    }
+
+    std::string GetCachePath(const std::string& sourcePath)
+    {
+        fs::path directory;
+
+        switch (ModeAccess::Get(directory))
+        {
+        case Mode::Sidecar:
+            return sourcePath + ".gCache";
+
+        case Mode::Directory:
+        {
+            // Name plus a hash of the full path, so equal names in
+            // different folders get their own cache.
+            std::error_code ec;
+            const std::string full = fs::absolute(sourcePath, ec).lexically_normal().generic_string();
+
+            char hash[17];
+            std::snprintf(hash, sizeof(hash), "%016llx",
+                static_cast<unsigned long long>(XXHash64(full.data(), full.size())));
+
+            return (directory / (fs::path(sourcePath).filename().string() + "." + hash + ".gCache")).string();
+        }
+
+        default:
+            return {};
+        }
+    }
+
+    bool Open(const std::string& sourcePath, MappedFile& cache, std::string_view& events)
+    {
+        cache.Close();
+
+        const std::string cachePath = GetCachePath(sourcePath);
+        if (cachePath.empty())
+            return false;
+
+        std::error_code ec;
+        const uint64_t size = fs::file_size(sourcePath, ec);
+        const int64_t time = ec ? 0 : GetWriteTime(sourcePath, ec);
+        if (ec)
+            return false;
+
+        Header header;
+        if (MapCache(cachePath, cache, header) && header.sourceSize == size)
+        {
+            if (header.sourceTime == time)
+            {
+                events = GetEvents(cache);
+                return true;
+            }
+
+            // Touched but maybe not changed: the hash decides, and a match
+            // only needs the stored time updated.
+            MappedFile source;
+            if (source.Open(sourcePath) && XXHash64(source.GetData(), source.GetSize()) == header.sourceHash)
+            {
+                cache.Close();
+                header.sourceTime = time;
+                {
+                    std::fstream file(cachePath, std::ios::in | std::ios::out | std::ios::binary);
+                    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                }
+
+                if (MapCache(cachePath, cache, header))
+                {
+                    events = GetEvents(cache);
+                    return true;
+                }
+            }
+        }
+        cache.Close();
+
+        MappedFile source;
+        if (!source.Open(sourcePath))
+            return false;
+
+        std::vector<char> data(sizeof(Header));
+        if (!Encode(source.GetView(), data))
+            return false;
+
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.sourceSize = source.GetSize();
+        header.sourceTime = time;
+        header.sourceHash = XXHash64(source.GetData(), source.GetSize());
+        header.eventBytes = data.size() - sizeof(Header);
+        header.eventHash = XXHash64(data.data() + sizeof(Header), header.eventBytes);
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        if (!WriteCache(cachePath, data) || !MapCache(cachePath, cache, header))
+        {
+            std::cout << "[XmlCache] Could not write " << cachePath << "\n";
+            return false;
+        }
+
+        events = GetEvents(cache);
+        return true;
+    }
+
+    bool Encode(std::string_view text, std::vector<char>& out)
+    {
+        XmlPullParser parser;
+        parser.SetBuffer(text);
+
+        while (true)
+        {
+            switch (parser.Next())
+            {
+            case XmlEvent::StartElement:
+                out.push_back(static_cast<char>(RECORD_START));
+                PutString(out, parser.GetName());
+                break;
+
+            case XmlEvent::Attribute:
+                out.push_back(static_cast<char>(RECORD_ATTRIBUTE));
+                PutString(out, parser.GetName());
+                PutString(out, parser.GetValue());
+                break;
+
+            case XmlEvent::Text:
+                out.push_back(static_cast<char>(RECORD_TEXT));
+                PutString(out, parser.GetValue());
+                break;
+
+            case XmlEvent::EndElement:
+                out.push_back(static_cast<char>(RECORD_END));
+                break;
+
+            case XmlEvent::EndDocument:
+                out.push_back(static_cast<char>(RECORD_END_DOCUMENT));
+                return true;
+
+            default:
+                return false;
+            }
+        }
+    }
+
+    bool ReadRecord(std::string_view events, size_t& pos, Record& out)
+    {
+        if (pos >= events.size())
+            return false;
+
+        out.name = {};
+        out.value = {};
+
+        switch (static_cast<uint8_t>(events[pos++]))
+        {
+        case RECORD_START:
+            out.event = XmlEvent::StartElement;
+            return GetString(events, pos, out.name);
+
+        case RECORD_ATTRIBUTE:
+            out.event = XmlEvent::Attribute;
+            return GetString(events, pos, out.name) && GetString(events, pos, out.value);
+
+        case RECORD_TEXT:
+            out.event = XmlEvent::Text;
+            return GetString(events, pos, out.value);
+
+        case RECORD_END:
+            out.event = XmlEvent::EndElement;
+            return true;
+
+        case RECORD_END_DOCUMENT:
+            out.event = XmlEvent::EndDocument;
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    void RunBenchmark(uint32_t objectCount)
+    {
+        using Clock = std::chrono::steady_clock;
+        const int runs = 5;
+        const uint32_t perFolder = 50;
+
+        auto ms = [](Clock::time_point t0)
+            {
+                return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            };
+
+        const fs::path folder = fs::temp_directory_path() / "GVXmlCacheBench";
+        const std::string path = (folder / "Bench.gScene").string();
+
+        std::error_code ec;
+        fs::remove_all(folder, ec);
+        fs::create_directories(folder, ec);
+
+        {
+            char name[32];
+            char asset[64];
+
+            XmlWriter writer;
+            writer.Open(path);
+            writer.StartElement("Scene");
+            writer.StartElement("Folder");
+            writer.Attribute("name", "Root");
+
+            for (uint32_t first = 0; first < objectCount; first += perFolder)
+            {
+                writer.StartElement("Folder");
+                std::snprintf(name, sizeof(name), "Group%u", first / perFolder);
+                writer.Attribute("name", name);
+
+                for (uint32_t o = first; o < std::min(objectCount, first + perFolder); ++o)
+                {
+                    std::snprintf(name, sizeof(name), "Object_%u", o);
+                    std::snprintf(asset, sizeof(asset), "Objects/Props/Crate_%u.gObject", o);
+
+                    writer.StartElement("Object");
+                    writer.Attribute("name", name);
+                    writer.Attribute("asset", asset);
+                    writer.EndElement();
+                }
+
+                writer.EndElement();
+            }
+
+            writer.EndElement();
+            writer.EndElement();
+            writer.Close();
+        }
+
+        auto best = [&](double& outMs)
+            {
+                size_t events = 0;
+                outMs = 1e30;
+                for (int r = 0; r < runs; ++r)
+                {
+                    Clock::time_point t0 = Clock::now();
+                    XmlPullParser parser;
+                    parser.Open(path);
+                    events = Drain(parser);
+                    outMs = std::min(outMs, ms(t0));
+                }
+                return events;
+            };
+
+        // Scoped to this thread: an export may be loading scenes with the
+        // project's cache settings meanwhile.
+        double parseMs = 0.0;
+        size_t parseEvents = 0;
+        {
+            ScopedMode off(Mode::Off);
+            parseEvents = best(parseMs);
+        }
+
+        ScopedMode cached(Mode::Directory, (folder / "Cache").string());
+        const std::string cachePath = GetCachePath(path);
+
+        Clock::time_point t0 = Clock::now();
+        size_t coldEvents = 0;
+        {
+            XmlPullParser parser;
+            parser.Open(path);
+            coldEvents = Drain(parser);
+        }
+        const double coldMs = ms(t0);
+
+        double warmMs = 0.0;
+        const size_t warmEvents = best(warmMs);
+
+        const uintmax_t sourceBytes = fs::file_size(path, ec);
+        const uintmax_t cacheBytes = fs::file_size(cachePath, ec);
+
+        fs::remove_all(folder, ec);
+
+        std::cout << "[XmlCache] Benchmark: " << objectCount << " objects, " << sourceBytes / 1024
+            << " KB XML, " << cacheBytes / 1024 << " KB cache, best of " << runs << "\n";
+        std::cout << "[XmlCache]   Tokenize:            " << parseMs << " ms\n";
+        std::cout << "[XmlCache]   Build cache (cold):  " << coldMs << " ms\n";
+        std::cout << "[XmlCache]   Replay cache (warm): " << warmMs << " ms\n";
+
+        if (parseEvents != coldEvents || parseEvents != warmEvents)
+            std::cout << "[XmlCache]   Event counts differ: " << parseEvents << " / " << coldEvents
+                << " / " << warmEvents << "\n";
+    }
+}
@@ -0,0 +1,1032 @@
+#include "MiniXml/XmlDocument.h"
+#include "MiniXml/MiniXml.h"
+#include "MiniXml/XmlPullParser.h"
+#include "MiniXml/XmlScan.h"
+#include "GVFramework/Chunk/ChunkHash.h"
+#include "Platform/HeapCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+
+static_assert(std::is_trivially_destructible<XmlViewNode>::value, "arena nodes are never destroyed");
+static_assert(std::is_trivially_destructible<XmlViewAttribute>::value, "arena nodes are never destroyed");
+
+namespace
+{
+    std::string_view Trim(std::string_view text)
+    {
+        size_t start = 0;
+        size_t end = text.size();
+        while (start < end && XmlScan::IsSpace(text[start]))
+            ++start;
+        while (end > start && XmlScan::IsSpace(text[end - 1]))
+            --end;
+        return text.substr(start, end - start);
+    }
+
+    // XmlParseString's rule: text before the first child wins, but text
+    // right before the end tag replaces it.
+    void AddText(XmlViewNode& node, std::string_view segment, bool beforeEndTag)
+    {
+        if (!segment.empty() && (beforeEndTag || node.text.empty()))
+            node.text = segment;
+    }
+
+    // What a range does to the elements that were already open where it
+    // starts: add a child or text to the innermost one, or end it.
+    struct RangeOp
+    {
+        enum Kind : uint8_t
+        {
+            Child,
+            Text,
+            EndTag
+        };
+
+        Kind kind = Child;
+        bool beforeEndTag = false;   // Text: an end tag follows
+        XmlViewNode* node = nullptr; // Child
+        std::string_view text;       // Text: the segment, EndTag: the name
+    };
+
+    struct OpenElement
+    {
+        XmlViewNode* node = nullptr;
+        XmlViewNode* lastChild = nullptr;
+    };
+
+    // One range parsed on its own. Its nodes stay in its arena, named in its
+    // atom table, until the document joins the ranges.
+    struct RangeResult
+    {
+        XmlArena arena;
+        XmlAtomTable atoms;
+        std::vector<RangeOp> ops;
+        std::vector<OpenElement> open; // started here and not ended; open[0] is the last Child op
+        bool ok = false;
+    };
+
+    class ViewParser
+    {
+    public:
+        ViewParser(std::string_view text, XmlArena& arena, XmlAtomTable& atoms)
+            : m_text(text)
+            , m_arena(arena)
+            , m_atoms(atoms)
+        {
+        }
+
+        XmlViewNode* ParseDocument()
+        {
+            SkipWhitespace();
+            if (m_pos >= m_text.size())
+                return nullptr;
+            return ParseNode();
+        }
+
+        // Parses [begin, end) without knowing which elements are open at
+        // begin, which must be outside any tag. False on a parse error or if
+        // a token runs past end, i.e. end was not outside one either.
+        bool ParseRange(size_t begin, size_t end, std::vector<RangeOp>& ops, std::vector<OpenElement>& open)
+        {
+            m_pos = begin;
+            size_t textStart = m_pos;
+
+            while (true)
+            {
+                size_t lt = m_pos + XmlScan::FindChar(m_text.data() + m_pos, end - m_pos, '<');
+                std::string_view segment = Trim(m_text.substr(textStart, lt - textStart));
+                m_pos = lt;
+
+                const bool endTag = StartsWith("</");
+                if (!open.empty())
+                    AddText(*open.back().node, segment, endTag);
+                else if (!segment.empty())
+                    ops.push_back({ RangeOp::Text, endTag, nullptr, segment });
+
+                if (m_pos >= end)
+                    return true;
+
+                if (endTag)
+                {
+                    std::string_view name;
+                    if (!ParseEndTag(name))
+                        return false;
+
+                    if (open.empty())
+                    {
+                        ops.push_back({ RangeOp::EndTag, false, nullptr, name });
+                    }
+                    else
+                    {
+                        if (name != open.back().node->name)
+                            return false;
+                        open.pop_back();
+                    }
+                }
+                else if (StartsWith("<!--"))
+                {
+                    if (!SkipPast("-->"))
+                        return false;
+                }
+                else if (StartsWith("<?"))
+                {
+                    if (!SkipPast("?>"))
+                        return false;
+                }
+                else
+                {
+                    bool selfClosed = false;
+                    XmlViewNode* node = ParseStartTag(selfClosed);
+                    if (!node)
+                        return false;
+
+                    if (open.empty())
+                    {
+                        ops.push_back({ RangeOp::Child, false, node, {} });
+                    }
+                    else
+                    {
+                        OpenElement& parent = open.back();
+                        if (parent.lastChild)
+                            parent.lastChild->nextSibling = node;
+                        else
+                            parent.node->firstChild = node;
+                        parent.lastChild = node;
+                    }
+
+                    if (!selfClosed)
+                        open.push_back({ node, nullptr });
+                }
+
+                if (m_pos > end)
+                    return false;
+                textStart = m_pos;
+            }
+        }
+
+    private:
+        void SkipWhitespace()
+        {
+            m_pos += XmlScan::SkipSpace(m_text.data() + m_pos, m_text.size() - m_pos);
+        }
+
+        bool StartsWith(std::string_view lit) const
+        {
+            return m_text.compare(m_pos, lit.size(), lit) == 0;
+        }
+
+        std::string_view ReadName()
+        {
+            size_t start = m_pos;
+            m_pos += XmlScan::SkipName(m_text.data() + m_pos, m_text.size() - m_pos);
+            return m_text.substr(start, m_pos - start);
+        }
+
+        bool ReadQuoted(std::string_view& out)
+        {
+            if (m_pos >= m_text.size())
+                return false;
+            char quote = m_text[m_pos];
+            if (quote != '"' && quote != '\'')
+                return false;
+            ++m_pos;
+            size_t end = m_pos + XmlScan::FindChar(m_text.data() + m_pos, m_text.size() - m_pos, quote);
+            if (end == m_text.size())
+                return false;
+            out = m_text.substr(m_pos, end - m_pos);
+            m_pos = end + 1;
+            return true;
+        }
+
+        bool SkipPast(std::string_view terminator)
+        {
+            size_t end = m_text.find(terminator, m_pos);
+            if (end == std::string_view::npos)
+                return false;
+            m_pos = end + terminator.size();
+            return true;
+        }
+
+        bool ParseAttributes(XmlViewNode& node)
+        {
+            XmlViewAttribute* last = nullptr;
+
+            while (true)
+            {
+                SkipWhitespace();
+                if (m_pos >= m_text.size())
+                    return false;
+                if (m_text[m_pos] == '/' || m_text[m_pos] == '>')
+                    return true;
+
+                XmlViewAttribute* attr = m_arena.New<XmlViewAttribute>();
+                attr->name = ReadName();
+                if (attr->name.empty())
+                    return false;
+                attr->atom = m_atoms.Intern(attr->name);
+
+                SkipWhitespace();
+                if (m_pos >= m_text.size() || m_text[m_pos] != '=')
+                    return false;
+                ++m_pos;
+                SkipWhitespace();
+
+                if (!ReadQuoted(attr->value))
+                    return false;
+
+                if (last)
+                    last->next = attr;
+                else
+                    node.firstAttribute = attr;
+                last = attr;
+            }
+        }
+
+        XmlViewNode* ParseNode()
+        {
+            // Declarations and comments before the element are skipped.
+            while (true)
+            {
+                if (m_pos >= m_text.size() || m_text[m_pos] != '<')
+                    return nullptr;
+
+                if (StartsWith("<?"))
+                {
+                    if (!SkipPast("?>"))
+                        return nullptr;
+                }
+                else if (StartsWith("<!--"))
+                {
+                    if (!SkipPast("-->"))
+                        return nullptr;
+                }
+                else
+                {
+                    break;
+                }
+
+                SkipWhitespace();
+            }
+
+            bool selfClosed = false;
+            XmlViewNode* node = ParseStartTag(selfClosed);
+            if (!node || selfClosed)
+                return node;
+            return ParseInner(*node) ? node : nullptr;
+        }
+
+        // From '<' through '>' or "/>".
+        XmlViewNode* ParseStartTag(bool& selfClosed)
+        {
+            ++m_pos;
+            if (m_pos < m_text.size() && m_text[m_pos] == '/')
+                return nullptr;
+
+            XmlViewNode* node = m_arena.New<XmlViewNode>();
+            node->name = ReadName();
+            if (node->name.empty())
+                return nullptr;
+            node->atom = m_atoms.Intern(node->name);
+
+            if (!ParseAttributes(*node))
+                return nullptr;
+
+            selfClosed = m_text[m_pos] == '/';
+            if (selfClosed)
+            {
+                ++m_pos;
+                if (m_pos >= m_text.size() || m_text[m_pos] != '>')
+                    return nullptr;
+            }
+
+            ++m_pos;
+            return node;
+        }
+
+        // From "</" through '>'.
+        bool ParseEndTag(std::string_view& name)
+        {
+            m_pos += 2;
+            name = ReadName();
+            SkipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != '>')
+                return false;
+            ++m_pos;
+            return true;
+        }
+
+        bool ParseInner(XmlViewNode& node)
+        {
+            XmlViewNode* lastChild = nullptr;
+            size_t textStart = m_pos;
+
+            while (m_pos < m_text.size())
+            {
+                size_t open = m_pos + XmlScan::FindChar(m_text.data() + m_pos, m_text.size() - m_pos, '<');
+                if (open == m_text.size())
+                    return false;
+
+                m_pos = open;
+                std::string_view segment = Trim(m_text.substr(textStart, m_pos - textStart));
+
+                if (StartsWith("</"))
+                {
+                    std::string_view closeName;
+                    if (!ParseEndTag(closeName) || closeName != node.name)
+                        return false;
+                    AddText(node, segment, true);
+                    return true;
+                }
+
+                AddText(node, segment, false);
+
+                if (StartsWith("<!--"))
+                {
+                    if (!SkipPast("-->"))
+                        return false;
+                }
+                else if (StartsWith("<?"))
+                {
+                    if (!SkipPast("?>"))
+                        return false;
+                }
+                else
+                {
+                    XmlViewNode* child = ParseNode();
+                    if (!child)
+                        return false;
+
+                    if (lastChild)
+                        lastChild->nextSibling = child;
+                    else
+                        node.firstChild = child;
+                    lastChild = child;
+                }
+
+                textStart = m_pos;
+            }
+
+            return false;
+        }
+
+    private:
+        std::string_view m_text;
+        size_t m_pos = 0;
+        XmlArena& m_arena;
+        XmlAtomTable& m_atoms;
+    };
+
+    // Ranges end before a '<' that follows a '>'. Text never holds a '<',
+    // so a wrong pick can only be inside a comment or a quoted value, and
+    // the range before it then fails instead of returning a wrong tree.
+    size_t FindSplit(std::string_view text, size_t from)
+    {
+        while (from < text.size())
+        {
+            size_t lt = from + XmlScan::FindChar(text.data() + from, text.size() - from, '<');
+            if (lt == text.size())
+                break;
+
+            size_t before = lt;
+            while (before > 0 && XmlScan::IsSpace(text[before - 1]))
+                --before;
+            if (before > 0 && text[before - 1] == '>')
+                return lt;
+
+            from = lt + 1;
+        }
+        return text.size();
+    }
+
+    template <typename Fn>
+    void RunOnThreads(size_t count, uint32_t threads, Fn fn)
+    {
+        std::atomic<size_t> next{ 0 };
+
+        auto worker = [&]()
+            {
+                for (size_t i = next++; i < count; i = next++)
+                    fn(i);
+            };
+
+        threads = std::min<uint32_t>(threads, static_cast<uint32_t>(count));
+
+        std::vector<std::thread> pool;
+        for (uint32_t t = 1; t < threads; ++t)
+            pool.emplace_back(worker);
+        worker();
+
+        for (std::thread& thread : pool)
+            thread.join();
+    }
+
+    // Before the join a range's Child ops reach exactly its own nodes. They
+    // are mutable, only the view API is const.
+    void RemapAtoms(XmlViewNode* node, const std::vector<XmlAtom>& remap)
+    {
+        node->atom = remap[node->atom];
+        for (const XmlViewAttribute* a = node->firstAttribute; a; a = a->next)
+            const_cast<XmlViewAttribute*>(a)->atom = remap[a->atom];
+        for (const XmlViewNode* c = node->firstChild; c; c = c->nextSibling)
+            RemapAtoms(const_cast<XmlViewNode*>(c), remap);
+    }
+
+    // Null when the ranges do not join into a document; the caller then
+    // parses serially. arena and atoms may be partly filled by then.
+    const XmlViewNode* ParseParallel(std::string_view text, uint32_t threads, XmlArena& arena,
+        XmlAtomTable& atoms, uint32_t& rangeCount)
+    {
+        // A few ranges per thread even out dense and sparse parts of the text.
+        const size_t wanted = std::min<size_t>(threads * 4, text.size() / (1024 * 1024));
+
+        std::vector<size_t> splits{ 0 };
+        for (size_t i = 1; i < wanted; ++i)
+        {
+            size_t split = FindSplit(text, std::max(splits.back() + 1, text.size() * i / wanted));
+            if (split == text.size())
+                break;
+            splits.push_back(split);
+        }
+        splits.push_back(text.size());
+
+        const size_t ranges = splits.size() - 1;
+        if (ranges < 2)
+            return nullptr;
+
+        std::vector<std::unique_ptr<RangeResult>> results(ranges);
+        RunOnThreads(ranges, threads, [&](size_t i)
+            {
+                auto result = std::make_unique<RangeResult>();
+                ViewParser parser(text, result->arena, result->atoms);
+                result->ok = parser.ParseRange(splits[i], splits[i + 1], result->ops, result->open);
+                results[i] = std::move(result);
+            });
+
+        for (const std::unique_ptr<RangeResult>& result : results)
+            if (!result->ok)
+                return nullptr;
+
+        // Interning each range's new names in range order hands out the
+        // atoms a serial parse would.
+        std::vector<std::vector<XmlAtom>> remaps(ranges);
+        for (size_t i = 0; i < ranges; ++i)
+        {
+            const XmlAtomTable& local = results[i]->atoms;
+            std::vector<XmlAtom>& remap = remaps[i];
+
+            bool identity = true;
+            remap.resize(local.GetCount() + 1);
+            for (XmlAtom a = 0; a < remap.size(); ++a)
+            {
+                remap[a] = a < ATOM_SCHEMA_COUNT ? a : atoms.Intern(local.GetName(a));
+                identity = identity && remap[a] == a;
+            }
+
+            if (identity)
+                remap.clear();
+        }
+
+        RunOnThreads(ranges, threads, [&](size_t i)
+            {
+                if (remaps[i].empty())
+                    return;
+                for (const RangeOp& op : results[i]->ops)
+                    if (op.kind == RangeOp::Child)
+                        RemapAtoms(op.node, remaps[i]);
+            });
+
+        // Replay every range's ops on the stack of open elements.
+        std::vector<OpenElement> stack;
+        XmlViewNode* root = nullptr;
+
+        for (const std::unique_ptr<RangeResult>& result : results)
+        {
+            for (const RangeOp& op : result->ops)
+            {
+                // Anything after the root is ignored, as in a serial parse.
+                if (root && stack.empty())
+                    break;
+
+                switch (op.kind)
+                {
+                case RangeOp::Child:
+                    if (stack.empty())
+                    {
+                        root = op.node;
+                    }
+                    else
+                    {
+                        OpenElement& parent = stack.back();
+                        if (parent.lastChild)
+                            parent.lastChild->nextSibling = op.node;
+                        else
+                            parent.node->firstChild = op.node;
+                        parent.lastChild = op.node;
+                    }
+
+                    if (!result->open.empty() && result->open.front().node == op.node)
+                        stack.insert(stack.end(), result->open.begin(), result->open.end());
+                    break;
+
+                case RangeOp::Text:
+                    if (stack.empty())
+                        return nullptr; // text before the root
+                    AddText(*stack.back().node, op.text, op.beforeEndTag);
+                    break;
+
+                case RangeOp::EndTag:
+                    if (stack.empty() || stack.back().node->name != op.text)
+                        return nullptr;
+                    stack.pop_back();
+                    break;
+                }
+            }
+
+            arena.Absorb(result->arena);
+        }
+
+        if (!root || !stack.empty())
+            return nullptr;
+
+        rangeCount = static_cast<uint32_t>(ranges);
+        return root;
+    }
+
+    void HashView(XXHash64Stream& hash, std::string_view view)
+    {
+        const uint64_t size = view.size();
+        hash.Update(&size, sizeof(size));
+        if (!view.empty())
+            hash.Update(view.data(), view.size());
+    }
+
+    // Everything a caller can see of the tree, in document order.
+    void HashTree(XXHash64Stream& hash, const XmlViewNode* node)
+    {
+        for (; node; node = node->nextSibling)
+        {
+            HashView(hash, node->name);
+            HashView(hash, node->text);
+            hash.Update(&node->atom, sizeof(node->atom));
+
+            for (const XmlViewAttribute* a = node->firstAttribute; a; a = a->next)
+            {
+                HashView(hash, a->name);
+                HashView(hash, a->value);
+                hash.Update(&a->atom, sizeof(a->atom));
+            }
+
+            hash.Update("{", 1);
+            HashTree(hash, node->firstChild);
+            hash.Update("}", 1);
+        }
+    }
+
+    std::string BuildBenchmarkScene(uint32_t objectCount)
+    {
+        const uint32_t perFolder = 50;
+
+        std::string text = "<?xml version=\"1.0\"?>\n<Scene>\n  <Folder name=\"Root\">\n";
+
+        for (uint32_t first = 0; first < objectCount; first += perFolder)
+        {
+            std::string group = std::to_string(first / perFolder);
+            text += "    <Folder name=\"Group" + group + "\">\n";
+            text += "      <Folder name=\"Props" + group + "\">\n";
+
+            for (uint32_t o = first; o < std::min(objectCount, first + perFolder); ++o)
+            {
+                std::string id = std::to_string(o);
+                text += "        <Object name=\"Object_" + id +
+                    "\" asset=\"Objects/Props/Crate_" + id + ".gObject\"/>\n";
+            }
+
+            text += "      </Folder>\n    </Folder>\n";
+        }
+
+        text += "  </Folder>\n</Scene>\n";
+        return text;
+    }
+
+    // Heap blocks an XmlNode tree still holds once parsing is done.
+    size_t CountHeapBlocks(const XmlNode& node)
+    {
+        const size_t sso = std::string().capacity();
+
+        size_t blocks = 0;
+        blocks += node.name.capacity() > sso ? 1 : 0;
+        blocks += node.text.capacity() > sso ? 1 : 0;
+        blocks += node.attributes.capacity() > 0 ? 1 : 0;
+        blocks += node.children.capacity() > 0 ? 1 : 0;
+
+        for (const XmlAttribute& a : node.attributes)
+        {
+            blocks += a.name.capacity() > sso ? 1 : 0;
+            blocks += a.value.capacity() > sso ? 1 : 0;
+        }
+
+        for (const XmlNode& child : node.children)
+            blocks += CountHeapBlocks(child);
+
+        return blocks;
+    }
+
+    size_t CountNodes(const XmlViewNode* node)
+    {
+        size_t count = 0;
+        for (; node; node = node->nextSibling)
+            count += 1 + CountNodes(node->firstChild);
+        return count;
+    }
+}
+
+XmlArena::XmlArena(size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+void* XmlArena::Allocate(size_t size, size_t align)
+{
+    size_t offset = (m_blockUsed + align - 1) & ~(align - 1);
+
+    if (m_blocks.empty() || offset + size > m_blockSize)
+    {
+        // new[] storage is aligned for any fundamental type.
+        m_blocks.push_back(std::make_unique<char[]>(std::max(m_blockSize, size)));
+        offset = 0;
+    }
+
+    m_blockUsed = offset + size;
+    m_usedBytes += size;
+    return m_blocks.back().get() + offset;
+}
+
+void XmlArena::Reset()
+{
+    m_blocks.clear();
+    m_blockUsed = 0;
+    m_usedBytes = 0;
+}
+
+void XmlArena::Absorb(XmlArena& other)
+{
+    // In front, so the block being filled stays last.
+    m_blocks.insert(m_blocks.begin(), std::make_move_iterator(other.m_blocks.begin()),
+        std::make_move_iterator(other.m_blocks.end()));
+    m_usedBytes += other.m_usedBytes;
+    other.Reset();
+}
+
+size_t XmlArena::GetUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+uint32_t XmlArena::GetBlockCount() const
+{
+    return static_cast<uint32_t>(m_blocks.size());
+}
+
+const XmlViewAttribute* XmlViewNode::FindAttribute(std::string_view attrName) const
+{
+    for (const XmlViewAttribute* a = firstAttribute; a; a = a->next)
+        if (a->name == attrName)
+            return a;
+    return nullptr;
+}
+
+std::string_view XmlViewNode::GetAttribute(std::string_view attrName, std::string_view fallback) const
+{
+    const XmlViewAttribute* a = FindAttribute(attrName);
+    return a ? a->value : fallback;
+}
+
+const XmlViewNode* XmlViewNode::FindChild(std::string_view childName) const
+{
+    for (const XmlViewNode* c = firstChild; c; c = c->nextSibling)
+        if (c->name == childName)
+            return c;
+    return nullptr;
+}
+
+const XmlViewNode* XmlViewNode::NextNamed(std::string_view siblingName) const
+{
+    for (const XmlViewNode* c = nextSibling; c; c = c->nextSibling)
+        if (c->name == siblingName)
+            return c;
+    return nullptr;
+}
+
+const XmlViewAttribute* XmlViewNode::FindAttribute(XmlAtom attrAtom) const
+{
+    for (const XmlViewAttribute* a = firstAttribute; a; a = a->next)
+        if (a->atom == attrAtom)
+            return a;
+    return nullptr;
+}
+
+std::string_view XmlViewNode::GetAttribute(XmlAtom attrAtom, std::string_view fallback) const
+{
+    const XmlViewAttribute* a = FindAttribute(attrAtom);
+    return a ? a->value : fallback;
+}
+
+const XmlViewNode* XmlViewNode::FindChild(XmlAtom childAtom) const
+{
+    for (const XmlViewNode* c = firstChild; c; c = c->nextSibling)
+        if (c->atom == childAtom)
+            return c;
+    return nullptr;
+}
+
+const XmlViewNode* XmlViewNode::NextNamed(XmlAtom siblingAtom) const
+{
+    for (const XmlViewNode* c = nextSibling; c; c = c->nextSibling)
+        if (c->atom == siblingAtom)
+            return c;
+    return nullptr;
+}
+
+bool XmlDocument::LoadFromFile(const std::string& path)
+{
+    m_arena.Reset();
+    m_atoms.Reset();
+    m_buffer.clear();
+    m_root = nullptr;
+
+    // Views point straight into the mapping, which lives as long as the
+    // document does.
+    if (!m_file.Open(path))
+        return false;
+
+    return ParseText(m_file.GetView());
+}
+
+bool XmlDocument::Parse(std::string text)
+{
+    m_arena.Reset();
+    m_atoms.Reset();
+    m_file.Close();
+    m_buffer = std::move(text);
+
+    return ParseText(m_buffer);
+}
+
+bool XmlDocument::ParseText(std::string_view text)
+{
+    const uint32_t threads = m_threads ? m_threads : std::max(1u, std::thread::hardware_concurrency());
+    m_ranges = 1;
+
+    if (threads > 1 && text.size() >= PARALLEL_MIN_BYTES)
+    {
+        uint32_t ranges = 0;
+        m_root = ParseParallel(text, threads, m_arena, m_atoms, ranges);
+        if (m_root)
+        {
+            m_ranges = ranges;
+            return true;
+        }
+
+        m_arena.Reset();
+        m_atoms.Reset();
+    }
+
+    ViewParser parser(text, m_arena, m_atoms);
+    m_root = parser.ParseDocument();
+    return m_root != nullptr;
+}
+
+void XmlDocument::SetThreadCount(uint32_t threads)
+{
+    m_threads = threads;
+}
+
+const XmlViewNode* XmlDocument::GetRoot() const
+{
+    return m_root;
+}
+
+const XmlArena& XmlDocument::GetArena() const
+{
+    return m_arena;
+}
+
+const XmlAtomTable& XmlDocument::GetAtoms() const
+{
+    return m_atoms;
+}
+
+uint32_t XmlDocument::GetRangeCount() const
+{
+    return m_ranges;
+}
+
+void XmlDocument::RunBenchmark(uint32_t objectCount)
+{
+    using Clock = std::chrono::steady_clock;
+    const int runs = 5;
+
+    const std::string text = BuildBenchmarkScene(objectCount);
+
+    double domMs = 1e30;
+    size_t domBlocks = 0;
+    uint64_t domAllocs = 0;
+    uint64_t domBytes = 0;
+    bool domOk = true;
+
+    for (int r = 0; r < runs; ++r)
+    {
+        XmlNode root;
+        HeapCounter heap;
+        Clock::time_point t0 = Clock::now();
+        domOk = XmlParseString(text, root) && domOk;
+        domMs = std::min(domMs, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        domAllocs = heap.GetAllocations();
+        domBytes = heap.GetBytes();
+        domBlocks = CountHeapBlocks(root);
+    }
+
+    double viewMs = 1e30;
+    size_t viewBlocks = 0;
+    uint64_t viewAllocs = 0;
+    uint64_t viewBytes = 0;
+    size_t viewNodes = 0;
+    size_t arenaBytes = 0;
+    bool viewOk = true;
+
+    for (int r = 0; r < runs; ++r)
+    {
+        XmlDocument doc;
+        doc.SetThreadCount(1);
+        std::string copy = text;
+
+        // The copy stands in for the file read and is neither timed nor
+        // counted for either parser.
+        HeapCounter heap;
+        Clock::time_point t0 = Clock::now();
+        viewOk = doc.Parse(std::move(copy)) && viewOk;
+        viewMs = std::min(viewMs, std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+        viewAllocs = heap.GetAllocations();
+        viewBytes = heap.GetBytes();
+
+        viewBlocks = doc.GetArena().GetBlockCount() + 1; // arena blocks plus the text buffer
+        viewNodes = CountNodes(doc.GetRoot());
+        arenaBytes = doc.GetArena().GetUsedBytes();
+    }
+
+    auto allocations = [](uint64_t count, uint64_t bytes)
+        {
+            if (!HeapCounter::IsEnabled())
+                return std::string("allocations not counted");
+            return std::to_string(count) + " allocations (" + std::to_string(bytes / 1024) + " KB)";
+        };
+
+    std::cout << "[Xml] Benchmark: " << objectCount << " objects, " << text.size() / 1024 << " KB, "
+        << viewNodes << " elements, best of " << runs << "\n";
+    std::cout << "[Xml]   XmlParseString: " << domMs << " ms, " << allocations(domAllocs, domBytes)
+        << " while parsing, " << domBlocks << " heap blocks held"
+        << (domOk ? "" : " (FAILED)") << "\n";
+    std::cout << "[Xml]   XmlDocument:    " << viewMs << " ms, " << allocations(viewAllocs, viewBytes)
+        << " while parsing, " << viewBlocks << " heap blocks held, "
+        << arenaBytes / 1024 << " KB arena" << (viewOk ? "" : " (FAILED)") << "\n";
+
+    if (!HeapCounter::IsEnabled())
+        std::cout << "[Xml]   (define GV_HEAP_COUNTER to count allocations)\n";
+}
+
+void XmlDocument::RunThroughputBenchmark(size_t megabytes)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // About 80 bytes of text per object.
+    const uint32_t objects = static_cast<uint32_t>(megabytes * 1024 * 1024 / 80);
+    const std::string text = BuildBenchmarkScene(objects);
+    const double mb = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+    auto rate = [mb](Clock::time_point t0)
+        {
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            return ms > 0.0 ? mb * 1000.0 / ms : 0.0;
+        };
+
+    std::cout << "[Xml] Throughput: " << static_cast<uint32_t>(mb) << " MB scene, "
+        << objects << " objects\n";
+
+    const XmlScan::Level best = XmlScan::GetBestLevel();
+
+    for (int l = 0; l <= static_cast<int>(best); ++l)
+    {
+        XmlScan::Level level = static_cast<XmlScan::Level>(l);
+        XmlScan::SetLevel(level);
+
+        double domRate = 0.0;
+        {
+            XmlNode root;
+            Clock::time_point t0 = Clock::now();
+            bool ok = XmlParseString(text, root);
+            domRate = ok ? rate(t0) : 0.0;
+        }
+
+        double docRate = 0.0;
+        {
+            XmlDocument doc;
+            doc.SetThreadCount(1);
+            std::string copy = text;
+            Clock::time_point t0 = Clock::now();
+            bool ok = doc.Parse(std::move(copy));
+            docRate = ok ? rate(t0) : 0.0;
+        }
+
+        double pullRate = 0.0;
+        {
+            XmlPullParser pull;
+            pull.SetBuffer(text);
+
+            Clock::time_point t0 = Clock::now();
+            XmlEvent event;
+            while ((event = pull.Next()) != XmlEvent::EndDocument && event != XmlEvent::Error)
+            {
+            }
+            pullRate = event == XmlEvent::EndDocument ? rate(t0) : 0.0;
+        }
+
+        std::cout << std::fixed << std::setprecision(0)
+            << "[Xml]   " << std::setw(6) << std::left << XmlScan::GetLevelName(level) << std::right
+            << " XmlParseString " << std::setw(5) << domRate << " MB/s, XmlDocument "
+            << std::setw(5) << docRate << " MB/s, XmlPullParser " << std::setw(5) << pullRate << " MB/s\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    XmlScan::SetLevel(best);
+}
+
+void XmlDocument::RunParallelBenchmark(size_t megabytes)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // About 80 bytes of text per object.
+    const uint32_t objects = static_cast<uint32_t>(megabytes * 1024 * 1024 / 80);
+    const std::string text = BuildBenchmarkScene(objects);
+    const double mb = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+    const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "[Xml] Parallel parse: " << static_cast<uint32_t>(mb) << " MB scene, "
+        << objects << " objects, " << hardware << " hardware threads\n";
+
+    // Only a hash of the serial tree is kept, so one tree is alive at a time.
+    auto parse = [&](uint32_t threads, double& ms, uint32_t& ranges, uint64_t& hash)
+        {
+            XmlDocument doc;
+            doc.SetThreadCount(threads);
+            std::string copy = text;
+
+            Clock::time_point t0 = Clock::now();
+            bool ok = doc.Parse(std::move(copy));
+            ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+            XXHash64Stream stream;
+            HashTree(stream, doc.GetRoot());
+            hash = stream.Digest();
+            ranges = doc.GetRangeCount();
+            return ok;
+        };
+
+    double serialMs = 0.0;
+    uint32_t ranges = 0;
+    uint64_t serialHash = 0;
+    if (!parse(1, serialMs, ranges, serialHash))
+    {
+        std::cout << "[Xml]   Serial parse FAILED\n";
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(0)
+        << "[Xml]    1 thread:  " << std::setw(6) << serialMs << " ms, "
+        << std::setw(5) << mb * 1000.0 / serialMs << " MB/s\n";
+
+    const uint32_t most = std::max(2u, hardware);
+    for (uint32_t threads = 2; ; threads = std::min(threads * 2, most))
+    {
+        double ms = 0.0;
+        uint64_t hash = 0;
+        bool ok = parse(threads, ms, ranges, hash);
+
+        std::cout << std::setprecision(0)
+            << "[Xml]   " << std::setw(2) << threads << " threads: "
+            << std::setw(6) << ms << " ms, " << std::setw(5) << mb * 1000.0 / ms << " MB/s, "
+            << std::setprecision(2) << serialMs / ms << "x, " << ranges << " ranges, "
+            << (!ok ? "FAILED" : hash == serialHash ? "same tree" : "DIFFERENT TREE") << "\n";
+
+        if (threads == most)
+            break;
+    }
+
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
@@ -0,0 +1,122 @@
+#include "MiniXml/XmlNumber.h"
+#include "MiniXml/XmlScan.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* SkipLead(std::string_view text)
+    {
+        const char* p = text.data();
+        const char* end = p + text.size();
+
+        p += XmlScan::SkipSpace(p, text.size());
+        if (p < end && *p == '+')
+            ++p;
+        return p;
+    }
+
+    uint32_t FloatBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+namespace XmlNumber
+{
+    std::string_view Format(float value, char* buffer)
+    {
+        std::to_chars_result result = std::to_chars(buffer, buffer + MAX_CHARS, value);
+        return std::string_view(buffer, static_cast<size_t>(result.ptr - buffer));
+    }
+
+    std::string_view Format(int value, char* buffer)
+    {
+        std::to_chars_result result = std::to_chars(buffer, buffer + MAX_CHARS, value);
+        return std::string_view(buffer, static_cast<size_t>(result.ptr - buffer));
+    }
+
+    float ParseFloat(std::string_view text, float fallback)
+    {
+        float value = fallback;
+        std::from_chars_result result = std::from_chars(SkipLead(text), text.data() + text.size(), value);
+        return result.ec == std::errc() ? value : fallback;
+    }
+
+    int ParseInt(std::string_view text, int fallback)
+    {
+        int value = fallback;
+        std::from_chars_result result = std::from_chars(SkipLead(text), text.data() + text.size(), value);
+        return result.ec == std::errc() ? value : fallback;
+    }
+
+    void RunBenchmark(uint32_t count)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        auto ms = [](Clock::time_point t0)
+            {
+                return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            };
+
+        // Half transform-like values, half any finite bit pattern.
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+        std::vector<float> values(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (i & 1)
+            {
+                uint32_t bits = rng();
+                if ((bits & 0x7F800000u) == 0x7F800000u)
+                    bits &= ~0x00800000u; // no inf or nan
+                std::memcpy(&values[i], &bits, sizeof(bits));
+            }
+            else
+            {
+                values[i] = position(rng);
+            }
+        }
+
+        Clock::time_point t0 = Clock::now();
+        uint32_t oldLost = 0;
+        size_t oldChars = 0;
+        for (float value : values)
+        {
+            std::string text = std::to_string(value);
+            float back = std::strtof(text.c_str(), nullptr);
+            oldChars += text.size();
+            oldLost += FloatBits(back) != FloatBits(value);
+        }
+        const double oldMs = ms(t0);
+
+        t0 = Clock::now();
+        uint32_t newLost = 0;
+        size_t newChars = 0;
+        char buffer[MAX_CHARS];
+        for (float value : values)
+        {
+            std::string_view text = Format(value, buffer);
+            float back = ParseFloat(text);
+            newChars += text.size();
+            newLost += FloatBits(back) != FloatBits(value);
+        }
+        const double newMs = ms(t0);
+
+        std::cout << "[Xml] Number benchmark: " << count << " floats, format + parse\n";
+        std::cout << "[Xml]   to_string + strtof: " << oldMs << " ms, " << oldChars / 1024 << " KB text, "
+            << oldLost << " values changed\n";
+        std::cout << "[Xml]   XmlNumber:          " << newMs << " ms, " << newChars / 1024 << " KB text, "
+            << newLost << " values changed\n";
+    }
+}
@@ -0,0 +1,443 @@
+#include "MiniXml/XmlPullParser.h"
+#include "MiniXml/XmlCache.h"
+#include "MiniXml/XmlScan.h"
+
+#include <algorithm>
+#include <cstring>
+
+XmlPullParser::XmlPullParser(size_t windowSize)
+    : m_windowSize(std::max<size_t>(windowSize, 64))
+{
+}
+
+void XmlPullParser::Reset()
+{
+    m_window.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_pos = 0;
+
+    m_cached = false;
+    m_inTag = false;
+    m_sawRoot = false;
+    m_depth = 0;
+    m_nameIsEnd = false;
+    m_atom = ATOM_NONE;
+    m_atoms.Reset();
+
+    m_nameBegin = m_nameEnd = 0;
+    m_valueBegin = m_valueEnd = 0;
+
+    m_error.clear();
+}
+
+bool XmlPullParser::Open(const std::string& path)
+{
+    if (m_file.is_open())
+        m_file.close();
+    m_file.clear();
+
+    Reset();
+
+    std::string_view events;
+    if (XmlCache::Open(path, m_mapping, events))
+    {
+        m_streaming = false;
+        m_eof = true;
+        m_cached = true;
+        m_data = events.data();
+        m_size = events.size();
+        return true;
+    }
+
+    // A mapped file is parsed like a buffer. If the OS would not map it,
+    // stream it through the window rather than read it all at once.
+    if (m_mapping.Open(path))
+    {
+        if (m_mapping.IsMapped())
+        {
+            m_streaming = false;
+            m_eof = true;
+            m_data = m_mapping.GetData();
+            m_size = m_mapping.GetSize();
+            return true;
+        }
+        m_mapping.Close();
+    }
+
+    m_file.open(path, std::ios::binary);
+    m_streaming = true;
+    m_eof = !m_file.is_open();
+    return m_file.is_open();
+}
+
+void XmlPullParser::SetBuffer(std::string_view text)
+{
+    if (m_file.is_open())
+        m_file.close();
+    m_mapping.Close();
+
+    Reset();
+
+    m_streaming = false;
+    m_eof = true;
+    m_data = text.data();
+    m_size = text.size();
+}
+
+XmlEvent XmlPullParser::Fail(const std::string& error)
+{
+    if (m_error.empty())
+        m_error = error;
+    return XmlEvent::Error;
+}
+
+void XmlPullParser::Compact()
+{
+    // Dropping consumed bytes moves the rest, so only do it once they are
+    // at least half a window.
+    if (!m_streaming || m_pos < m_windowSize / 2)
+        return;
+
+    m_window.erase(m_window.begin(), m_window.begin() + m_pos);
+    m_size -= m_pos;
+    m_pos = 0;
+    m_data = m_window.data();
+}
+
+bool XmlPullParser::Fill()
+{
+    if (!m_streaming || m_eof)
+        return false;
+
+    m_window.resize(m_size + m_windowSize);
+    m_file.read(m_window.data() + m_size, static_cast<std::streamsize>(m_windowSize));
+
+    const size_t got = static_cast<size_t>(m_file.gcount());
+    m_window.resize(m_size + got);
+    m_size += got;
+    m_data = m_window.data();
+
+    if (!m_file)
+        m_eof = true;
+
+    return got > 0;
+}
+
+bool XmlPullParser::Available(size_t count)
+{
+    while (m_size - m_pos < count)
+    {
+        if (!Fill())
+            return false;
+    }
+    return true;
+}
+
+size_t XmlPullParser::Find(std::string_view literal, size_t from)
+{
+    while (true)
+    {
+        size_t at = literal.size() == 1
+            ? from + XmlScan::FindChar(m_data + from, m_size - from, literal[0])
+            : std::string_view(m_data, m_size).find(literal, from);
+
+        if (at < m_size)
+            return at;
+
+        // A match may straddle the end of what is loaded.
+        if (m_size >= literal.size())
+            from = std::max(from, m_size - literal.size() + 1);
+
+        if (!Fill())
+            return std::string_view::npos;
+    }
+}
+
+bool XmlPullParser::SkipPast(std::string_view literal)
+{
+    size_t at = Find(literal, m_pos);
+    if (at == std::string_view::npos)
+        return false;
+
+    m_pos = at + literal.size();
+    return true;
+}
+
+void XmlPullParser::SkipWhitespace()
+{
+    do
+        m_pos += XmlScan::SkipSpace(m_data + m_pos, m_size - m_pos);
+    while (m_pos == m_size && Fill());
+}
+
+bool XmlPullParser::StartsWith(std::string_view literal)
+{
+    return Available(literal.size()) && std::memcmp(m_data + m_pos, literal.data(), literal.size()) == 0;
+}
+
+size_t XmlPullParser::ReadName()
+{
+    size_t start = m_pos;
+
+    do
+        m_pos += XmlScan::SkipName(m_data + m_pos, m_size - m_pos);
+    while (m_pos == m_size && Fill());
+
+    return start;
+}
+
+XmlEvent XmlPullParser::Next()
+{
+    m_nameIsEnd = false;
+
+    if (!m_error.empty())
+        return XmlEvent::Error;
+
+    if (m_cached)
+        return ReadCached();
+
+    Compact();
+
+    if (m_inTag)
+        return ReadAttribute();
+
+    return ReadContent();
+}
+
+XmlEvent XmlPullParser::ReadAttribute()
+{
+    SkipWhitespace();
+    if (!Available(1))
+        return Fail("unexpected end of document in a tag");
+
+    const char c = m_data[m_pos];
+
+    if (c == '/')
+    {
+        if (!StartsWith("/>"))
+            return Fail("expected />");
+
+        m_pos += 2;
+        m_inTag = false;
+        --m_depth;
+        m_nameIsEnd = true;
+        return XmlEvent::EndElement;
+    }
+
+    if (c == '>')
+    {
+        ++m_pos;
+        m_inTag = false;
+        return ReadContent();
+    }
+
+    m_nameBegin = ReadName();
+    m_nameEnd = m_pos;
+    if (m_nameEnd == m_nameBegin)
+        return Fail("bad attribute name");
+    m_atom = m_atoms.Intern(std::string_view(m_data + m_nameBegin, m_nameEnd - m_nameBegin));
+
+    SkipWhitespace();
+    if (!Available(1) || m_data[m_pos] != '=')
+        return Fail("expected = after attribute");
+    ++m_pos;
+
+    SkipWhitespace();
+    if (!Available(1) || (m_data[m_pos] != '"' && m_data[m_pos] != '\''))
+        return Fail("attribute value is not quoted");
+
+    const char quote = m_data[m_pos++];
+
+    size_t end = Find(std::string_view(&quote, 1), m_pos);
+    if (end == std::string_view::npos)
+        return Fail("unterminated attribute value");
+
+    m_valueBegin = m_pos;
+    m_valueEnd = end;
+    m_pos = end + 1;
+    return XmlEvent::Attribute;
+}
+
+XmlEvent XmlPullParser::ReadContent()
+{
+    while (true)
+    {
+        // Like XmlParseString, anything after the root element is ignored.
+        if (m_depth == 0 && m_sawRoot)
+            return XmlEvent::EndDocument;
+
+        if (!Available(1))
+            return Fail("unexpected end of document");
+
+        if (m_data[m_pos] != '<')
+        {
+            size_t end = Find("<", m_pos);
+            if (end == std::string_view::npos)
+                end = m_size;
+
+            size_t begin = m_pos;
+            m_pos = end;
+
+            while (begin < end && XmlScan::IsSpace(m_data[begin]))
+                ++begin;
+            while (end > begin && XmlScan::IsSpace(m_data[end - 1]))
+                --end;
+
+            if (begin == end)
+                continue;
+
+            if (m_depth == 0)
+                return Fail("text outside the root element");
+
+            m_valueBegin = begin;
+            m_valueEnd = end;
+            return XmlEvent::Text;
+        }
+
+        if (StartsWith("<?"))
+        {
+            if (!SkipPast("?>"))
+                return Fail("unterminated declaration");
+            continue;
+        }
+
+        if (StartsWith("<!--"))
+        {
+            if (!SkipPast("-->"))
+                return Fail("unterminated comment");
+            continue;
+        }
+
+        if (StartsWith("</"))
+        {
+            m_pos += 2;
+            m_nameBegin = ReadName();
+            m_nameEnd = m_pos;
+
+            SkipWhitespace();
+            if (!Available(1) || m_data[m_pos] != '>')
+                return Fail("expected > in closing tag");
+            ++m_pos;
+
+            std::string_view name(m_data + m_nameBegin, m_nameEnd - m_nameBegin);
+            if (m_depth == 0 || name != m_atoms.GetName(m_open[m_depth - 1]))
+                return Fail("mismatched closing tag </" + std::string(name) + ">");
+
+            --m_depth;
+            m_nameIsEnd = true;
+            return XmlEvent::EndElement;
+        }
+
+        ++m_pos;
+        m_nameBegin = ReadName();
+        m_nameEnd = m_pos;
+        if (m_nameEnd == m_nameBegin)
+            return Fail("bad element name");
+
+        m_atom = m_atoms.Intern(std::string_view(m_data + m_nameBegin, m_nameEnd - m_nameBegin));
+        m_open.resize(m_depth++);
+        m_open.push_back(m_atom);
+
+        m_sawRoot = true;
+        m_inTag = true;
+        return XmlEvent::StartElement;
+    }
+}
+
+XmlEvent XmlPullParser::ReadCached()
+{
+    if (m_pos == m_size)
+        return XmlEvent::EndDocument;
+
+    XmlCache::Record record;
+    if (!XmlCache::ReadRecord(std::string_view(m_data, m_size), m_pos, record))
+        return Fail("corrupt XML cache");
+
+    // Names and values are already in m_data, only their offsets are kept.
+    switch (record.event)
+    {
+    case XmlEvent::StartElement:
+        m_nameBegin = record.name.data() - m_data;
+        m_nameEnd = m_nameBegin + record.name.size();
+        m_atom = m_atoms.Intern(record.name);
+
+        m_open.resize(m_depth++);
+        m_open.push_back(m_atom);
+        m_sawRoot = true;
+        break;
+
+    case XmlEvent::Attribute:
+        m_nameBegin = record.name.data() - m_data;
+        m_nameEnd = m_nameBegin + record.name.size();
+        m_atom = m_atoms.Intern(record.name);
+        m_valueBegin = record.value.data() - m_data;
+        m_valueEnd = m_valueBegin + record.value.size();
+        break;
+
+    case XmlEvent::Text:
+        m_valueBegin = record.value.data() - m_data;
+        m_valueEnd = m_valueBegin + record.value.size();
+        break;
+
+    case XmlEvent::EndElement:
+        if (m_depth == 0)
+            return Fail("corrupt XML cache");
+        --m_depth;
+        m_nameIsEnd = true;
+        break;
+
+    default:
+        m_pos = m_size;
+        break;
+    }
+
+    return record.event;
+}
+
+bool XmlPullParser::Skip()
+{
+    const size_t target = m_depth - 1;
+
+    while (true)
+    {
+        XmlEvent event = Next();
+        if (event == XmlEvent::Error || event == XmlEvent::EndDocument)
+            return false;
+
+        if (event == XmlEvent::EndElement && m_depth == target)
+            return true;
+    }
+}
+
+std::string_view XmlPullParser::GetName() const
+{
+    if (m_nameIsEnd)
+        return m_atoms.GetName(m_open[m_depth]);
+    return std::string_view(m_data + m_nameBegin, m_nameEnd - m_nameBegin);
+}
+
+XmlAtom XmlPullParser::GetAtom() const
+{
+    return m_nameIsEnd ? m_open[m_depth] : m_atom;
+}
+
+const XmlAtomTable& XmlPullParser::GetAtoms() const
+{
+    return m_atoms;
+}
+
+std::string_view XmlPullParser::GetValue() const
+{
+    return std::string_view(m_data + m_valueBegin, m_valueEnd - m_valueBegin);
+}
+
+size_t XmlPullParser::GetDepth() const
+{
+    return m_depth;
+}
+
+const std::string& XmlPullParser::GetError() const
+{
+    return m_error;
+}
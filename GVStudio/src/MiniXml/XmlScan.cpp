@@ -0,0 +1,304 @@
+#include "MiniXml/XmlScan.h"
+
+#include <atomic>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define GV_XML_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GV_TARGET_AVX2
+#endif
+
+namespace
+{
+    size_t FindCharScalar(const char* data, size_t size, char c)
+    {
+        for (size_t i = 0; i < size; ++i)
+            if (data[i] == c)
+                return i;
+        return size;
+    }
+
+    size_t FindEitherScalar(const char* data, size_t size, char a, char b)
+    {
+        for (size_t i = 0; i < size; ++i)
+            if (data[i] == a || data[i] == b)
+                return i;
+        return size;
+    }
+
+    size_t SkipSpaceScalar(const char* data, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            if (!XmlScan::IsSpace(data[i]))
+                return i;
+        return size;
+    }
+
+#ifdef GV_XML_SIMD
+    uint32_t LowestBit(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+    }
+
+    // Whitespace lanes: ' ' or \t..\r, the latter as (x - 9) <= 4 unsigned.
+    __m128i SpaceMask16(__m128i x)
+    {
+        const __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8(9));
+        const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+        return _mm_or_si128(control, _mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+    }
+
+    size_t FindCharSse2(const char* data, size_t size, char c)
+    {
+        const __m128i needle = _mm_set1_epi8(c);
+        size_t i = 0;
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + FindCharScalar(data + i, size - i, c);
+    }
+
+    size_t FindEitherSse2(const char* data, size_t size, char a, char b)
+    {
+        const __m128i na = _mm_set1_epi8(a);
+        const __m128i nb = _mm_set1_epi8(b);
+        size_t i = 0;
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(block, na), _mm_cmpeq_epi8(block, nb));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + FindEitherScalar(data + i, size - i, a, b);
+    }
+
+    size_t SkipSpaceSse2(const char* data, size_t size)
+    {
+        size_t i = 0;
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(SpaceMask16(block))) & 0xFFFF;
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + SkipSpaceScalar(data + i, size - i);
+    }
+
+    GV_TARGET_AVX2
+    size_t FindCharAvx2(const char* data, size_t size, char c)
+    {
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + FindCharSse2(data + i, size - i, c);
+    }
+
+    GV_TARGET_AVX2
+    size_t FindEitherAvx2(const char* data, size_t size, char a, char b)
+    {
+        const __m256i na = _mm256_set1_epi8(a);
+        const __m256i nb = _mm256_set1_epi8(b);
+        size_t i = 0;
+
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(block, na), _mm256_cmpeq_epi8(block, nb));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + FindEitherSse2(data + i, size - i, a, b);
+    }
+
+    GV_TARGET_AVX2
+    size_t SkipSpaceAvx2(const char* data, size_t size)
+    {
+        const __m256i nine = _mm256_set1_epi8(9);
+        const __m256i four = _mm256_set1_epi8(4);
+        const __m256i space = _mm256_set1_epi8(' ');
+        size_t i = 0;
+
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i shifted = _mm256_sub_epi8(block, nine);
+            __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, four), shifted);
+            __m256i hit = _mm256_or_si256(control, _mm256_cmpeq_epi8(block, space));
+
+            uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+            if (mask)
+                return i + LowestBit(mask);
+        }
+
+        return i + SkipSpaceSse2(data + i, size - i);
+    }
+
+    bool CpuHasAvx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+
+        // The OS has to save YMM state too.
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    XmlScan::Level DetectLevel()
+    {
+#ifdef GV_XML_SIMD
+        return CpuHasAvx2() ? XmlScan::Level::Avx2 : XmlScan::Level::Sse2;
+#else
+        return XmlScan::Level::Scalar;
+#endif
+    }
+
+    std::atomic<XmlScan::Level>& CurrentLevel()
+    {
+        static std::atomic<XmlScan::Level> level(DetectLevel());
+        return level;
+    }
+}
+
+namespace XmlScan
+{
+    // 1 = CLASS_SPACE, 2 = CLASS_NAME
+    const uint8_t kCharClass[256] =
+    {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+        0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 2,
+        0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    Level GetBestLevel()
+    {
+        static const Level best = DetectLevel();
+        return best;
+    }
+
+    Level GetLevel()
+    {
+        return CurrentLevel().load(std::memory_order_relaxed);
+    }
+
+    void SetLevel(Level level)
+    {
+        if (static_cast<int>(level) > static_cast<int>(GetBestLevel()))
+            level = GetBestLevel();
+        CurrentLevel().store(level, std::memory_order_relaxed);
+    }
+
+    const char* GetLevelName(Level level)
+    {
+        switch (level)
+        {
+        case Level::Sse2: return "SSE2";
+        case Level::Avx2: return "AVX2";
+        default: return "Scalar";
+        }
+    }
+
+    size_t FindChar(const char* data, size_t size, char c)
+    {
+#ifdef GV_XML_SIMD
+        switch (GetLevel())
+        {
+        case Level::Avx2: return FindCharAvx2(data, size, c);
+        case Level::Sse2: return FindCharSse2(data, size, c);
+        default: break;
+        }
+#endif
+        return FindCharScalar(data, size, c);
+    }
+
+    size_t FindEither(const char* data, size_t size, char a, char b)
+    {
+#ifdef GV_XML_SIMD
+        switch (GetLevel())
+        {
+        case Level::Avx2: return FindEitherAvx2(data, size, a, b);
+        case Level::Sse2: return FindEitherSse2(data, size, a, b);
+        default: break;
+        }
+#endif
+        return FindEitherScalar(data, size, a, b);
+    }
+
+    size_t SkipSpace(const char* data, size_t size)
+    {
+        // Most runs are zero or one byte; only go wide past those.
+        if (size == 0 || !IsSpace(data[0]))
+            return 0;
+        if (size == 1 || !IsSpace(data[1]))
+            return 1;
+
+#ifdef GV_XML_SIMD
+        switch (GetLevel())
+        {
+        case Level::Avx2: return 2 + SkipSpaceAvx2(data + 2, size - 2);
+        case Level::Sse2: return 2 + SkipSpaceSse2(data + 2, size - 2);
+        default: break;
+        }
+#endif
+        return 2 + SkipSpaceScalar(data + 2, size - 2);
+    }
+}
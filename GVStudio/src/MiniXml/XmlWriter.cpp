@@ -0,0 +1,379 @@
+#include "MiniXml/XmlWriter.h"
+#include "MiniXml/MiniXml.h"
+#include "MiniXml/XmlNumber.h"
+#include "Platform/HeapCounter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+XmlWriter::XmlWriter(size_t bufferSize, int indentSpaces)
+    : m_buffer(std::max<size_t>(bufferSize, 256))
+    , m_indentSpaces(std::max(indentSpaces, 0))
+    , m_indent(static_cast<size_t>(m_indentSpaces) * 16, ' ')
+{
+}
+
+XmlWriter::~XmlWriter()
+{
+    if (m_file.is_open() || m_string)
+        Close();
+}
+
+bool XmlWriter::Open(const std::string& path)
+{
+    Restart();
+
+    // Binary, so the file holds exactly the bytes counted in m_written.
+    m_file.clear();
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    return m_file.is_open();
+}
+
+void XmlWriter::OpenString(std::string& out)
+{
+    Restart();
+    m_string = &out;
+}
+
+void XmlWriter::Restart()
+{
+    if (m_file.is_open() || m_string)
+        Close();
+
+    m_used = 0;
+    m_written = 0;
+    m_failed = false;
+    m_depth = 0;
+    m_tagOpen = false;
+    m_hasPendingText = false;
+}
+
+bool XmlWriter::Close()
+{
+    Flush();
+    m_file.close();
+    m_string = nullptr;
+
+    bool ok = !m_failed && m_depth == 0;
+    m_depth = 0;
+    return ok;
+}
+
+void XmlWriter::Flush()
+{
+    if (m_used == 0)
+        return;
+
+    Write(m_buffer.data(), m_used);
+    m_used = 0;
+}
+
+void XmlWriter::Write(const char* data, size_t size)
+{
+    if (m_string)
+        m_string->append(data, size);
+    else if (!m_file.write(data, static_cast<std::streamsize>(size)))
+        m_failed = true;
+}
+
+void XmlWriter::Put(std::string_view text)
+{
+    m_written += text.size();
+
+    if (m_used + text.size() > m_buffer.size())
+    {
+        Flush();
+
+        if (text.size() > m_buffer.size())
+        {
+            Write(text.data(), text.size());
+            return;
+        }
+    }
+
+    std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+    m_used += text.size();
+}
+
+void XmlWriter::Put(char c)
+{
+    if (m_used == m_buffer.size())
+        Flush();
+
+    m_buffer[m_used++] = c;
+    ++m_written;
+}
+
+void XmlWriter::PutIndent(size_t depth)
+{
+    const size_t count = depth * m_indentSpaces;
+    while (m_indent.size() < count)
+        m_indent.append(m_indent.size() + m_indentSpaces, ' ');
+
+    Put(std::string_view(m_indent.data(), count));
+}
+
+void XmlWriter::OpenContent()
+{
+    if (!m_tagOpen)
+        return;
+
+    Put(">\n");
+    m_tagOpen = false;
+
+    // Text goes on its own line above the first child, as XmlToString does.
+    if (m_hasPendingText)
+    {
+        PutIndent(m_depth);
+        Put(m_pendingText);
+        Put('\n');
+        m_hasPendingText = false;
+    }
+}
+
+void XmlWriter::StartElement(std::string_view name)
+{
+    OpenContent();
+
+    PutIndent(m_depth);
+    Put('<');
+    Put(name);
+
+    if (m_open.size() <= m_depth)
+        m_open.emplace_back();
+    m_open[m_depth++].assign(name.data(), name.size());
+
+    m_tagOpen = true;
+}
+
+void XmlWriter::Attribute(std::string_view name, std::string_view value)
+{
+    if (!m_tagOpen)
+    {
+        m_failed = true;
+        return;
+    }
+
+    Put(' ');
+    Put(name);
+    Put("=\"");
+    Put(value);
+    Put('"');
+}
+
+void XmlWriter::Attribute(std::string_view name, int value)
+{
+    char text[XmlNumber::MAX_CHARS];
+    Attribute(name, XmlNumber::Format(value, text));
+}
+
+void XmlWriter::Attribute(std::string_view name, float value)
+{
+    char text[XmlNumber::MAX_CHARS];
+    Attribute(name, XmlNumber::Format(value, text));
+}
+
+void XmlWriter::Text(std::string_view text)
+{
+    if (text.empty() || m_depth == 0)
+        return;
+
+    if (m_tagOpen)
+    {
+        // Inline or on its own line depends on whether children follow.
+        if (m_hasPendingText)
+            m_pendingText.append(text.data(), text.size());
+        else
+            m_pendingText.assign(text.data(), text.size());
+        m_hasPendingText = true;
+        return;
+    }
+
+    PutIndent(m_depth);
+    Put(text);
+    Put('\n');
+}
+
+void XmlWriter::EndElement()
+{
+    if (m_depth == 0)
+    {
+        m_failed = true;
+        return;
+    }
+
+    const std::string& name = m_open[--m_depth];
+
+    if (m_tagOpen)
+    {
+        m_tagOpen = false;
+
+        if (!m_hasPendingText)
+        {
+            Put("/>\n");
+            return;
+        }
+
+        Put('>');
+        Put(m_pendingText);
+        m_hasPendingText = false;
+    }
+    else
+    {
+        PutIndent(m_depth);
+    }
+
+    Put("</");
+    Put(name);
+    Put(">\n");
+}
+
+void XmlWriter::WriteNode(const XmlNode& node)
+{
+    StartElement(node.name);
+
+    for (const XmlAttribute& a : node.attributes)
+        Attribute(a.name, a.value);
+
+    Text(node.text);
+
+    for (const XmlNode& child : node.children)
+        WriteNode(child);
+
+    EndElement();
+}
+
+uint64_t XmlWriter::GetBytesWritten() const
+{
+    return m_written;
+}
+
+void XmlWriter::RunBenchmark(uint32_t objectCount)
+{
+    using Clock = std::chrono::steady_clock;
+    const uint32_t perFolder = 50;
+
+    auto ms = [](Clock::time_point t0)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        };
+
+    const fs::path path = fs::temp_directory_path() / "GVXmlWriterBench.gScene";
+    char name[32];
+    char asset[64];
+
+    // Tree, XmlToString, then one write: how saving worked before the writer.
+    Clock::time_point t0 = Clock::now();
+    size_t domBytes = 0;
+    uint64_t domAllocs = 0;
+    uint64_t domHeapBytes = 0;
+    {
+        HeapCounter heap;
+
+        XmlNode scene;
+        scene.name = "Scene";
+
+        XmlNode root;
+        root.name = "Folder";
+        root.attributes.push_back({ "name", "Root" });
+
+        for (uint32_t first = 0; first < objectCount; first += perFolder)
+        {
+            XmlNode group;
+            group.name = "Folder";
+            std::snprintf(name, sizeof(name), "Group%u", first / perFolder);
+            group.attributes.push_back({ "name", name });
+
+            for (uint32_t o = first; o < std::min(objectCount, first + perFolder); ++o)
+            {
+                XmlNode obj;
+                obj.name = "Object";
+                std::snprintf(name, sizeof(name), "Object_%u", o);
+                std::snprintf(asset, sizeof(asset), "Objects/Props/Crate_%u.gObject", o);
+                obj.attributes.push_back({ "name", name });
+                obj.attributes.push_back({ "asset", asset });
+                group.children.push_back(std::move(obj));
+            }
+
+            root.children.push_back(std::move(group));
+        }
+
+        scene.children.push_back(std::move(root));
+
+        std::string text = XmlToString(scene, 2);
+        domBytes = text.size();
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+
+        domAllocs = heap.GetAllocations();
+        domHeapBytes = heap.GetBytes();
+    }
+    const double domMs = ms(t0);
+
+    t0 = Clock::now();
+    uint64_t writerBytes = 0;
+    uint64_t writerAllocs = 0;
+    uint64_t writerHeapBytes = 0;
+    {
+        HeapCounter heap;
+
+        XmlWriter writer;
+        writer.Open(path.string());
+
+        writer.StartElement("Scene");
+        writer.StartElement("Folder");
+        writer.Attribute("name", "Root");
+
+        for (uint32_t first = 0; first < objectCount; first += perFolder)
+        {
+            writer.StartElement("Folder");
+            std::snprintf(name, sizeof(name), "Group%u", first / perFolder);
+            writer.Attribute("name", name);
+
+            for (uint32_t o = first; o < std::min(objectCount, first + perFolder); ++o)
+            {
+                std::snprintf(name, sizeof(name), "Object_%u", o);
+                std::snprintf(asset, sizeof(asset), "Objects/Props/Crate_%u.gObject", o);
+
+                writer.StartElement("Object");
+                writer.Attribute("name", name);
+                writer.Attribute("asset", asset);
+                writer.EndElement();
+            }
+
+            writer.EndElement();
+        }
+
+        writer.EndElement();
+        writer.EndElement();
+        writer.Close();
+        writerBytes = writer.GetBytesWritten();
+
+        writerAllocs = heap.GetAllocations();
+        writerHeapBytes = heap.GetBytes();
+    }
+    const double writerMs = ms(t0);
+
+    std::error_code ec;
+    fs::remove(path, ec);
+
+    auto allocations = [](uint64_t count, uint64_t bytes)
+        {
+            if (!HeapCounter::IsEnabled())
+                return std::string("allocations not counted");
+            return std::to_string(count) + " allocations (" + std::to_string(bytes / 1024) + " KB)";
+        };
+
+    std::cout << "[Xml] Save benchmark: " << objectCount << " objects, " << writerBytes / 1024 << " KB\n";
+    std::cout << "[Xml]   XmlNode + XmlToString: " << domMs << " ms, " << allocations(domAllocs, domHeapBytes)
+        << ", whole document held (" << domBytes / 1024 << " KB text plus the tree)\n";
+    std::cout << "[Xml]   XmlWriter:             " << writerMs << " ms, " << allocations(writerAllocs, writerHeapBytes)
+        << ", 64 KB buffer\n";
+}
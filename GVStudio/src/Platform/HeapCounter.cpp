@@ -0,0 +1,212 @@
+#include "Platform/HeapCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Constant-initialised, so reading it from operator new never runs
+    // thread_local construction.
+    thread_local HeapCounter* t_counter = nullptr;
+}
+
+void HeapCounter::OnAllocation(size_t size)
+{
+    for (HeapCounter* counter = t_counter; counter; counter = counter->m_outer)
+    {
+        ++counter->m_allocations;
+        counter->m_bytes += size;
+    }
+}
+
+HeapCounter::HeapCounter()
+    : m_outer(t_counter)
+{
+    t_counter = this;
+}
+
+HeapCounter::~HeapCounter()
+{
+    t_counter = m_outer;
+}
+
+uint64_t HeapCounter::GetAllocations() const
+{
+    return m_allocations;
+}
+
+uint64_t HeapCounter::GetBytes() const
+{
+    return m_bytes;
+}
+
+bool HeapCounter::IsEnabled()
+{
+#ifdef GV_HEAP_COUNTER
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef GV_HEAP_COUNTER
+
+namespace
+{
+    void* Allocate(size_t size, size_t alignment)
+    {
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return std::malloc(size ? size : 1);
+
+#ifdef _MSC_VER
+        return _aligned_malloc(size ? size : 1, alignment);
+#else
+        // aligned_alloc wants a whole number of alignments.
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void Free(void* p, size_t alignment)
+    {
+#ifdef _MSC_VER
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            _aligned_free(p);
+            return;
+        }
+#endif
+        (void)alignment;
+        std::free(p);
+    }
+
+    // What the default operator new does: retry through the new handler
+    // until it gives up.
+    void* AllocateOrThrow(size_t size, size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        HeapCounter::OnAllocation(size);
+        for (;;)
+        {
+            if (void* p = Allocate(size, alignment))
+                return p;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* AllocateOrNull(size_t size, size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept
+    {
+        try
+        {
+            return AllocateOrThrow(size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void* operator new(size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void* operator new[](size_t size)
+{
+    return AllocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return AllocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return AllocateOrNull(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    Free(p, static_cast<size_t>(alignment));
+}
+
+#endif
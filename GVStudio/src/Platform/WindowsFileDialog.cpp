@@ -84,7 +84,7 @@ namespace WindowsFileDialog
     }
 }
 
-std::string WindowsFileDialog::SelectFolder()
+std::string WindowsFileDialog::SelectFolder(const wchar_t* title)
 {
     HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
     if (FAILED(hr))
@@ -107,6 +107,9 @@ std::string WindowsFileDialog::SelectFolder()
     dialog->GetOptions(&options);
     dialog->SetOptions(options | FOS_PICKFOLDERS | FOS_FORCEFILESYSTEM);
 
+    if (title)
+        dialog->SetTitle(title);
+
     hr = dialog->Show(nullptr);
 
     std::string result;
@@ -1,4 +1,5 @@
 #include "Renderer/Renderer.h"
+#include "GVFramework/Material/MaterialParser.h"
 #include "3rdParty/glad/glad.h"
 
 #include <vector>
@@ -200,32 +201,10 @@ ParseMTLTextures(const std::string& path)
 {
     std::unordered_map<std::string, unsigned int> materials;
 
-    std::ifstream file(path);
-    std::string line;
-
-    std::string currentMaterial;
-
-    while (std::getline(file, line))
+    for (const GV_Material& material : MaterialParser::ParseFile(path))
     {
-        std::stringstream ss(line);
-        std::string type;
-        ss >> type;
-
-        if (type == "newmtl")
-        {
-            ss >> currentMaterial;
-        }
-        else if (type == "map_Kd")
-        {
-            std::string tex;
-            ss >> tex;
-
-            fs::path texPath = fs::path(path).parent_path() / tex;
-
-            unsigned int texID = LoadBMPTexture(texPath.string());
-
-            materials[currentMaterial] = texID;
-        }
+        if (!material.texturePath.empty())
+            materials[material.name] = LoadBMPTexture(material.texturePath);
     }
 
     return materials;
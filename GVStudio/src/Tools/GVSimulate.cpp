@@ -0,0 +1,52 @@
+#include "Exporters/ExportTarget.h"
+#include "Exporters/RuntimeSimulator.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Console build of GVStudio --simulate, for machines without the editor.
+// GVSimulate <data folder> [report.json] [--target PSP|PC64] [--cap <MB>]
+//            [--iterations <n>]
+// --target only changes the buffer alignment checked; the heap is still
+// the PSP's unless --cap says otherwise.
+int main(int argc, char** argv)
+{
+    std::string dataDir;
+    std::string reportPath;
+    SimulatorSettings settings;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--target" && i + 1 < argc)
+        {
+            const std::string name = argv[++i];
+            if (name == GetTargetInfo(ExportTarget::Psp).name)
+                settings.geAlign = GetTargetInfo(ExportTarget::Psp).vertexAlign;
+            else if (name == GetTargetInfo(ExportTarget::Pc64).name)
+                settings.geAlign = GetTargetInfo(ExportTarget::Pc64).vertexAlign;
+            else
+                usage = true;
+        }
+        else if (arg == "--cap" && i + 1 < argc)
+            settings.memoryCap = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)) * 1024 * 1024;
+        else if (arg == "--iterations" && i + 1 < argc)
+            settings.iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (dataDir.empty())
+            dataDir = arg;
+        else if (reportPath.empty())
+            reportPath = arg;
+        else
+            usage = true;
+    }
+
+    if (usage || dataDir.empty() || settings.memoryCap == 0 || settings.iterations == 0)
+    {
+        std::cerr << "Usage: GVSimulate <data folder> [report.json] [--target PSP|PC64] [--cap <MB>] [--iterations <n>]\n";
+        return 2;
+    }
+
+    return RuntimeSimulator::Run(dataDir, reportPath, settings) ? 0 : 1;
+}
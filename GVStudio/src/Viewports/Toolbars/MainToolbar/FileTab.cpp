@@ -1,13 +1,27 @@
 #include "Viewports/Toolbars/MainToolbar/FileTab.h"
 
 #include "MiniXml/ProjectXml.h"
+#include "Exporters/BuildGraph.h"
+#include "Exporters/ProjectExporter.h"
 #include "Platform/WindowsFileDialog.h"
 #include "GVFramework/Scene/SceneManager.h"
+#include "GVStudio/GVStudio.h"
+#include "3rdParty/glad/glad.h"
 
 #include "imgui/imgui.h"
 
+#include <algorithm>
 #include <iostream>
 
+FileTab::~FileTab()
+{
+    if (m_exportThread.joinable())
+    {
+        m_exportControl->Cancel();
+        m_exportThread.join();
+    }
+}
+
 void FileTab::Draw(
     GV_State& state,
     SceneManager& sceneManager)
@@ -59,8 +73,12 @@ void FileTab::Draw(
 
     ImGui::Separator();
 
- 
-    if (ImGui::MenuItem("Save Scene"))
+    // A running export reads the scene and object files; saving would
+    // rewrite them under it. Builds and exports write the same data
+    // folder, so they run one at a time too.
+    const bool idle = !IsExporting();
+
+    if (ImGui::MenuItem("Save Scene", nullptr, false, idle))
     {
         if (!state.currentScene.scenePath.empty())
         {
@@ -76,7 +94,7 @@ void FileTab::Draw(
     }
 
   
-    if (ImGui::MenuItem("Save All Scenes"))
+    if (ImGui::MenuItem("Save All Scenes", nullptr, false, idle))
     {
         std::cout << "[FileTab] Save All Scenes\n";
 
@@ -91,7 +109,7 @@ void FileTab::Draw(
     }
 
   
-    if (ImGui::MenuItem("Save Project"))
+    if (ImGui::MenuItem("Save Project", nullptr, false, idle))
     {
         std::cout << "[FileTab] Saving Project\n";
 
@@ -109,5 +127,165 @@ void FileTab::Draw(
             state.project.projectPath);
     }
 
+    ImGui::Separator();
+
+    bool build = ImGui::MenuItem("Build Project", nullptr, false, idle);
+    bool rebuild = ImGui::MenuItem("Rebuild Project", nullptr, false, idle);
+
+    if (build || rebuild)
+    {
+        if (!state.currentScene.scenePath.empty())
+        {
+            std::string sceneDir =
+                state.project.projectRoot + "/" +
+                state.currentScene.scenePath;
+
+            sceneManager.SaveScene(sceneDir);
+        }
+
+        StartExport(state, sceneManager, ExportSettings(), rebuild ? ExportJob::Rebuild : ExportJob::Build);
+    }
+
+    bool exportPsp = ImGui::MenuItem("Export Project", nullptr, false, idle);
+    bool exportAll = ImGui::MenuItem("Export Project (PSP + PC64)", nullptr, false, idle);
+
+    if (exportPsp || exportAll)
+    {
+        std::cout << "[FileTab] Exporting Project\n";
+
+        if (!state.currentScene.scenePath.empty())
+        {
+            std::string sceneDir =
+                state.project.projectRoot + "/" +
+                state.currentScene.scenePath;
+
+            sceneManager.SaveScene(sceneDir);
+        }
+
+        ExportSettings settings;
+        if (exportAll)
+            settings.targets = { ExportTarget::Psp, ExportTarget::Pc64 };
+
+        StartExport(state, sceneManager, settings);
+    }
+
     ImGui::EndMenu();
+}
+
+bool FileTab::IsExporting() const
+{
+    return m_exportThread.joinable();
+}
+
+void FileTab::StartExport(const GV_State& state, SceneManager& sceneManager, ExportSettings settings,
+    ExportJob job)
+{
+    m_exportControl = std::make_unique<ExportControl>();
+    m_exportDone = false;
+    m_exportJob = job;
+    m_exportOk = false;
+    m_preview = LightmapPreview{};
+    m_previewVersion = 0;
+    m_previewPage = 0;
+
+    settings.control = m_exportControl.get();
+
+    // The export works on its own copy of the project and registry, so the
+    // editor stays usable while it runs.
+    m_exportThread = std::thread(
+        [this, project = state.project, registry = sceneManager.GetRegistry(), settings, job]() mutable
+        {
+            if (job == ExportJob::Export)
+            {
+                ProjectExporter exporter(registry, settings);
+                m_exportOk = exporter.ExportProject(project);
+            }
+            else
+            {
+                BuildGraph graph(registry, settings);
+                m_exportOk = graph.Build(project, job == ExportJob::Rebuild);
+            }
+            m_exportDone = true;
+        });
+}
+
+void FileTab::FinishExport()
+{
+    m_exportThread.join();
+
+    std::cout << "[FileTab] " << (m_exportJob == ExportJob::Export ? "Export " : "Build ")
+        << (m_exportOk ? "finished" : m_exportControl->IsCancelled() ? "cancelled" : "failed") << "\n";
+
+    if (m_previewTexture != 0)
+    {
+        GLuint texture = m_previewTexture;
+        glDeleteTextures(1, &texture);
+        m_previewTexture = 0;
+    }
+
+    m_exportControl.reset();
+    m_preview = LightmapPreview{};
+}
+
+void FileTab::UploadPreview()
+{
+    if (m_preview.pages.empty())
+        return;
+
+    m_previewPage = std::min(m_previewPage, static_cast<int>(m_preview.pages.size()) - 1);
+
+    if (m_previewTexture == 0)
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        m_previewTexture = texture;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, m_previewTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+        m_preview.pageSize, m_preview.pageSize, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, m_preview.pages[m_previewPage].data());
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void FileTab::DrawExportStatus()
+{
+    if (!IsExporting())
+        return;
+
+    if (m_exportDone)
+    {
+        FinishExport();
+        return;
+    }
+
+    // Each finished lightmap pass replaces the preview.
+    if (m_exportControl->GetPreview(m_previewVersion, m_preview))
+        UploadPreview();
+
+    ImGui::SetNextWindowSize(ImVec2(300.0f, 380.0f), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Export");
+
+    ImGui::TextUnformatted(m_exportControl->IsCancelled() ? "Cancelling..."
+        : m_exportJob == ExportJob::Export ? "Exporting..." : "Building...");
+
+    if (!m_preview.pages.empty())
+    {
+        ImGui::Text("Lightmap %s: pass %u/%u", m_preview.sceneName.c_str(),
+            m_preview.pass, m_preview.passCount);
+
+        const int pageCount = static_cast<int>(m_preview.pages.size());
+        if (pageCount > 1 && ImGui::SliderInt("Page", &m_previewPage, 0, pageCount - 1))
+            UploadPreview();
+
+        ImGui::Image((ImTextureID)(uintptr_t)m_previewTexture, ImVec2(256.0f, 256.0f));
+    }
+
+    if (ImGui::Button("Cancel"))
+        m_exportControl->Cancel();
+
+    ImGui::End();
 }
\ No newline at end of file
@@ -7,10 +7,13 @@
 
 void Toolbar::Draw(GV_State& state, SceneManager& sceneManager)
 {
-    if (!ImGui::BeginMainMenuBar())
-        return;
+    if (ImGui::BeginMainMenuBar())
+    {
+        m_fileTab.Draw(state, sceneManager);
+        m_toolsTab.Draw();
 
-    m_fileTab.Draw(state, sceneManager);
+        ImGui::EndMainMenuBar();
+    }
 
-    ImGui::EndMainMenuBar();
+    m_fileTab.DrawExportStatus();
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "Viewports/Toolbars/MainToolbar/ToolsTab.h"
+
+#include "Exporters/ChunkPatch.h"
+#include "Exporters/EventCompiler.h"
+#include "Exporters/PerfectHash.h"
+#include "Exporters/RuntimeSimulator.h"
+#include "GVFramework/Chunk/ChunkChecksum.h"
+#include "GVFramework/Scene/SceneManager.h"
+#include "MiniXml/XmlCache.h"
+#include "MiniXml/XmlDocument.h"
+#include "MiniXml/XmlNumber.h"
+#include "MiniXml/XmlWriter.h"
+#include "Platform/WindowsFileDialog.h"
+
+#include "imgui/imgui.h"
+
+void ToolsTab::Draw()
+{
+    if (!ImGui::BeginMenu("Tools"))
+        return;
+
+    if (ImGui::MenuItem("Build Patches..."))
+    {
+        std::string oldDir = WindowsFileDialog::SelectFolder(L"Previous export folder");
+        std::string newDir = oldDir.empty() ? std::string() : WindowsFileDialog::SelectFolder(L"New export folder");
+
+        if (!newDir.empty())
+            ChunkPatch::PatchFolder(oldDir, newDir);
+    }
+
+    if (ImGui::MenuItem("Simulate Runtime Load..."))
+    {
+        std::string dataDir = WindowsFileDialog::SelectFolder(L"Export folder");
+        if (!dataDir.empty())
+            RuntimeSimulator::Run(dataDir);
+    }
+
+    if (ImGui::BeginMenu("Benchmarks"))
+    {
+        if (ImGui::MenuItem("Name Lookup (Perfect Hash)"))
+        {
+            PerfectHash::RunBenchmark(1000, 1000000);
+            PerfectHash::RunBenchmark(100000, 1000000);
+        }
+
+        if (ImGui::MenuItem("Event Dispatch (100k Objects)"))
+            EventCompiler::RunBenchmark(100000);
+
+        if (ImGui::MenuItem("Chunk Checksums"))
+            ChunkChecksum::RunBenchmark(256);
+
+        if (ImGui::MenuItem("XML Parse (DOM vs Arena)"))
+            XmlDocument::RunBenchmark(100000);
+
+        if (ImGui::MenuItem("XML Throughput (100 MB)"))
+            XmlDocument::RunThroughputBenchmark(100);
+
+        if (ImGui::MenuItem("XML Parallel Parse (500 MB)"))
+            XmlDocument::RunParallelBenchmark(500);
+
+        if (ImGui::MenuItem("XML Save (DOM vs Writer)"))
+            XmlWriter::RunBenchmark(100000);
+
+        if (ImGui::MenuItem("XML Cache (Tokenize vs Replay)"))
+            XmlCache::RunBenchmark(100000);
+
+        if (ImGui::MenuItem("Float Text (1M Round Trips)"))
+            XmlNumber::RunBenchmark(1000000);
+
+        if (ImGui::MenuItem("Scene Storage (Files vs Pack)"))
+            SceneManager::RunStorageBenchmark(20000);
+
+        ImGui::EndMenu();
+    }
+
+    ImGui::EndMenu();
+}
@@ -1,8 +1,14 @@
 #include "GVStudio/GVStudio.h"
+#include "Exporters/RuntimeSimulator.h"
 #include "SDL3/SDL_init.h"
 #include <iostream>
+#include <string>
 int main(int argc, char** argv)
 {
+	// GVStudio --simulate <data folder> [report.json]: headless runtime load check
+	if (argc > 2 && std::string(argv[1]) == "--simulate")
+		return RuntimeSimulator::Run(argv[2], argc > 3 ? argv[3] : "") ? 0 : 1;
+
 	GV_STUDIO gv_studio;
 
 